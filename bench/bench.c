@@ -0,0 +1,226 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: benchmark firmware for QEMU's mps2-an386 (Cortex-M4), built once per parameter set
+*           with -DBENCH_PRIME=434|503|610|751. Results are printed on UART0 as
+*             bench <algorithm>
+*             cal <instructions> <ticks>       calibration loop with a known instruction count
+*             op <name> <iterations> <ticks>   one line per primitive / KEM operation
+*             count <name> <phase> <counts>    with -D _OP_COUNT_, field operations of a single KEM operation per phase
+*             trace ... end trace               with -D _TRACE_, Chrome trace-event JSON of a single decapsulation
+*             done <status>                     ok if the KEM operations and the batch check agree
+*           and are converted to instruction counts by run_qemu.py.
+*********************************************************************************************/
+
+#include "hal.h"
+
+// The library is a single translation unit per prime, including it gives access to the internal functions
+#if (BENCH_PRIME == 434)
+    #include "P434.c"
+#elif (BENCH_PRIME == 503)
+    #include "P503.c"
+#elif (BENCH_PRIME == 610)
+    #include "P610.c"
+#elif (BENCH_PRIME == 751)
+    #include "P751.c"
+#else
+    #error -- "Unsupported BENCH_PRIME"
+#endif
+
+#define BENCH_CAL_LOOPS       1000000
+#define BENCH_FIELD_ITERS     1000
+#define BENCH_CURVE_ITERS     100
+#define BENCH_LADDER_ITERS    2
+#define BENCH_KEM_ITERS       1
+
+// Runs stmt iters times and reports the elapsed SysTick ticks (loop overhead included)
+#define BENCH(name, iters, stmt)                                                                  \
+    { uint64_t t0, t1; unsigned int it;                                                           \
+    t0 = hal_get_ticks();                                                                         \
+    for (it = 0; it < (iters); it++) { stmt; }                                                    \
+    t1 = hal_get_ticks();                                                                         \
+    report((name), (iters), t1 - t0); }
+
+
+static void report(const char* name, unsigned int iters, uint64_t ticks)
+{
+    hal_puts("op ");
+    hal_puts(name);
+    hal_putc(' ');
+    hal_putu64(iters);
+    hal_putc(' ');
+    hal_putu64(ticks);
+    hal_putc('\n');
+}
+
+
+#if defined(OP_COUNT)
+
+static const char* op_phase_names[OP_COUNT_PHASES] = {"other", "ladder", "tree", "normalize"};
+
+
+static void report_op_counts(const char* name)
+{ // One line per phase with the counts since the last reset, in the order of the OP_* indices
+    uint32_t counts[OP_COUNT_PHASES][OP_COUNT_OPS];
+    unsigned int i, j;
+
+    op_count_snapshot(counts);
+    for (i = 0; i < OP_COUNT_PHASES; i++) {
+        hal_puts("count ");
+        hal_puts(name);
+        hal_putc(' ');
+        hal_puts(op_phase_names[i]);
+        for (j = 0; j < OP_COUNT_OPS; j++) {
+            hal_putc(' ');
+            hal_putu64(counts[i][j]);
+        }
+        hal_putc('\n');
+    }
+    op_count_reset();
+}
+
+#define BENCH_KEM(name, stmt)   { op_count_reset(); BENCH(name, 1, stmt); report_op_counts(name); }
+#else
+#define BENCH_KEM(name, stmt)   BENCH(name, BENCH_KEM_ITERS, stmt)
+#endif
+
+
+static void __attribute__ ((noinline, naked)) calibration_loop(uint32_t n)
+{ // Executes exactly 2n+1 instructions, plus the BL of the caller
+    asm volatile(
+        "1: \n\t"
+        "SUBS R0, R0, #1 \n\t"
+        "BNE 1b \n\t"
+        "BX LR \n\t"
+    :
+    :
+    : "cc"
+    );
+}
+
+
+static void random_felm(felm_t a)
+{ // Random field element in [0, 2^(NBITS_FIELD-1)) < p
+    randombytes((unsigned char*)a, NWORDS_FIELD*sizeof(digit_t));
+    a[NWORDS_FIELD-1] &= ((digit_t)-1) >> (NWORDS_FIELD*RADIX - NBITS_FIELD + 1);
+}
+
+
+// Operations of the batch check, the middle one with a zero public key or ciphertext
+#define BATCH_CHECK_OPS       3
+
+static unsigned char batch_pk[BATCH_CHECK_OPS*CRYPTO_PUBLICKEYBYTES], batch_sk[BATCH_CHECK_OPS*CRYPTO_SECRETKEYBYTES];
+static unsigned char batch_ct[BATCH_CHECK_OPS*CRYPTO_CIPHERTEXTBYTES];
+static unsigned char batch_ss[BATCH_CHECK_OPS*CRYPTO_BYTES], batch_ss_[BATCH_CHECK_OPS*CRYPTO_BYTES];
+
+
+static int batch_check(const unsigned char* pk, const unsigned char* sk)
+{ // A zero public key in crypto_kem_enc_batch, or a zero ciphertext in crypto_kem_dec_batch, must not change the
+  // shared secrets of the other operations of the batch. Returns 0 if they match those of crypto_kem_dec
+    unsigned char ss[CRYPTO_BYTES];
+    unsigned int i, k;
+    int status = 0;
+
+    for (k = 0; k < BATCH_CHECK_OPS; k++) {
+        memcpy(&batch_pk[k*CRYPTO_PUBLICKEYBYTES], pk, CRYPTO_PUBLICKEYBYTES);
+        memcpy(&batch_sk[k*CRYPTO_SECRETKEYBYTES], sk, CRYPTO_SECRETKEYBYTES);
+    }
+    memset(&batch_pk[CRYPTO_PUBLICKEYBYTES], 0, CRYPTO_PUBLICKEYBYTES);
+    crypto_kem_enc_batch(batch_ct, batch_ss, batch_pk, BATCH_CHECK_OPS);
+    memset(&batch_ct[CRYPTO_CIPHERTEXTBYTES], 0, CRYPTO_CIPHERTEXTBYTES);
+    crypto_kem_dec_batch(batch_ss_, batch_ct, batch_sk, BATCH_CHECK_OPS);
+
+    for (k = 0; k < BATCH_CHECK_OPS; k += 2) {
+        crypto_kem_dec(ss, &batch_ct[k*CRYPTO_CIPHERTEXTBYTES], sk);
+        for (i = 0; i < CRYPTO_BYTES; i++) {
+            status |= (ss[i] ^ batch_ss[k*CRYPTO_BYTES + i]) | (ss[i] ^ batch_ss_[k*CRYPTO_BYTES + i]);
+        }
+    }
+    return status;
+}
+
+
+#if defined(TRACE)
+static char trace_json[16384];
+#endif
+
+static f2elm_t fa, fb, fc;
+static point_proj_t R, P;
+
+
+int main(void)
+{
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES], sk[CRYPTO_SECRETKEYBYTES], ct[CRYPTO_CIPHERTEXTBYTES];
+    unsigned char ss[CRYPTO_BYTES], ss_[CRYPTO_BYTES], skA[SECRETKEY_A_BYTES];
+    f2elm_t XPA, XQA, XRA, coeff[3], A24plus = {0}, C24 = {0}, A24, C;
+    digit_t SecretKeyA[NWORDS_ORDER] = {0};
+    uint64_t t0, t1;
+    unsigned int i;
+    int status = 0;
+
+    hal_setup();
+    hal_puts("bench " CRYPTO_ALGNAME "\n");
+
+    t0 = hal_get_ticks();
+    calibration_loop(BENCH_CAL_LOOPS);
+    t1 = hal_get_ticks();
+    hal_puts("cal ");
+    hal_putu64(2*(uint64_t)BENCH_CAL_LOOPS + 2);
+    hal_putc(' ');
+    hal_putu64(t1 - t0);
+    hal_putc('\n');
+
+    // Field arithmetic
+    random_felm(fa[0]); random_felm(fa[1]);
+    random_felm(fb[0]); random_felm(fb[1]);
+    BENCH("fpmul_mont", BENCH_FIELD_ITERS, fpmul_mont(fa[0], fb[0], fc[0]));
+    BENCH("fpsqr_mont", BENCH_FIELD_ITERS, fpsqr_mont(fa[0], fc[0]));
+    BENCH("fp2mul_mont", BENCH_FIELD_ITERS, fp2mul_mont(fa, fb, fc));
+    BENCH("fp2sqr_mont", BENCH_FIELD_ITERS, fp2sqr_mont(fa, fc));
+    BENCH("fpinv_mont", BENCH_CURVE_ITERS, fpinv_mont(fc[0]));
+
+    // Curve and isogeny arithmetic on E_6: A24plus = A+2C = 8, C24 = 4C = 4, which is also A24minus = A-2C
+    fpcopy((digit_t*)&Montgomery_one, A24plus[0]);
+    fp2add(A24plus, A24plus, A24plus);
+    fp2add(A24plus, A24plus, C24);
+    fp2add(C24, C24, A24plus);
+    fp2copy(fa, R->X);
+    fp2copy(fb, R->Z);
+    fp2copy(fb, P->X);
+    fp2copy(fa, P->Z);
+    BENCH("xDBLe", BENCH_CURVE_ITERS, xDBLe(R, R, A24plus, C24, 2));
+    BENCH("get_4_isog", BENCH_CURVE_ITERS, get_4_isog(R, A24, C, coeff));
+    BENCH("eval_4_isog", BENCH_CURVE_ITERS, eval_4_isog(P, coeff));
+    BENCH("xTPLe", BENCH_CURVE_ITERS, xTPLe(R, R, C24, A24plus, 1));
+    BENCH("get_3_isog", BENCH_CURVE_ITERS, get_3_isog(R, A24, C, coeff));
+    BENCH("eval_3_isog", BENCH_CURVE_ITERS, eval_3_isog(P, coeff));
+
+    init_basis((digit_t*)A_gen, XPA, XQA, XRA);
+    random_mod_order_A(skA);
+    decode_to_digits(skA, SecretKeyA, SECRETKEY_A_BYTES, NWORDS_ORDER);
+    BENCH("LADDER3PT", BENCH_LADDER_ITERS, LADDER3PT(XPA, XQA, XRA, SecretKeyA, ALICE, R, A24plus, C24[0]));
+
+    // KEM
+    BENCH_KEM("crypto_kem_keypair", crypto_kem_keypair(pk, sk));
+    BENCH_KEM("crypto_kem_enc", crypto_kem_enc(ct, ss, pk));
+    BENCH_KEM("crypto_kem_dec", crypto_kem_dec(ss_, ct, sk));
+    for (i = 0; i < CRYPTO_BYTES; i++) {
+        status |= ss[i] ^ ss_[i];
+    }
+    status |= batch_check(pk, sk);
+
+#if defined(TRACE)
+    // Timestamps in SysTick ticks, run_qemu.py converts them to instructions
+    trace_set_clock(hal_get_ticks, 1);
+    trace_reset();
+    crypto_kem_dec(ss_, ct, sk);
+    if (trace_export_json(trace_json, sizeof(trace_json)) != 0) {
+        hal_puts("trace\n");
+        hal_puts(trace_json);
+        hal_puts("end trace\n");
+    }
+#endif
+
+    hal_puts(status == 0 ? "done ok\n" : "done ERROR shared secrets differ\n");
+    return status;
+}
@@ -0,0 +1,114 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: cSHAKE256 for the standalone benchmark firmware, compact C Keccak-f[1600]
+*           (pqm4 links its assembly Keccak instead, so KEM totals include a slower hash here)
+*********************************************************************************************/
+
+#include <string.h>
+#include "fips202.h"
+
+#define ROL64(a, n) (((a) << (n)) ^ ((a) >> (64 - (n))))
+
+
+static const uint64_t KeccakF_RoundConstants[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+    0x000000000000808bULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800aULL, 0x800000008000000aULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+static const unsigned int KeccakF_RotationOffsets[24] = {
+    1, 3, 6, 10, 15, 21, 28, 36, 45, 55, 2, 14, 27, 41, 56, 8, 25, 43, 62, 18, 39, 61, 20, 44
+};
+
+static const unsigned int KeccakF_PiLane[24] = {
+    10, 7, 11, 17, 18, 3, 5, 16, 8, 21, 24, 4, 15, 23, 19, 13, 12, 2, 20, 14, 22, 9, 6, 1
+};
+
+
+static void KeccakF1600_StatePermute(uint64_t *s)
+{ // Keccak-f[1600] permutation on a little-endian state of 25 lanes
+    uint64_t bc[5], t;
+    unsigned int round, i, j;
+
+    for (round = 0; round < 24; round++) {
+        // Theta
+        for (i = 0; i < 5; i++) {
+            bc[i] = s[i] ^ s[i + 5] ^ s[i + 10] ^ s[i + 15] ^ s[i + 20];
+        }
+        for (i = 0; i < 5; i++) {
+            t = bc[(i + 4) % 5] ^ ROL64(bc[(i + 1) % 5], 1);
+            for (j = 0; j < 25; j += 5) {
+                s[j + i] ^= t;
+            }
+        }
+        // Rho and pi
+        t = s[1];
+        for (i = 0; i < 24; i++) {
+            j = KeccakF_PiLane[i];
+            bc[0] = s[j];
+            s[j] = ROL64(t, KeccakF_RotationOffsets[i]);
+            t = bc[0];
+        }
+        // Chi
+        for (j = 0; j < 25; j += 5) {
+            for (i = 0; i < 5; i++) {
+                bc[i] = s[j + i];
+            }
+            for (i = 0; i < 5; i++) {
+                s[j + i] ^= (~bc[(i + 1) % 5]) & bc[(i + 2) % 5];
+            }
+        }
+        // Iota
+        s[0] ^= KeccakF_RoundConstants[round];
+    }
+}
+
+
+static void xor_bytes(uint64_t *s, const unsigned char *in, unsigned int len)
+{ // XOR len bytes into the state, lanes are little-endian
+    unsigned int i;
+
+    for (i = 0; i < len; i++) {
+        s[i / 8] ^= (uint64_t)in[i] << (8 * (i % 8));
+    }
+}
+
+
+void cshake256_simple(unsigned char *output, unsigned long long outlen, uint16_t cstm, const unsigned char *in, unsigned long long inlen)
+{ // cSHAKE256(in, outlen, "", cstm): the prefix bytepad(encode_string("") || encode_string(cstm), 136) fills exactly one block
+    uint64_t s[25];
+    unsigned char sep[8] = {0x01, 0x88, 0x01, 0x00, 0x01, 0x10, 0, 0};
+    unsigned char t[SHAKE256_RATE];
+    unsigned int i;
+
+    memset(s, 0, sizeof(s));
+    sep[6] = (unsigned char)(cstm & 0xFF);
+    sep[7] = (unsigned char)(cstm >> 8);
+    xor_bytes(s, sep, 8);
+    KeccakF1600_StatePermute(s);
+
+    // Absorb
+    while (inlen >= SHAKE256_RATE) {
+        xor_bytes(s, in, SHAKE256_RATE);
+        KeccakF1600_StatePermute(s);
+        in += SHAKE256_RATE;
+        inlen -= SHAKE256_RATE;
+    }
+    memset(t, 0, sizeof(t));
+    memcpy(t, in, (size_t)inlen);
+    t[inlen] = 0x04;
+    t[SHAKE256_RATE - 1] |= 0x80;
+    xor_bytes(s, t, SHAKE256_RATE);
+
+    // Squeeze
+    while (outlen > 0) {
+        KeccakF1600_StatePermute(s);
+        for (i = 0; i < SHAKE256_RATE && outlen > 0; i++, outlen--) {
+            *output++ = (unsigned char)(s[i / 8] >> (8 * (i % 8)));
+        }
+    }
+}
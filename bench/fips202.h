@@ -0,0 +1,17 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: cSHAKE256 for the standalone benchmark firmware (same interface as pqm4's fips202.h)
+*********************************************************************************************/
+
+#ifndef FIPS202_H
+#define FIPS202_H
+
+#include <stdint.h>
+
+#define SHAKE256_RATE 136
+
+// cSHAKE256 with empty function name and the 16-bit customization string cstm
+void cshake256_simple(unsigned char *output, unsigned long long outlen, uint16_t cstm, const unsigned char *in, unsigned long long inlen);
+
+#endif
@@ -0,0 +1,145 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: startup code and minimal hardware abstraction for QEMU's mps2-an386 (Cortex-M4)
+*           Run with: qemu-system-arm -M mps2-an386 -nographic -semihosting -icount shift=0 -kernel <elf>
+*********************************************************************************************/
+
+#include "hal.h"
+
+#define REG32(addr)        (*(volatile uint32_t*)(addr))
+
+// CMSDK APB UART0
+#define UART0_DATA         REG32(0x40004000)
+#define UART0_STATE        REG32(0x40004004)
+#define UART0_CTRL         REG32(0x40004008)
+#define UART0_BAUDDIV      REG32(0x40004010)
+
+// SysTick and system control block
+#define SYST_CSR           REG32(0xE000E010)
+#define SYST_RVR           REG32(0xE000E014)
+#define SYST_CVR           REG32(0xE000E018)
+#define SCB_CPACR          REG32(0xE000ED88)
+
+#define SYSTICK_BITS       24
+#define SYSTICK_RELOAD     ((1UL << SYSTICK_BITS) - 1)
+
+// Semihosting SYS_EXIT reasons
+#define ADP_STOPPED_APPLICATIONEXIT   0x20026
+#define ADP_STOPPED_RUNTIMEERROR      0x20023
+
+extern uint32_t _estack, _sidata, _sdata, _edata, _sbss, _ebss;
+extern int main(void);
+
+static volatile uint32_t systick_overflows = 0;
+
+
+void Reset_Handler(void)
+{
+    uint32_t *src = &_sidata, *dst = &_sdata;
+
+    while (dst < &_edata) {
+        *dst++ = *src++;
+    }
+    for (dst = &_sbss; dst < &_ebss; dst++) {
+        *dst = 0;
+    }
+    SCB_CPACR |= (0xFUL << 20);                   // Full access to CP10/CP11 (FPU), the M4 kernels use s0-s31
+    asm volatile("dsb \n\t isb" ::: "memory");
+
+    hal_exit(main());
+}
+
+
+static void Default_Handler(void)
+{
+    hal_puts("fault\n");
+    hal_exit(1);
+}
+
+
+void SysTick_Handler(void)
+{
+    systick_overflows++;
+}
+
+
+__attribute__ ((section(".isr_vector"), used))
+static void (* const vector_table[16])(void) = {
+    (void (*)(void))&_estack,
+    Reset_Handler,
+    Default_Handler,                              // NMI
+    Default_Handler,                              // HardFault
+    Default_Handler,                              // MemManage
+    Default_Handler,                              // BusFault
+    Default_Handler,                              // UsageFault
+    0, 0, 0, 0,
+    Default_Handler,                              // SVCall
+    Default_Handler,                              // DebugMonitor
+    0,
+    Default_Handler,                              // PendSV
+    SysTick_Handler,
+};
+
+
+void hal_setup(void)
+{
+    UART0_BAUDDIV = 16;
+    UART0_CTRL = 1;                               // TX enable
+
+    SYST_RVR = SYSTICK_RELOAD;
+    SYST_CVR = 0;
+    SYST_CSR = 7;                                 // Processor clock, interrupt on wrap, enable
+}
+
+
+uint64_t hal_get_ticks(void)
+{
+    uint32_t ovf, val;
+
+    do {
+        ovf = systick_overflows;
+        val = SYST_CVR;
+    } while (ovf != systick_overflows);
+
+    return ((uint64_t)ovf << SYSTICK_BITS) + (SYSTICK_RELOAD - val);
+}
+
+
+void hal_putc(char c)
+{
+    while (UART0_STATE & 1);                      // TX buffer full
+    UART0_DATA = (uint32_t)c;
+}
+
+
+void hal_puts(const char* s)
+{
+    while (*s) {
+        hal_putc(*s++);
+    }
+}
+
+
+void hal_putu64(uint64_t x)
+{
+    char buf[21];
+    int i = 20;
+
+    buf[i] = 0;
+    do {
+        buf[--i] = (char)('0' + (x % 10));
+        x /= 10;
+    } while (x != 0);
+    hal_puts(&buf[i]);
+}
+
+
+void hal_exit(int status)
+{
+    register uint32_t r0 asm("r0") = 0x18;        // SYS_EXIT
+    register uint32_t r1 asm("r1") = (status == 0) ? ADP_STOPPED_APPLICATIONEXIT : ADP_STOPPED_RUNTIMEERROR;
+
+    asm volatile("bkpt 0xab" : : "r"(r0), "r"(r1) : "memory");
+    for (;;);
+}
@@ -0,0 +1,26 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: minimal hardware abstraction for the mps2-an386 benchmark firmware
+*********************************************************************************************/
+
+#ifndef HAL_H
+#define HAL_H
+
+#include <stdint.h>
+
+// Initializes the FPU, UART0 and a free-running SysTick counter on the processor clock
+void hal_setup(void);
+
+// Number of SysTick ticks since hal_setup(), overflows of the 24-bit counter are accumulated in software
+uint64_t hal_get_ticks(void);
+
+// Output on UART0
+void hal_putc(char c);
+void hal_puts(const char* s);
+void hal_putu64(uint64_t x);
+
+// Ends the simulation through semihosting, QEMU exits with status 0 if status == 0 and 1 otherwise
+void hal_exit(int status) __attribute__ ((noreturn));
+
+#endif
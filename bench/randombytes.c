@@ -0,0 +1,23 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: deterministic randombytes for the standalone benchmark firmware. NOT for production use
+*           A fixed-seed xorshift generator keeps instruction counts reproducible between runs
+*********************************************************************************************/
+
+#include <stdint.h>
+#include "randombytes.h"
+
+static uint32_t state = 0x2545F491;
+
+
+int randombytes(unsigned char *x, unsigned long long xlen)
+{
+    while (xlen--) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        *x++ = (unsigned char)(state >> 24);
+    }
+    return 0;
+}
@@ -0,0 +1,12 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: deterministic randombytes for the standalone benchmark firmware. NOT for production use
+*********************************************************************************************/
+
+#ifndef RANDOMBYTES_H
+#define RANDOMBYTES_H
+
+int randombytes(unsigned char *x, unsigned long long xlen);
+
+#endif
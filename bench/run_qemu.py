@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""Runs the mps2-an386 benchmark firmware under QEMU and reports instruction counts.
+
+QEMU does not model Cortex-M4 timing. With -icount shift=0 every guest
+instruction advances the virtual clock by 1 ns, and SysTick counts that clock.
+Each firmware image first times a loop with a known instruction count, and the
+other measurements are scaled by that ratio, so the reported numbers are exact
+instruction counts (up to one SysTick period per measurement).
+
+usage: python3 bench/run_qemu.py [PRIME ...] [--json FILE] [--baseline FILE] [--tolerance PCT]
+
+Firmware images are expected as bench/bench-sikep<PRIME>.elf (see bench/Makefile).
+With --baseline, the exit status is 1 if any operation got slower than the
+baseline report by more than --tolerance percent.
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+
+PRIMES = (434, 503, 610, 751)
+# Order of the counts on the "count" lines (OP_* indices in P*_internal.h)
+COUNTED_OPS = ('fpmul', 'fpsqr', 'fp2mul', 'fpadd', 'fpsub', 'fpcorrection', 'fpinv', 'swap_points')
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+
+def run_firmware(qemu, elf, timeout):
+    cmd = [qemu, '-M', 'mps2-an386', '-nographic', '-semihosting', '-icount', 'shift=0', '-kernel', elf]
+    proc = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, timeout=timeout)
+    return proc.returncode, proc.stdout.decode(errors='replace')
+
+
+def parse(output):
+    """Parses the firmware output (see the header of bench.c) into {op: instructions} and
+    {kem op: {phase: {counted op: n}}}, the latter empty unless built with OPCOUNT=1,
+    and the decapsulation trace of a TRACE=1 build (None otherwise)."""
+    cal_insns = cal_ticks = None
+    ops, counts, name, status = {}, {}, None, None
+    trace, trace_lines = None, None
+    for line in output.splitlines():
+        f = line.split()
+        if trace_lines is not None:
+            if line.strip() == 'end trace':
+                trace, trace_lines = json.loads('\n'.join(trace_lines)), None
+            else:
+                trace_lines.append(line)
+            continue
+        if not f:
+            continue
+        if f[0] == 'trace':
+            trace_lines = []
+        elif f[0] == 'bench':
+            name = f[1]
+        elif f[0] == 'cal':
+            cal_insns, cal_ticks = int(f[1]), int(f[2])
+        elif f[0] == 'op':
+            ops[f[1]] = (int(f[2]), int(f[3]))
+        elif f[0] == 'count':
+            counts.setdefault(f[1], {})[f[2]] = dict(zip(COUNTED_OPS, map(int, f[3:])))
+        elif f[0] == 'done':
+            status = ' '.join(f[1:])
+    if cal_insns is None or not cal_ticks or status is None:
+        raise ValueError('incomplete benchmark output:\n' + output)
+    insns_per_tick = cal_insns / cal_ticks
+    result = {op: round(ticks * insns_per_tick / iters) for op, (iters, ticks) in ops.items()}
+    if trace is not None:
+        # The firmware exports SysTick ticks, the viewer then shows one instruction per microsecond
+        for e in trace['traceEvents']:
+            e['ts'] = round(e['ts'] * insns_per_tick)
+        trace['otherData']['unit'] = 'instructions'
+    return name, status, insns_per_tick, result, counts, trace
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    ap.add_argument('primes', nargs='*', type=int, default=list(PRIMES))
+    ap.add_argument('--qemu', default='qemu-system-arm')
+    ap.add_argument('--elf-dir', default=HERE)
+    ap.add_argument('--timeout', type=int, default=3600, help='seconds per firmware image')
+    ap.add_argument('--json', help='write the report to this file')
+    ap.add_argument('--baseline', help='report to compare against')
+    ap.add_argument('--tolerance', type=float, default=1.0, help='allowed slowdown in percent')
+    ap.add_argument('--trace-dir', default='.', help='where trace-<algorithm>.json of TRACE=1 builds are written')
+    args = ap.parse_args()
+
+    report = {'machine': 'mps2-an386', 'unit': 'instructions', 'results': {}}
+    failed = False
+    for p in args.primes:
+        elf = os.path.join(args.elf_dir, 'bench-sikep%d.elf' % p)
+        rc, out = run_firmware(args.qemu, elf, args.timeout)
+        name, status, ipt, result, counts, trace = parse(out)
+        if rc != 0 or status != 'ok':
+            print('%s: firmware failed (exit %d, %s)' % (name, rc, status), file=sys.stderr)
+            failed = True
+        report['results'][name] = result
+        print('%s (%.1f instructions per tick)' % (name, ipt))
+        for op, n in result.items():
+            print('  %-20s %12d' % (op, n))
+        if trace is not None:
+            path = os.path.join(args.trace_dir, 'trace-%s.json' % name)
+            with open(path, 'w') as f:
+                json.dump(trace, f)
+            print('  trace written to %s' % path)
+        if counts:
+            report.setdefault('op_counts', {})[name] = counts
+            print('  %-20s %-10s %s' % ('', 'phase', ' '.join('%12s' % op for op in COUNTED_OPS)))
+            for op, phases in counts.items():
+                for phase, c in phases.items():
+                    print('  %-20s %-10s %s' % (op, phase, ' '.join('%12d' % c[o] for o in COUNTED_OPS)))
+
+    if args.json:
+        with open(args.json, 'w') as f:
+            json.dump(report, f, indent=2, sort_keys=True)
+            f.write('\n')
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            base = json.load(f)['results']
+        for name, result in report['results'].items():
+            for op, n in result.items():
+                b = base.get(name, {}).get(op)
+                if b is None:
+                    continue
+                delta = 100.0 * (n - b) / b
+                if delta > args.tolerance:
+                    print('REGRESSION %s %s: %d -> %d (%+.2f%%)' % (name, op, b, n, delta), file=sys.stderr)
+                    failed = True
+
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,313 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: AVX-512 IFMA arithmetic over GF(p434) and GF(p434^2) on 8 independent elements at once
+*********************************************************************************************/
+
+#include "../P434_internal.h"
+
+#if defined(IFMA)
+
+#include <string.h>
+#include <immintrin.h>
+
+// The functions using AVX-512 are compiled for it individually, the library itself keeps running on any x64 CPU
+#define IFMA_TARGET             __attribute__((target("avx512f,avx512ifma")))
+
+#define NLIMBS52                9           // Radix-2^52 limbs, 2^(52*NLIMBS52) > 4*p434
+#define MASK52                  0xFFFFFFFFFFFFFULL
+
+// Lane-sliced elements: limb i of the element in lane k is the k-th 64-bit word of v[i], below 2^52 between operations.
+// Elements are in [0, 2p-1] in Montgomery representation with R = 2^(52*NLIMBS52), p' = -p^(-1) mod 2^52 = 1
+typedef __m512i vfelm_t[NLIMBS52];
+typedef vfelm_t vf2elm_t[2];
+typedef struct { vf2elm_t X; vf2elm_t Z; } vpoint_proj;
+typedef vpoint_proj vpoint_proj_t[1];
+
+static const uint64_t ifma_p[NLIMBS52]         = { 0x000FFFFFFFFFFFFF, 0x000FFFFFFFFFFFFF, 0x000FFFFFFFFFFFFF, 0x000FFFFFFFFFFFFF,
+                                                   0x0003FDC1767AE2FF, 0x000C65C783158AEA, 0x000FD681C520567B, 0x000271773446CFC5,
+                                                   0x000000000002341F };
+static const uint64_t ifma_px2[NLIMBS52]       = { 0x000FFFFFFFFFFFFE, 0x000FFFFFFFFFFFFF, 0x000FFFFFFFFFFFFF, 0x000FFFFFFFFFFFFF,
+                                                   0x0007FB82ECF5C5FF, 0x0008CB8F062B15D4, 0x000FAD038A40ACF7, 0x0004E2EE688D9F8B,
+                                                   0x000000000004683E };
+// Montgomery one, R mod p434
+static const uint64_t ifma_one[NLIMBS52]       = { 0x0000000742C6B854, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+                                                   0x000428CB3A858400, 0x0005776FEC6D4724, 0x000D2D0AD9D41CF5, 0x0008B890471DE8D4,
+                                                   0x00000000000012F4 };
+// Conversion constants R^2/2^448 and 2^448 mod p434, between the scalar (R = 2^448) and the radix-2^52 representations
+static const uint64_t ifma_to_mont[NLIMBS52]   = { 0x00042C6B854089A1, 0x0000000000000007, 0x0000000000000000, 0x0000000000000000,
+                                                   0x00048944F93C3D00, 0x000AFF347A606F4C, 0x000C432687B6D670, 0x00024AECC7938CE9,
+                                                   0x000000000001450D };
+static const uint64_t ifma_from_mont[NLIMBS52] = { 0x000000000000742C, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+                                                   0x0004B90FF404FC00, 0x00001A4FB559FACD, 0x0004545F77410CD8, 0x000A7BD2EDAE9325,
+                                                   0x000000000000ECEE };
+
+
+static void ifma_repack(const uint64_t* in, const unsigned int inbits, const unsigned int nin, uint64_t* out, const unsigned int outbits, const unsigned int nout)
+{ // Changes the radix of a little-endian integer from 2^inbits to 2^outbits, inbits and outbits <= 64.
+  // Bits beyond nout digits are dropped
+    unsigned __int128 acc = 0;
+    unsigned int i, j = 0, n = 0;
+    uint64_t mask = (outbits == 64) ? (uint64_t)-1 : ((uint64_t)1 << outbits) - 1;
+
+    for (i = 0; i < nout; i++) {
+        while (n < outbits && j < nin) {
+            acc |= (unsigned __int128)in[j++] << n;
+            n += inbits;
+        }
+        out[i] = (uint64_t)acc & mask;
+        acc >>= outbits;
+        n = (n > outbits) ? n - outbits : 0;
+    }
+}
+
+
+static IFMA_TARGET __m512i vfp_carry(__m512i* a)
+{ // Propagates the signed carries of a to 52-bit limbs, returns the carry out of the top limb (0 or -1)
+    __m512i carry = _mm512_setzero_si512(), mask = _mm512_set1_epi64(MASK52);
+    unsigned int i;
+
+    for (i = 0; i < NLIMBS52; i++) {
+        a[i] = _mm512_add_epi64(a[i], carry);
+        carry = _mm512_srai_epi64(a[i], 52);
+        a[i] = _mm512_and_si512(a[i], mask);
+    }
+    return carry;
+}
+
+
+static IFMA_TARGET void vfpcopy(const __m512i* a, __m512i* c)
+{
+    unsigned int i;
+
+    for (i = 0; i < NLIMBS52; i++) {
+        c[i] = a[i];
+    }
+}
+
+
+static IFMA_TARGET void vfpadd(const __m512i* a, const __m512i* b, __m512i* c)
+{ // Modular addition, c = a+b mod p434.
+  // Inputs: a, b in [0, 2*p434-1]
+  // Output: c in [0, 2*p434-1]
+    __m512i t[NLIMBS52], mask;
+    unsigned int i;
+
+    for (i = 0; i < NLIMBS52; i++) {
+        t[i] = _mm512_sub_epi64(_mm512_add_epi64(a[i], b[i]), _mm512_set1_epi64(ifma_px2[i]));
+    }
+    mask = vfp_carry(t);
+    for (i = 0; i < NLIMBS52; i++) {
+        t[i] = _mm512_add_epi64(t[i], _mm512_and_si512(mask, _mm512_set1_epi64(ifma_px2[i])));
+    }
+    vfp_carry(t);
+    vfpcopy(t, c);
+}
+
+
+static IFMA_TARGET void vfpsub(const __m512i* a, const __m512i* b, __m512i* c)
+{ // Modular subtraction, c = a-b mod p434.
+  // Inputs: a, b in [0, 2*p434-1]
+  // Output: c in [0, 2*p434-1]
+    __m512i t[NLIMBS52], mask;
+    unsigned int i;
+
+    for (i = 0; i < NLIMBS52; i++) {
+        t[i] = _mm512_sub_epi64(a[i], b[i]);
+    }
+    mask = vfp_carry(t);
+    for (i = 0; i < NLIMBS52; i++) {
+        t[i] = _mm512_add_epi64(t[i], _mm512_and_si512(mask, _mm512_set1_epi64(ifma_px2[i])));
+    }
+    vfp_carry(t);
+    vfpcopy(t, c);
+}
+
+
+static IFMA_TARGET void vfpcorrection(__m512i* a)
+{ // Modular correction to reduce field element a in [0, 2*p434-1] to [0, p434-1].
+    __m512i mask;
+    unsigned int i;
+
+    for (i = 0; i < NLIMBS52; i++) {
+        a[i] = _mm512_sub_epi64(a[i], _mm512_set1_epi64(ifma_p[i]));
+    }
+    mask = vfp_carry(a);
+    for (i = 0; i < NLIMBS52; i++) {
+        a[i] = _mm512_add_epi64(a[i], _mm512_and_si512(mask, _mm512_set1_epi64(ifma_p[i])));
+    }
+    vfp_carry(a);
+}
+
+
+static IFMA_TARGET void vfpmul_mont(const __m512i* a, const __m512i* b, __m512i* c)
+{ // Montgomery multiplication, c = a*b*R^(-1) mod p434, interleaving the products of b[i] with the reduction by q*p,
+  // q = t[0] mod 2^52. The accumulators are not normalized in between, they stay below 4*NLIMBS52*2^52 < 2^64.
+  // Inputs: a, b in [0, 2*p434-1]
+  // Output: c in [0, 2*p434-1]
+    __m512i t[NLIMBS52+1], q, mask = _mm512_set1_epi64(MASK52);
+    unsigned int i, j;
+
+    for (j = 0; j <= NLIMBS52; j++) {
+        t[j] = _mm512_setzero_si512();
+    }
+    for (i = 0; i < NLIMBS52; i++) {
+        for (j = 0; j < NLIMBS52; j++) {
+            t[j] = _mm512_madd52lo_epu64(t[j], a[j], b[i]);
+            t[j+1] = _mm512_madd52hi_epu64(t[j+1], a[j], b[i]);
+        }
+        q = _mm512_and_si512(t[0], mask);
+        for (j = 0; j < NLIMBS52; j++) {
+            t[j] = _mm512_madd52lo_epu64(t[j], q, _mm512_set1_epi64(ifma_p[j]));
+            t[j+1] = _mm512_madd52hi_epu64(t[j+1], q, _mm512_set1_epi64(ifma_p[j]));
+        }
+        t[1] = _mm512_add_epi64(t[1], _mm512_srli_epi64(t[0], 52));     // t[0] = 0 mod 2^52
+        for (j = 0; j < NLIMBS52; j++) {
+            t[j] = t[j+1];
+        }
+        t[NLIMBS52] = _mm512_setzero_si512();
+    }
+    vfp_carry(t);
+    vfpcopy(t, c);
+}
+
+
+static IFMA_TARGET void vfp2copy(const vfelm_t* a, vfelm_t* c)
+{
+    vfpcopy(a[0], c[0]);
+    vfpcopy(a[1], c[1]);
+}
+
+
+static IFMA_TARGET void vfp2add(const vfelm_t* a, const vfelm_t* b, vfelm_t* c)
+{ // GF(p434^2) addition, c = a+b in GF(p434^2).
+    vfpadd(a[0], b[0], c[0]);
+    vfpadd(a[1], b[1], c[1]);
+}
+
+
+static IFMA_TARGET void vfp2sub(const vfelm_t* a, const vfelm_t* b, vfelm_t* c)
+{ // GF(p434^2) subtraction, c = a-b in GF(p434^2).
+    vfpsub(a[0], b[0], c[0]);
+    vfpsub(a[1], b[1], c[1]);
+}
+
+
+static IFMA_TARGET void vfp2mul_mont(const vfelm_t* a, const vfelm_t* b, vfelm_t* c)
+{ // GF(p434^2) multiplication using Montgomery arithmetic, c = a*b in GF(p434^2), with 3 GF(p434) multiplications.
+  // Inputs: a = a0+a1*i and b = b0+b1*i, where a0, a1, b0, b1 are in [0, 2*p434-1]
+  // Output: c = c0+c1*i, where c0, c1 are in [0, 2*p434-1]
+    vfelm_t t0, t1, t2, t3;
+
+    vfpadd(a[0], a[1], t0);                         // t0 = a0+a1
+    vfpadd(b[0], b[1], t1);                         // t1 = b0+b1
+    vfpmul_mont(t0, t1, t2);                        // t2 = (a0+a1)*(b0+b1)
+    vfpmul_mont(a[0], b[0], t0);                    // t0 = a0*b0
+    vfpmul_mont(a[1], b[1], t1);                    // t1 = a1*b1
+    vfpsub(t2, t0, t3);
+    vfpsub(t3, t1, c[1]);                           // c1 = a0*b1+a1*b0
+    vfpsub(t0, t1, c[0]);                           // c0 = a0*b0-a1*b1
+}
+
+
+static IFMA_TARGET void vfp2sqr_mont(const vfelm_t* a, vfelm_t* c)
+{ // GF(p434^2) squaring using Montgomery arithmetic, c = a^2 in GF(p434^2).
+  // Inputs: a = a0+a1*i, where a0, a1 are in [0, 2*p434-1]
+  // Output: c = c0+c1*i, where c0, c1 are in [0, 2*p434-1]
+    vfelm_t t0, t1, t2;
+
+    vfpadd(a[0], a[1], t0);                         // t0 = a0+a1
+    vfpsub(a[0], a[1], t1);                         // t1 = a0-a1
+    vfpadd(a[0], a[0], t2);                         // t2 = 2a0
+    vfpmul_mont(t2, a[1], c[1]);                    // c1 = 2a0*a1
+    vfpmul_mont(t0, t1, c[0]);                      // c0 = (a0+a1)(a0-a1)
+}
+
+
+static IFMA_TARGET void vfp_load(__m512i* r, const digit_t* const* a)
+{ // Lane k of r <- the GF(p434) element at a[k], still in the scalar Montgomery representation
+    uint64_t t[IFMA_LANES][NLIMBS52], u[NLIMBS52][IFMA_LANES];
+    unsigned int i, k;
+
+    for (k = 0; k < IFMA_LANES; k++) {
+        ifma_repack((const uint64_t*)a[k], 64, NWORDS64_FIELD, t[k], 52, NLIMBS52);
+    }
+    for (i = 0; i < NLIMBS52; i++) {
+        for (k = 0; k < IFMA_LANES; k++) {
+            u[i][k] = t[k][i];
+        }
+        memcpy(&r[i], u[i], sizeof(u[i]));
+    }
+}
+
+
+static IFMA_TARGET void vfp2_load(vfelm_t* r, const felm_t* const* a)
+{ // Lane k of r <- the GF(p434^2) element at a[k], converted from the scalar Montgomery representation.
+  // Input: a[k] in [0, 2^(64*NWORDS64_FIELD)-1]
+  // Output: r in [0, 2*p434-1]
+    const digit_t* a0[IFMA_LANES], *a1[IFMA_LANES];
+    vfelm_t c;
+    unsigned int k;
+
+    for (k = 0; k < IFMA_LANES; k++) {
+        a0[k] = a[k][0];
+        a1[k] = a[k][1];
+    }
+    for (k = 0; k < NLIMBS52; k++) {
+        c[k] = _mm512_set1_epi64((long long)ifma_to_mont[k]);
+    }
+    vfp_load(r[0], a0);
+    vfp_load(r[1], a1);
+    vfpmul_mont(r[0], c, r[0]);
+    vfpmul_mont(r[1], c, r[1]);
+}
+
+
+static IFMA_TARGET void vfp2_store(const vfelm_t* a, felm_t* const* r, const unsigned int n)
+{ // The GF(p434^2) elements in lanes k < n of a -> r[k], converted to the scalar Montgomery representation in [0, p434-1]
+    uint64_t t[IFMA_LANES][NLIMBS52], u[NLIMBS52][IFMA_LANES];
+    vfelm_t b, c;
+    unsigned int i, j, k;
+
+    for (i = 0; i < NLIMBS52; i++) {
+        c[i] = _mm512_set1_epi64((long long)ifma_from_mont[i]);
+    }
+    for (j = 0; j < 2; j++) {
+        vfpmul_mont(a[j], c, b);
+        vfpcorrection(b);
+        for (i = 0; i < NLIMBS52; i++) {
+            memcpy(u[i], &b[i], sizeof(u[i]));
+            for (k = 0; k < IFMA_LANES; k++) {
+                t[k][i] = u[i][k];
+            }
+        }
+        for (k = 0; k < n; k++) {
+            ifma_repack(t[k], 52, NLIMBS52, (uint64_t*)r[k][j], 64, NWORDS64_FIELD);
+        }
+    }
+}
+
+
+static IFMA_TARGET void vfp2_set(vfelm_t* r, const f2elm_t a)
+{ // All lanes of r <- a
+    const felm_t* p[IFMA_LANES];
+    unsigned int k;
+
+    for (k = 0; k < IFMA_LANES; k++) {
+        p[k] = a;
+    }
+    vfp2_load(r, p);
+}
+
+
+static IFMA_TARGET void vfp2_one(vfelm_t* r)
+{ // All lanes of r <- 1 in GF(p434^2)
+    unsigned int i;
+
+    for (i = 0; i < NLIMBS52; i++) {
+        r[0][i] = _mm512_set1_epi64((long long)ifma_one[i]);
+        r[1][i] = _mm512_setzero_si512();
+    }
+}
+
+#endif
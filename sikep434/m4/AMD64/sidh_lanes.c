@@ -0,0 +1,542 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: ladder and tree traversal of the batch engines, LANES independent operations of one party computed in
+*           the lanes of a vector arithmetic. Included by sidh_ifma.c and sidh_avx2.c, which define the macros below
+*********************************************************************************************/
+
+// LANE(name)      name of the vector arithmetic and of the functions below, vfp2add for IFMA or yfp2add for AVX2
+// LANE_API(name)  name of the public functions, KeyGeneration_ifma or KeyGeneration_avx2
+// LANE_TARGET     target attribute of the functions
+// LANES           number of lanes, LANE_LIMBS limbs of type lane_t per GF(p) element
+// LANE_ZERO(), LANE_ONE(), LANE_AND(a, b), LANE_XOR(a, b), LANE_SUB(a, b), LANE_SRLI(a, n)
+//                 64-bit lane operations of lane_t
+
+static LANE_TARGET void LANE(xDBL)(const LANE(point_proj_t) P, LANE(point_proj_t) Q, const LANE(f2elm_t) A24plus, const LANE(f2elm_t) C24)
+{ // Doubling of Montgomery points in projective coordinates (X:Z), as xDBL()
+    LANE(f2elm_t) t0, t1;
+
+    LANE(fp2sub)(P->X, P->Z, t0);                   // t0 = X1-Z1
+    LANE(fp2add)(P->X, P->Z, t1);                   // t1 = X1+Z1
+    LANE(fp2sqr_mont)(t0, t0);                      // t0 = (X1-Z1)^2
+    LANE(fp2sqr_mont)(t1, t1);                      // t1 = (X1+Z1)^2
+    LANE(fp2mul_mont)(C24, t0, Q->Z);               // Z2 = C24*(X1-Z1)^2
+    LANE(fp2mul_mont)(t1, Q->Z, Q->X);              // X2 = C24*(X1-Z1)^2*(X1+Z1)^2
+    LANE(fp2sub)(t1, t0, t1);                       // t1 = (X1+Z1)^2-(X1-Z1)^2
+    LANE(fp2mul_mont)(A24plus, t1, t0);             // t0 = A24plus*[(X1+Z1)^2-(X1-Z1)^2]
+    LANE(fp2add)(Q->Z, t0, Q->Z);                   // Z2 = A24plus*[(X1+Z1)^2-(X1-Z1)^2] + C24*(X1-Z1)^2
+    LANE(fp2mul_mont)(Q->Z, t1, Q->Z);              // Z2 = [A24plus*[(X1+Z1)^2-(X1-Z1)^2] + C24*(X1-Z1)^2]*[(X1+Z1)^2-(X1-Z1)^2]
+}
+
+
+static LANE_TARGET void LANE(xDBLe)(const LANE(point_proj_t) P, LANE(point_proj_t) Q, const LANE(f2elm_t) A24plus, const LANE(f2elm_t) C24, const int e)
+{ // Computes [2^e](X:Z) via e repeated doublings, as xDBLe()
+    int i;
+
+    LANE(fp2copy)(P->X, Q->X);
+    LANE(fp2copy)(P->Z, Q->Z);
+    for (i = 0; i < e; i++) {
+        LANE(xDBL)(Q, Q, A24plus, C24);
+    }
+}
+
+#if (OALICE_BITS % 2 == 1)
+
+static LANE_TARGET void LANE(get_2_isog)(const LANE(point_proj_t) P, LANE(f2elm_t) A, LANE(f2elm_t) C)
+{ // 2-isogenous curves of points of order 2, as get_2_isog()
+    LANE(fp2sqr_mont)(P->X, A);                     // A = X2^2
+    LANE(fp2sqr_mont)(P->Z, C);                     // C = Z2^2
+    LANE(fp2sub)(C, A, A);                          // A = Z2^2 - X2^2
+}
+
+
+static LANE_TARGET void LANE(eval_2_isog)(LANE(point_proj_t) P, const LANE(point_proj_t) Q)
+{ // Evaluates the 2-isogenies with kernel points Q at the points P, as eval_2_isog()
+    LANE(f2elm_t) t0, t1, t2, t3;
+
+    LANE(fp2add)(Q->X, Q->Z, t0);                   // t0 = X2+Z2
+    LANE(fp2sub)(Q->X, Q->Z, t1);                   // t1 = X2-Z2
+    LANE(fp2add)(P->X, P->Z, t2);                   // t2 = X+Z
+    LANE(fp2sub)(P->X, P->Z, t3);                   // t3 = X-Z
+    LANE(fp2mul_mont)(t0, t3, t0);                  // t0 = (X2+Z2)*(X-Z)
+    LANE(fp2mul_mont)(t1, t2, t1);                  // t1 = (X2-Z2)*(X+Z)
+    LANE(fp2add)(t0, t1, t2);                       // t2 = (X2+Z2)*(X-Z) + (X2-Z2)*(X+Z)
+    LANE(fp2sub)(t0, t1, t3);                       // t3 = (X2+Z2)*(X-Z) - (X2-Z2)*(X+Z)
+    LANE(fp2mul_mont)(P->X, t2, P->X);              // Xfinal
+    LANE(fp2mul_mont)(P->Z, t3, P->Z);              // Zfinal
+}
+
+#endif
+
+static LANE_TARGET void LANE(get_4_isog)(const LANE(point_proj_t) P, LANE(f2elm_t) A24plus, LANE(f2elm_t) C24, LANE(f2elm_t)* coeff)
+{ // 4-isogenous curves and evaluation coefficients of points of order 4, as get_4_isog()
+    LANE(fp2sub)(P->X, P->Z, coeff[1]);             // coeff[1] = X4-Z4
+    LANE(fp2add)(P->X, P->Z, coeff[2]);             // coeff[2] = X4+Z4
+    LANE(fp2sqr_mont)(P->Z, coeff[0]);              // coeff[0] = Z4^2
+    LANE(fp2add)(coeff[0], coeff[0], coeff[0]);     // coeff[0] = 2*Z4^2
+    LANE(fp2sqr_mont)(coeff[0], C24);               // C24 = 4*Z4^4
+    LANE(fp2add)(coeff[0], coeff[0], coeff[0]);     // coeff[0] = 4*Z4^2
+    LANE(fp2sqr_mont)(P->X, A24plus);               // A24plus = X4^2
+    LANE(fp2add)(A24plus, A24plus, A24plus);        // A24plus = 2*X4^2
+    LANE(fp2sqr_mont)(A24plus, A24plus);            // A24plus = 4*X4^4
+}
+
+
+static LANE_TARGET void LANE(eval_4_isog)(LANE(point_proj_t) P, const LANE(f2elm_t)* coeff)
+{ // Evaluates the 4-isogenies given by coeff at the points P, as eval_4_isog()
+    LANE(f2elm_t) t0, t1;
+
+    LANE(fp2add)(P->X, P->Z, t0);                   // t0 = X+Z
+    LANE(fp2sub)(P->X, P->Z, t1);                   // t1 = X-Z
+    LANE(fp2mul_mont)(t0, coeff[1], P->X);          // X = (X+Z)*coeff[1]
+    LANE(fp2mul_mont)(t1, coeff[2], P->Z);          // Z = (X-Z)*coeff[2]
+    LANE(fp2mul_mont)(t0, t1, t0);                  // t0 = (X+Z)*(X-Z)
+    LANE(fp2mul_mont)(t0, coeff[0], t0);            // t0 = coeff[0]*(X+Z)*(X-Z)
+    LANE(fp2add)(P->X, P->Z, t1);                   // t1 = (X-Z)*coeff[2] + (X+Z)*coeff[1]
+    LANE(fp2sub)(P->X, P->Z, P->Z);                 // Z = (X-Z)*coeff[2] - (X+Z)*coeff[1]
+    LANE(fp2sqr_mont)(t1, t1);                      // t1 = [(X-Z)*coeff[2] + (X+Z)*coeff[1]]^2
+    LANE(fp2sqr_mont)(P->Z, P->Z);                  // Z = [(X-Z)*coeff[2] - (X+Z)*coeff[1]]^2
+    LANE(fp2add)(t1, t0, P->X);                     // X = coeff[0]*(X+Z)*(X-Z) + [(X-Z)*coeff[2] + (X+Z)*coeff[1]]^2
+    LANE(fp2sub)(P->Z, t0, t0);                     // t0 = [(X-Z)*coeff[2] - (X+Z)*coeff[1]]^2 - coeff[0]*(X+Z)*(X-Z)
+    LANE(fp2mul_mont)(P->X, t1, P->X);              // Xfinal
+    LANE(fp2mul_mont)(P->Z, t0, P->Z);              // Zfinal
+}
+
+
+static LANE_TARGET void LANE(xTPL)(const LANE(point_proj_t) P, LANE(point_proj_t) Q, const LANE(f2elm_t) A24minus, const LANE(f2elm_t) A24plus)
+{ // Tripling of Montgomery points in projective coordinates (X:Z), as xTPL()
+    LANE(f2elm_t) t0, t1, t2, t3, t4, t5, t6;
+
+    LANE(fp2sub)(P->X, P->Z, t0);                   // t0 = X-Z
+    LANE(fp2sqr_mont)(t0, t2);                      // t2 = (X-Z)^2
+    LANE(fp2add)(P->X, P->Z, t1);                   // t1 = X+Z
+    LANE(fp2sqr_mont)(t1, t3);                      // t3 = (X+Z)^2
+    LANE(fp2add)(t0, t1, t4);                       // t4 = 2*X
+    LANE(fp2sub)(t1, t0, t0);                       // t0 = 2*Z
+    LANE(fp2sqr_mont)(t4, t1);                      // t1 = 4*X^2
+    LANE(fp2sub)(t1, t3, t1);                       // t1 = 4*X^2 - (X+Z)^2
+    LANE(fp2sub)(t1, t2, t1);                       // t1 = 4*X^2 - (X+Z)^2 - (X-Z)^2
+    LANE(fp2mul_mont)(t3, A24plus, t5);             // t5 = A24plus*(X+Z)^2
+    LANE(fp2mul_mont)(t3, t5, t3);                  // t3 = A24plus*(X+Z)^3
+    LANE(fp2mul_mont)(A24minus, t2, t6);            // t6 = A24minus*(X-Z)^2
+    LANE(fp2mul_mont)(t2, t6, t2);                  // t2 = A24minus*(X-Z)^3
+    LANE(fp2sub)(t2, t3, t3);                       // t3 = A24minus*(X-Z)^3 - coeff*(X+Z)^3
+    LANE(fp2sub)(t5, t6, t2);                       // t2 = A24plus*(X+Z)^2 - A24minus*(X-Z)^2
+    LANE(fp2mul_mont)(t1, t2, t1);                  // t1 = [4*X^2 - (X+Z)^2 - (X-Z)^2]*[A24plus*(X+Z)^2 - A24minus*(X-Z)^2]
+    LANE(fp2add)(t3, t1, t2);                       // t2 = [4*X^2 - (X+Z)^2 - (X-Z)^2]*[A24plus*(X+Z)^2 - A24minus*(X-Z)^2] + A24minus*(X-Z)^3 - coeff*(X+Z)^3
+    LANE(fp2sqr_mont)(t2, t2);                      // t2 = t2^2
+    LANE(fp2mul_mont)(t4, t2, Q->X);                // X3 = 2*X*t2
+    LANE(fp2sub)(t3, t1, t1);                       // t1 = A24minus*(X-Z)^3 - A24plus*(X+Z)^3 - [4*X^2 - (X+Z)^2 - (X-Z)^2]*[A24plus*(X+Z)^2 - A24minus*(X-Z)^2]
+    LANE(fp2sqr_mont)(t1, t1);                      // t1 = t1^2
+    LANE(fp2mul_mont)(t0, t1, Q->Z);                // Z3 = 2*Z*t1
+}
+
+
+static LANE_TARGET void LANE(xTPLe)(const LANE(point_proj_t) P, LANE(point_proj_t) Q, const LANE(f2elm_t) A24minus, const LANE(f2elm_t) A24plus, const int e)
+{ // Computes [3^e](X:Z) via e repeated triplings, as xTPLe()
+    int i;
+
+    LANE(fp2copy)(P->X, Q->X);
+    LANE(fp2copy)(P->Z, Q->Z);
+    for (i = 0; i < e; i++) {
+        LANE(xTPL)(Q, Q, A24minus, A24plus);
+    }
+}
+
+
+static LANE_TARGET void LANE(get_3_isog)(const LANE(point_proj_t) P, LANE(f2elm_t) A24minus, LANE(f2elm_t) A24plus, LANE(f2elm_t)* coeff)
+{ // 3-isogenous curves and evaluation coefficients of points of order 3, as get_3_isog()
+    LANE(f2elm_t) t0, t1, t2, t3, t4;
+
+    LANE(fp2sub)(P->X, P->Z, coeff[0]);             // coeff0 = X-Z
+    LANE(fp2sqr_mont)(coeff[0], t0);                // t0 = (X-Z)^2
+    LANE(fp2add)(P->X, P->Z, coeff[1]);             // coeff1 = X+Z
+    LANE(fp2sqr_mont)(coeff[1], t1);                // t1 = (X+Z)^2
+    LANE(fp2add)(t0, t1, t2);                       // t2 = (X+Z)^2 + (X-Z)^2
+    LANE(fp2add)(coeff[0], coeff[1], t3);           // t3 = 2*X
+    LANE(fp2sqr_mont)(t3, t3);                      // t3 = 4*X^2
+    LANE(fp2sub)(t3, t2, t3);                       // t3 = 4*X^2 - (X+Z)^2 - (X-Z)^2
+    LANE(fp2add)(t1, t3, t2);                       // t2 = 4*X^2 - (X-Z)^2
+    LANE(fp2add)(t3, t0, t3);                       // t3 = 4*X^2 - (X+Z)^2
+    LANE(fp2add)(t0, t3, t4);                       // t4 = 4*X^2 - (X+Z)^2 + (X-Z)^2
+    LANE(fp2add)(t4, t4, t4);                       // t4 = 2(4*X^2 - (X+Z)^2 + (X-Z)^2)
+    LANE(fp2add)(t1, t4, t4);                       // t4 = 8*X^2 - (X+Z)^2 + 2*(X-Z)^2
+    LANE(fp2mul_mont)(t2, t4, A24minus);            // A24minus = [4*X^2 - (X-Z)^2]*[8*X^2 - (X+Z)^2 + 2*(X-Z)^2]
+    LANE(fp2add)(t1, t2, t4);                       // t4 = 4*X^2 + (X+Z)^2 - (X-Z)^2
+    LANE(fp2add)(t4, t4, t4);                       // t4 = 2(4*X^2 + (X+Z)^2 - (X-Z)^2)
+    LANE(fp2add)(t0, t4, t4);                       // t4 = 8*X^2 + 2*(X+Z)^2 - (X-Z)^2
+    LANE(fp2mul_mont)(t3, t4, A24plus);             // A24plus = [4*X^2 - (X+Z)^2]*[8*X^2 + 2*(X+Z)^2 - (X-Z)^2]
+}
+
+
+static LANE_TARGET void LANE(eval_3_isog)(LANE(point_proj_t) Q, const LANE(f2elm_t)* coeff)
+{ // Evaluates the 3-isogenies given by coeff at the points Q, as eval_3_isog()
+    LANE(f2elm_t) t0, t1, t2;
+
+    LANE(fp2add)(Q->X, Q->Z, t0);                   // t0 = X+Z
+    LANE(fp2sub)(Q->X, Q->Z, t1);                   // t1 = X-Z
+    LANE(fp2mul_mont)(t0, coeff[0], t0);            // t0 = coeff0*(X+Z)
+    LANE(fp2mul_mont)(t1, coeff[1], t1);            // t1 = coeff1*(X-Z)
+    LANE(fp2add)(t0, t1, t2);                       // t2 = coeff0*(X+Z) + coeff1*(X-Z)
+    LANE(fp2sub)(t1, t0, t0);                       // t0 = coeff1*(X-Z) - coeff0*(X+Z)
+    LANE(fp2sqr_mont)(t2, t2);                      // t2 = [coeff0*(X+Z) + coeff1*(X-Z)]^2
+    LANE(fp2sqr_mont)(t0, t0);                      // t0 = [coeff1*(X-Z) - coeff0*(X+Z)]^2
+    LANE(fp2mul_mont)(Q->X, t2, Q->X);              // X3final = X*[coeff0*(X+Z) + coeff1*(X-Z)]^2
+    LANE(fp2mul_mont)(Q->Z, t0, Q->Z);              // Z3final = Z*[coeff1*(X-Z) - coeff0*(X+Z)]^2
+}
+
+
+static LANE_TARGET void LANE(xDBLADD)(LANE(point_proj_t) P, LANE(point_proj_t) Q, const LANE(f2elm_t) xPQ, const LANE(f2elm_t) A24plus, const LANE(felm_t) C24)
+{ // Simultaneous doubling and differential addition, as xDBLADD(), with C24 in GF(p434)
+    LANE(f2elm_t) t0, t1, t2;
+
+    LANE(fp2add)(P->X, P->Z, t0);                   // t0 = XP+ZP
+    LANE(fp2sub)(P->X, P->Z, t1);                   // t1 = XP-ZP
+    LANE(fp2sqr_mont)(t0, P->X);                    // XP = (XP+ZP)^2
+    LANE(fp2sub)(Q->X, Q->Z, t2);                   // t2 = XQ-ZQ
+    LANE(fp2add)(Q->X, Q->Z, Q->X);                 // XQ = XQ+ZQ
+    LANE(fp2mul_mont)(t0, t2, t0);                  // t0 = (XP+ZP)*(XQ-ZQ)
+    LANE(fp2sqr_mont)(t1, P->Z);                    // ZP = (XP-ZP)^2
+    LANE(fp2mul_mont)(t1, Q->X, t1);                // t1 = (XP-ZP)*(XQ+ZQ)
+    LANE(fp2sub)(P->X, P->Z, t2);                   // t2 = (XP+ZP)^2-(XP-ZP)^2
+    LANE(fpmul_mont)(P->Z[0], C24, P->Z[0]);
+    LANE(fpmul_mont)(P->Z[1], C24, P->Z[1]);        // ZP = C24*(XP-ZP)^2
+    LANE(fp2mul_mont)(P->X, P->Z, P->X);            // XP = C24*(XP+ZP)^2*(XP-ZP)^2
+    LANE(fp2mul_mont)(t2, A24plus, Q->X);           // XQ = A24plus*[(XP+ZP)^2-(XP-ZP)^2]
+    LANE(fp2sub)(t0, t1, Q->Z);                     // ZQ = (XP+ZP)*(XQ-ZQ)-(XP-ZP)*(XQ+ZQ)
+    LANE(fp2add)(Q->X, P->Z, P->Z);                 // ZP = A24plus*[(XP+ZP)^2-(XP-ZP)^2]+C24*(XP-ZP)^2
+    LANE(fp2add)(t0, t1, Q->X);                     // XQ = (XP+ZP)*(XQ-ZQ)+(XP-ZP)*(XQ+ZQ)
+    LANE(fp2mul_mont)(P->Z, t2, P->Z);              // ZP = [A24plus*[(XP+ZP)^2-(XP-ZP)^2]+C24*(XP-ZP)^2]*[(XP+ZP)^2-(XP-ZP)^2]
+    LANE(fp2sqr_mont)(Q->Z, Q->Z);                  // ZQ = [(XP+ZP)*(XQ-ZQ)-(XP-ZP)*(XQ+ZQ)]^2
+    LANE(fp2sqr_mont)(Q->X, Q->X);                  // XQ = [(XP+ZP)*(XQ-ZQ)+(XP-ZP)*(XQ+ZQ)]^2
+    LANE(fp2mul_mont)(Q->Z, xPQ, Q->Z);             // ZQ = xPQ*[(XP+ZP)*(XQ-ZQ)-(XP-ZP)*(XQ+ZQ)]^2
+}
+
+
+static LANE_TARGET void LANE(swap_points)(LANE(point_proj_t) P, LANE(point_proj_t) Q, const lane_t option)
+{ // Swaps the points of the lanes whose option is 0xFF...FF, keeps those whose option is 0
+    lane_t temp;
+    unsigned int i, j;
+
+    for (j = 0; j < 2; j++) {
+        for (i = 0; i < LANE_LIMBS; i++) {
+            temp = LANE_AND(option, LANE_XOR(P->X[j][i], Q->X[j][i]));
+            P->X[j][i] = LANE_XOR(temp, P->X[j][i]);
+            Q->X[j][i] = LANE_XOR(temp, Q->X[j][i]);
+            temp = LANE_AND(option, LANE_XOR(P->Z[j][i], Q->Z[j][i]));
+            P->Z[j][i] = LANE_XOR(temp, P->Z[j][i]);
+            Q->Z[j][i] = LANE_XOR(temp, Q->Z[j][i]);
+        }
+    }
+}
+
+
+static LANE_TARGET void LANE(LADDER3PT)(const LANE(f2elm_t) xP, const LANE(f2elm_t) xQ, const LANE(f2elm_t) xPQ, const lane_t* m, const unsigned int AliceOrBob, LANE(point_proj_t) R, const LANE(f2elm_t) A24plus, const LANE(felm_t) C24)
+{ // Three-point ladders computing R = x(P+[m]Q), as LADDER3PT(). Word i of the scalar of lane k is the k-th 64-bit word of m[i]
+    LANE(point_proj_t) R0, R2;
+    lane_t bit, swap, prevbit = LANE_ZERO(), one = LANE_ONE();
+    int i, nbits;
+
+    if (AliceOrBob == ALICE) {
+        nbits = OALICE_BITS;
+    } else {
+        nbits = OBOB_BITS - 1;
+    }
+
+    // Initializing points
+    LANE(fp2copy)(xQ, R0->X);
+    LANE(fp2_one)(R0->Z);
+    LANE(fp2copy)(xPQ, R2->X);
+    LANE(fp2_one)(R2->Z);
+    LANE(fp2copy)(xP, R->X);
+    LANE(fp2_one)(R->Z);
+
+    // Main loop
+    for (i = 0; i < nbits; i++) {
+        bit = LANE_AND(LANE_SRLI(m[i >> 6], (unsigned int)(i & 63)), one);
+        swap = LANE_XOR(bit, prevbit);
+        prevbit = bit;
+
+        LANE(swap_points)(R, R2, LANE_SUB(LANE_ZERO(), swap));
+        LANE(xDBLADD)(R0, R2, R->X, A24plus, C24);
+        LANE(fp2mul_mont)(R2->X, R->Z, R2->X);
+    }
+    LANE(swap_points)(R, R2, LANE_SUB(LANE_ZERO(), prevbit));
+}
+
+
+static LANE_TARGET void LANE(load_keys)(const unsigned char* const* PrivateKey, const unsigned int nbytes, const unsigned int n, lane_t* m)
+{ // Word i of the scalar of lane k <- word i of the private key PrivateKey[k], lanes k >= n repeat lane 0
+    digit_t SecretKey[LANES][NWORDS_ORDER], u[LANES];
+    unsigned int i, k;
+
+    for (k = 0; k < LANES; k++) {
+        decode_to_digits(PrivateKey[(k < n) ? k : 0], SecretKey[k], nbytes, NWORDS_ORDER);
+    }
+    for (i = 0; i < NWORDS_ORDER; i++) {
+        for (k = 0; k < LANES; k++) {
+            u[k] = SecretKey[k][i];
+        }
+        memcpy(&m[i], u, sizeof(u));
+    }
+    clear_words((void*)SecretKey, LANES*NWORDS_ORDER);
+    clear_words((void*)u, LANES);
+}
+
+
+static LANE_TARGET void LANE(traverse_A)(const unsigned int* strat, LANE(point_proj_t) R, LANE(f2elm_t) A24plus, LANE(f2elm_t) C24, LANE(point_proj_t)* phi, const unsigned int nphi)
+{ // Alice's tree traversal as in KeyGeneration_A and SecretAgreement_A, evaluating the isogenies at phi[0..nphi-1]
+    LANE(point_proj_t) pts[MAX_INT_POINTS_ALICE];
+    LANE(f2elm_t) coeff[3];
+    unsigned int i, j, row, m, index = 0, pts_index[MAX_INT_POINTS_ALICE], npts = 0, ii = 0;
+
+#if (OALICE_BITS % 2 == 1)
+    LANE(point_proj_t) S;
+
+    LANE(xDBLe)(R, S, A24plus, C24, (int)(OALICE_BITS-1));
+    LANE(get_2_isog)(S, A24plus, C24);
+    for (j = 0; j < nphi; j++) {
+        LANE(eval_2_isog)(phi[j], S);
+    }
+    LANE(eval_2_isog)(R, S);
+#endif
+
+    for (row = 1; row < MAX_Alice; row++) {
+        while (index < MAX_Alice-row) {
+            LANE(fp2copy)(R->X, pts[npts]->X);
+            LANE(fp2copy)(R->Z, pts[npts]->Z);
+            pts_index[npts++] = index;
+            m = strat[ii++];
+            LANE(xDBLe)(R, R, A24plus, C24, (int)(2*m));
+            index += m;
+        }
+        LANE(get_4_isog)(R, A24plus, C24, coeff);
+
+        for (i = 0; i < npts; i++) {
+            LANE(eval_4_isog)(pts[i], (const LANE(f2elm_t)*)coeff);
+        }
+        for (j = 0; j < nphi; j++) {
+            LANE(eval_4_isog)(phi[j], (const LANE(f2elm_t)*)coeff);
+        }
+
+        LANE(fp2copy)(pts[npts-1]->X, R->X);
+        LANE(fp2copy)(pts[npts-1]->Z, R->Z);
+        index = pts_index[npts-1];
+        npts -= 1;
+    }
+
+    LANE(get_4_isog)(R, A24plus, C24, coeff);
+    for (j = 0; j < nphi; j++) {
+        LANE(eval_4_isog)(phi[j], (const LANE(f2elm_t)*)coeff);
+    }
+}
+
+
+static LANE_TARGET void LANE(traverse_B)(const unsigned int* strat, LANE(point_proj_t) R, LANE(f2elm_t) A24minus, LANE(f2elm_t) A24plus, LANE(point_proj_t)* phi, const unsigned int nphi)
+{ // Bob's tree traversal as in KeyGeneration_B and SecretAgreement_B, evaluating the isogenies at phi[0..nphi-1]
+    LANE(point_proj_t) pts[MAX_INT_POINTS_BOB];
+    LANE(f2elm_t) coeff[3];
+    unsigned int i, j, row, m, index = 0, pts_index[MAX_INT_POINTS_BOB], npts = 0, ii = 0;
+
+    for (row = 1; row < MAX_Bob; row++) {
+        while (index < MAX_Bob-row) {
+            LANE(fp2copy)(R->X, pts[npts]->X);
+            LANE(fp2copy)(R->Z, pts[npts]->Z);
+            pts_index[npts++] = index;
+            m = strat[ii++];
+            LANE(xTPLe)(R, R, A24minus, A24plus, (int)m);
+            index += m;
+        }
+        LANE(get_3_isog)(R, A24minus, A24plus, coeff);
+
+        for (i = 0; i < npts; i++) {
+            LANE(eval_3_isog)(pts[i], (const LANE(f2elm_t)*)coeff);
+        }
+        for (j = 0; j < nphi; j++) {
+            LANE(eval_3_isog)(phi[j], (const LANE(f2elm_t)*)coeff);
+        }
+
+        LANE(fp2copy)(pts[npts-1]->X, R->X);
+        LANE(fp2copy)(pts[npts-1]->Z, R->Z);
+        index = pts_index[npts-1];
+        npts -= 1;
+    }
+
+    LANE(get_3_isog)(R, A24minus, A24plus, coeff);
+    for (j = 0; j < nphi; j++) {
+        LANE(eval_3_isog)(phi[j], (const LANE(f2elm_t)*)coeff);
+    }
+}
+
+
+static LANE_TARGET void LANE(KeyGeneration)(const unsigned int alice, const unsigned char* const* PrivateKey, point_proj_t* phi, const unsigned int n)
+{ // Public key generation of n <= LANES private keys up to the normalization, as KeyGeneration_A/B
+    LANE(point_proj_t) R, vphi[3];
+    LANE(f2elm_t) vx[3], A24plus, C24;
+    LANE(felm_t) C24fp;
+    lane_t SecretKey[NWORDS_ORDER];
+    f2elm_t XP[3], Xphi[3], A24 = {0}, C = {0};
+    felm_t* out[LANES];
+    unsigned int j, k;
+
+    // Initialize basis points and constants: A24plus = A+2C = 8, C24 = 4C = 4, where A=6, C=1. Bob's A24minus = A-2C is also 4
+    TRACE_BEGIN("init");
+    init_basis((digit_t*)(alice ? A_gen : B_gen), XP[0], XP[1], XP[2]);
+    init_basis((digit_t*)(alice ? B_gen : A_gen), Xphi[0], Xphi[1], Xphi[2]);
+    fpcopy((digit_t*)&Montgomery_one, A24[0]);
+    fp2add(A24, A24, A24);
+    fp2add(A24, A24, C);
+    fp2add(C, C, A24);
+    for (j = 0; j < 3; j++) {
+        LANE(fp2_set)(vx[j], XP[j]);
+        LANE(fp2_set)(vphi[j]->X, Xphi[j]);
+        LANE(fp2_one)(vphi[j]->Z);
+    }
+    LANE(fp2_set)(A24plus, A24);
+    LANE(fp2_set)(C24, C);
+    LANE(fpcopy)(C24[0], C24fp);
+    TRACE_END("init");
+
+    // Retrieve kernel points
+    TRACE_BEGIN("ladder");
+    LANE(load_keys)(PrivateKey, alice ? SECRETKEY_A_BYTES : SECRETKEY_B_BYTES, n, SecretKey);
+    LANE(LADDER3PT)(vx[0], vx[1], vx[2], SecretKey, alice ? ALICE : BOB, R, A24plus, C24fp);
+    clear_words((void*)SecretKey, NWORDS_ORDER*LANES);
+    TRACE_END("ladder");
+
+    TRACE_BEGIN("tree");
+    if (alice) {
+        LANE(traverse_A)(strategies[STRATEGY_KEYGEN_A]->table, R, A24plus, C24, vphi, 3);
+    } else {
+        LANE(traverse_B)(strategies[STRATEGY_KEYGEN_B]->table, R, C24, A24plus, vphi, 3);
+    }
+    for (j = 0; j < 3; j++) {
+        for (k = 0; k < n; k++) {
+            out[k] = phi[3*k+j]->X;
+        }
+        LANE(fp2_store)(vphi[j]->X, out, n);
+        for (k = 0; k < n; k++) {
+            out[k] = phi[3*k+j]->Z;
+        }
+        LANE(fp2_store)(vphi[j]->Z, out, n);
+    }
+    TRACE_END("tree");
+}
+
+
+static LANE_TARGET void LANE(SecretAgreement)(const unsigned int alice, const unsigned char* const* PrivateKey, const unsigned char* const* PublicKey, f2elm_t* jA, f2elm_t* jC, const unsigned int n)
+{ // Shared secret computation of n <= LANES key pairs up to the normalization, as SecretAgreement_A/B
+    LANE(point_proj_t) R;
+    LANE(f2elm_t) vx[3], A24plus, A24minus, C24;
+    lane_t SecretKey[NWORDS_ORDER];
+    f2elm_t PK[LANES][3], Ap[LANES], Am[LANES], C4[LANES], A, C;
+    const felm_t* in[LANES];
+    felm_t* out[LANES];
+    unsigned int j, k;
+
+    // Initialize images of the other party's basis and, per lane as in the single functions, the constants
+    // A24plus = A+2C, A24minus = A-2C (Alice: C24 = 4C in GF(p^2)) and C24 = 4C in GF(p), where C is in GF(p)
+    TRACE_BEGIN("init");
+    for (k = 0; k < LANES; k++) {
+        const unsigned char* pk = PublicKey[(k < n) ? k : 0];
+        fp2_decode(pk, PK[k][0]);
+        fp2_decode(pk + FP2_ENCODED_BYTES, PK[k][1]);
+        fp2_decode(pk + 2*FP2_ENCODED_BYTES, PK[k][2]);
+        get_A_proj(PK[k][0], PK[k][1], PK[k][2], A, C);
+        fp2add(C, C, Am[k]);
+        fp2add(A, Am[k], Ap[k]);
+        fpzero(C4[k][1]);
+        if (alice) {
+            fp2add(Am[k], Am[k], Am[k]);
+            fpcopy(Am[k][0], C4[k][0]);
+        } else {
+            fp2sub(A, Am[k], Am[k]);
+            fpadd(C[0], C[0], C4[k][0]);
+            fpadd(C4[k][0], C4[k][0], C4[k][0]);
+        }
+    }
+    for (j = 0; j < 3; j++) {
+        for (k = 0; k < LANES; k++) {
+            in[k] = PK[k][j];
+        }
+        LANE(fp2_load)(vx[j], in);
+    }
+    for (k = 0; k < LANES; k++) {
+        in[k] = Ap[k];
+    }
+    LANE(fp2_load)(A24plus, in);
+    for (k = 0; k < LANES; k++) {
+        in[k] = Am[k];
+    }
+    LANE(fp2_load)(A24minus, in);
+    for (k = 0; k < LANES; k++) {
+        in[k] = C4[k];
+    }
+    LANE(fp2_load)(C24, in);
+    TRACE_END("init");
+
+    // Retrieve kernel points
+    TRACE_BEGIN("ladder");
+    LANE(load_keys)(PrivateKey, alice ? SECRETKEY_A_BYTES : SECRETKEY_B_BYTES, n, SecretKey);
+    LANE(LADDER3PT)(vx[0], vx[1], vx[2], SecretKey, alice ? ALICE : BOB, R, A24plus, C24[0]);
+    clear_words((void*)SecretKey, NWORDS_ORDER*LANES);
+    TRACE_END("ladder");
+
+    TRACE_BEGIN("tree");
+    if (alice) {                                    // Alice's A24minus holds C24 = 4C
+        LANE(traverse_A)(strategies[STRATEGY_AGREEMENT_A]->table, R, A24plus, A24minus, NULL, 0);
+        LANE(fp2add)(A24plus, A24plus, A24plus);
+        LANE(fp2sub)(A24plus, A24minus, A24plus);
+        LANE(fp2add)(A24plus, A24plus, vx[0]);      // jA = 2*(2*A24plus - C24)
+        LANE(fp2copy)(A24minus, vx[1]);             // jC = C24
+    } else {
+        LANE(traverse_B)(strategies[STRATEGY_AGREEMENT_B]->table, R, A24minus, A24plus, NULL, 0);
+        LANE(fp2add)(A24plus, A24minus, vx[2]);
+        LANE(fp2add)(vx[2], vx[2], vx[0]);          // jA = 2*(A24plus + A24minus)
+        LANE(fp2sub)(A24plus, A24minus, vx[1]);     // jC = A24plus - A24minus
+    }
+    for (k = 0; k < n; k++) {
+        out[k] = jA[k];
+    }
+    LANE(fp2_store)(vx[0], out, n);
+    for (k = 0; k < n; k++) {
+        out[k] = jC[k];
+    }
+    LANE(fp2_store)(vx[1], out, n);
+    TRACE_END("tree");
+}
+
+
+void LANE_API(KeyGeneration)(const unsigned int alice, const unsigned char* const* PrivateKey, point_proj_t* phi, const unsigned int n)
+{ // Public key generation of n private keys up to the normalization, LANES at a time
+    unsigned int i, nl;
+
+    for (i = 0; i < n; i += nl) {
+        nl = (n - i < LANES) ? n - i : LANES;
+        LANE(KeyGeneration)(alice, &PrivateKey[i], &phi[3*i], nl);
+    }
+}
+
+
+void LANE_API(SecretAgreement)(const unsigned int alice, const unsigned char* const* PrivateKey, const unsigned char* const* PublicKey, f2elm_t* jA, f2elm_t* jC, const unsigned int n)
+{ // Shared secret computation of n key pairs up to the normalization, LANES at a time
+    unsigned int i, nl;
+
+    for (i = 0; i < n; i += nl) {
+        nl = (n - i < LANES) ? n - i : LANES;
+        LANE(SecretAgreement)(alice, &PrivateKey[i], &PublicKey[i], &jA[i], &jC[i], nl);
+    }
+}
+
+#undef LANE
+#undef LANE_API
+#undef LANE_TARGET
+#undef LANES
+#undef LANE_LIMBS
+#undef lane_t
+#undef LANE_ZERO
+#undef LANE_ONE
+#undef LANE_AND
+#undef LANE_XOR
+#undef LANE_SUB
+#undef LANE_SRLI
@@ -63,6 +63,10 @@ const uint64_t Montgomery_one[NWORDS64_FIELD]    = { 0x000000000000742C, 0x00000
                                                      0xD801A4FB559FACD4, 0xE93254545F77410C, 0x0000ECEEA7BD2EDA };
 
 
+// Precomputed multiples of the generators QA and QB for the fixed-base ladders
+#include "P434_tables.h"
+
+
 // Fixed parameters for isogeny tree computation
 const unsigned int strat_Alice[MAX_Alice-1] = { 
 48, 28, 16, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 13, 7, 4, 2, 1, 1, 2, 1, 1, 3, 2, 1, 1, 
@@ -74,6 +78,11 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 32, 16, 8, 4, 3, 1, 1, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 
 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 16, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1 };
            
+#if defined(THREADS)
+// Strategies of the overlapped traversal of the host thread pool
+#include "P434_strategies.h"
+#endif
+
 // Setting up macro defines and including GF(p), GF(p^2), curve, isogeny and kex functions
 #define fpcopy                        fpcopy434
 #define fpzero                        fpzero434
@@ -98,6 +107,52 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define fp2sqr_mont                   fp2sqr434_mont
 #define fp2inv_mont                   fp2inv434_mont
 #define fp2inv_mont_bingcd            fp2inv434_mont_bingcd
+#define op_count                      op_count434
+#define op_count_phase                op_count_phase434
+#define op_count_snapshot             op_count_snapshot434
+#define op_count_reset                op_count_reset434
+#define strategy_check                strategy_check434
+#define strategy_set                  strategy_set434
+#define strategy_get                  strategy_get434
+#define pool_start                    pool_start434
+#define pool_stop                     pool_stop434
+#define pool_begin                    pool_begin434
+#define pool_submit                   pool_submit434
+#define pool_join                     pool_join434
+#define pool_call                     pool_call434
+#define pool_end                      pool_end434
+#define ifma_available                ifma_available434
+#define KeyGeneration_ifma            KeyGeneration_ifma434
+#define SecretAgreement_ifma          SecretAgreement_ifma434
+#define avx2_available                avx2_available434
+#define KeyGeneration_avx2            KeyGeneration_avx2434
+#define SecretAgreement_avx2          SecretAgreement_avx2434
+#define keypool_config                keypool_config434
+#define keypool_take                  keypool_take434
+#define keypool_refill                keypool_refill434
+#define keypool_size                  keypool_size434
+#define keypool_flush                 keypool_flush434
+#define keypool_start                 keypool_start434
+#define keypool_stop                  keypool_stop434
+#define kemsvc_start                  kemsvc_start434
+#define kemsvc_stop                   kemsvc_stop434
+#define kemsvc_submit                 kemsvc_submit434
+#define kemsvc_drain                  kemsvc_drain434
+#define kemsvc_stats                  kemsvc_stats434
+#define ladder_cache_config           ladder_cache_config434
+#define ladder_cache_flush            ladder_cache_flush434
+#define ladder_cache_stats            ladder_cache_stats434
+#define ladder_cache_acquire          ladder_cache_acquire434
+#define ladder_cache_release          ladder_cache_release434
+#define fixed_base_tables             fixed_base_tables434
+#define table_file_load               table_file_load434
+#define trace_set_clock               trace_set_clock434
+#define trace_record                  trace_record434
+#define trace_reset                   trace_reset434
+#define trace_export_json             trace_export_json434
+#define trace_clock_dwt               trace_clock_dwt434
+#define trace_clock_rdtsc             trace_clock_rdtsc434
+#define trace_clock_gettime           trace_clock_gettime434
 #define fpequal_non_constant_time     fpequal434_non_constant_time
 #define mp_add_asm                    mp_add434_asm
 #define mp_subx2_asm                  mp_sub434x2_asm
@@ -107,3 +162,14 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #include "ec_isogeny.c"
 #include "sidh.c"
 #include "sike.c"
+#include "trace.c"
+#include "pool.c"
+#include "keypool.c"
+#include "kemsvc.c"
+#include "compression.c"
+#include "laddercache.c"
+#include "tablefile.c"
+#include "AMD64/fp_ifma.c"
+#include "AMD64/sidh_ifma.c"
+#include "AMD64/fp_avx2.c"
+#include "AMD64/sidh_avx2.c"
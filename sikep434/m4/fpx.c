@@ -488,88 +488,94 @@ void copy_words(const digit_t* a, digit_t* c, const unsigned int nwords)
 
 
 
+// Multiplication rounds of fpmul_mont: the product of the operands at R0 and R1, also saved at
+// [SP+4*28] and [SP+4*29], is written to the 2*NWORDS_FIELD words at [SP]
+#define P_MUL_ROUNDS \
+/*ROUND#1 */                                              \
+STRFY(P_LOAD2(R0, P_OP_A0, P_OP_A1, 12))                  \
+STRFY(P_LOAD(R1, P_OP_B0, P_OP_B1, P_OP_B2, P_OP_B3, 0))  \
+STRFY(P_MUL_TOP(SP, 12))                                  \
+/*ROUND#2 */                                              \
+STRFY(P_LOAD(R0, P_OP_A0, P_OP_A1, P_OP_A2, P_OP_A3, 8))  \
+STRFY(P_MUL_FRONT(SP, 8))                                 \
+"LDR R0, [SP, #4 * 29] \n\t"                              \
+STRFY(P_MUL_MID_OP_B_SHORT(SP, 12, R0, 4))                \
+"LDR R0, [SP, #4 * 28] \n\t"                              \
+STRFY(P_MUL_MID_OP_A_SHORT(SP, 14, R0, 12))               \
+STRFY(P_MUL_BACK2(SP, 16))                                \
+/*ROUND#3 */                                              \
+"LDR R0, [SP, #4 * 28] \n\t" /* OP_A */                   \
+"LDR R1, [SP, #4 * 29] \n\t" /* OP_B */                   \
+STRFY(P_LOAD(R0, P_OP_A0, P_OP_A1, P_OP_A2, P_OP_A3, 4))  \
+STRFY(P_LOAD2(R1, P_OP_B0, P_OP_B1, 0))                   \
+STRFY(P_MUL_FRONT(SP, 4))                                 \
+"LDR R0, [SP, #4 * 29] \n\t"                              \
+STRFY(P_MUL_MID_OP_B(SP, 8, R0, 4))                       \
+STRFY(P_MUL_MID_OP_B_SHORT(SP, 12, R0, 8))                \
+"LDR R0, [SP, #4 * 28] \n\t"                              \
+STRFY(P_MUL_MID_OP_A_SHORT(SP, 14, R0, 8))                \
+STRFY(P_MUL_MID_OP_A2(SP, 16, R0, 10))                    \
+STRFY(P_MUL_BACK2(SP, 20))                                \
+/*ROUND#4 */                                              \
+"LDR R0, [SP, #4 * 28] \n\t" /* OP_A */                   \
+"LDR R1, [SP, #4 * 29] \n\t" /* OP_B */                   \
+STRFY(P_LOAD(R0, P_OP_A0, P_OP_A1, P_OP_A2, P_OP_A3, 0))  \
+STRFY(P_LOAD(R1, P_OP_B0, P_OP_B1, P_OP_B2, P_OP_B3, 0))  \
+STRFY(P_MUL_FRONT(SP, 0))                                 \
+"LDR R0, [SP, #4 * 29] \n\t"                              \
+STRFY(P_MUL_MID_OP_B(SP, 4, R0, 4))                       \
+STRFY(P_MUL_MID_OP_B(SP, 8, R0, 8))                       \
+STRFY(P_MUL_MID_OP_B_SHORT(SP, 12, R0, 12))               \
+"LDR R0, [SP, #4 * 28] \n\t"                              \
+STRFY(P_MUL_MID_OP_A_SHORT(SP, 14, R0, 4))                \
+STRFY(P_MUL_MID_OP_A2(SP, 16, R0, 6))                     \
+STRFY(P_MUL_MID_OP_A2(SP, 20, R0, 10))                    \
+STRFY(P_MUL_BACK2(SP, 24))
+
+
+// Montgomery reduction rounds of fpmul_mont: the 2*NWORDS_FIELD words at [SP] are reduced in place
+// and the result is written to the pointer saved at [SP+4*30]
+#define P_RDC_ROUNDS \
+/*TEST */                                                   \
+"MOV R1, #0			   \n\t" /* CARRY */                          \
+"ADDS R1, R1, R1	\n\t"                                      \
+"LDR R0, [SP, #4 * 30] \n\t" /* RESULT POINTER */           \
+/*ROUND#1 */                                                \
+STRFY(P_LOAD_M)                                             \
+STRFY(P_LOAD_Q(SP, P_OP_Q0, P_OP_Q1, P_OP_Q2, P_OP_Q3, 0))  \
+STRFY(P_RED_FRONT(SP, SP, 6, 6))                            \
+STRFY(P_RED_MID(SP, 10))                                    \
+/*ROUND#2 */                                                \
+STRFY(P_LOAD_M)                                             \
+STRFY(P_LOAD_Q(SP, P_OP_Q0, P_OP_Q1, P_OP_Q2, P_OP_Q3, 4))  \
+STRFY(P_RED_FRONT(SP, SP, 10, 10))                          \
+STRFY(P_RED_MID(SP, 14))                                    \
+/*ROUND#3 */                                                \
+STRFY(P_LOAD_M)                                             \
+STRFY(P_LOAD_Q(SP, P_OP_Q0, P_OP_Q1, P_OP_Q2, P_OP_Q3, 8))  \
+"LDR R0, [SP, #4 * 30] \n\t" /* RESULT */                   \
+STRFY(P_RED_FRONT(R0, SP, 0, 14))                           \
+/*STRFY(RED_MID2(R0, SP, 4, 18)) */                         \
+STRFY(P_RED_MID(SP, 18))                                    \
+/*ROUND#4 */                                                \
+STRFY(P_LOAD_M2)                                            \
+STRFY(P_LOAD_Q2(SP, P_OP_Q0, P_OP_Q1, 12))                  \
+"LDR R0, [SP, #4 * 30] \n\t" /* RESULT */                   \
+STRFY(P_RED_FRONT2(R0, SP, 4, 18))                          \
+STRFY(P_RED_MID3(R0, SP, 6,  20))
+
+
+#if (TARGET == TARGET_ARM)
+
 void __attribute__ ((noinline, naked)) fpmul_mont(const felm_t ma, const felm_t mb, felm_t mc)
 { // Multiprecision multiplication, c = a*b mod p.
     //dfelm_t temp = {0};
 asm volatile(\
+OP_COUNT_ASM(OP_FPMUL)
 STRFY(P_MUL_PROLOG)
 "SUB SP, #4*28 			\n\t"
-
-//ROUND#1
-STRFY(P_LOAD2(R0, P_OP_A0, P_OP_A1, 12))
-STRFY(P_LOAD(R1, P_OP_B0, P_OP_B1, P_OP_B2, P_OP_B3, 0))
-STRFY(P_MUL_TOP(SP, 12))
-
-//ROUND#2
-STRFY(P_LOAD(R0, P_OP_A0, P_OP_A1, P_OP_A2, P_OP_A3, 8))
-STRFY(P_MUL_FRONT(SP, 8))
-"LDR R0, [SP, #4 * 29] \n\t"
-STRFY(P_MUL_MID_OP_B_SHORT(SP, 12, R0, 4))
-"LDR R0, [SP, #4 * 28] \n\t"
-STRFY(P_MUL_MID_OP_A_SHORT(SP, 14, R0, 12))
-STRFY(P_MUL_BACK2(SP, 16))  
-
-//ROUND#3
-"LDR R0, [SP, #4 * 28] \n\t"// OP_A
-"LDR R1, [SP, #4 * 29] \n\t"// OP_B
-STRFY(P_LOAD(R0, P_OP_A0, P_OP_A1, P_OP_A2, P_OP_A3, 4))
-STRFY(P_LOAD2(R1, P_OP_B0, P_OP_B1, 0))
-STRFY(P_MUL_FRONT(SP, 4))
-"LDR R0, [SP, #4 * 29] \n\t"
-STRFY(P_MUL_MID_OP_B(SP, 8, R0, 4))
-STRFY(P_MUL_MID_OP_B_SHORT(SP, 12, R0, 8))
-"LDR R0, [SP, #4 * 28] \n\t"
-STRFY(P_MUL_MID_OP_A_SHORT(SP, 14, R0, 8))
-STRFY(P_MUL_MID_OP_A2(SP, 16, R0, 10))
-STRFY(P_MUL_BACK2(SP, 20)) 
-
-//ROUND#4
-"LDR R0, [SP, #4 * 28] \n\t"// OP_A
-"LDR R1, [SP, #4 * 29] \n\t"// OP_B
-STRFY(P_LOAD(R0, P_OP_A0, P_OP_A1, P_OP_A2, P_OP_A3, 0))
-STRFY(P_LOAD(R1, P_OP_B0, P_OP_B1, P_OP_B2, P_OP_B3, 0))
-STRFY(P_MUL_FRONT(SP, 0))
-"LDR R0, [SP, #4 * 29] \n\t"
-STRFY(P_MUL_MID_OP_B(SP, 4, R0, 4))
-STRFY(P_MUL_MID_OP_B(SP, 8, R0, 8))
-STRFY(P_MUL_MID_OP_B_SHORT(SP, 12, R0, 12))
-"LDR R0, [SP, #4 * 28] \n\t"
-STRFY(P_MUL_MID_OP_A_SHORT(SP, 14, R0, 4))
-STRFY(P_MUL_MID_OP_A2(SP, 16, R0, 6))
-STRFY(P_MUL_MID_OP_A2(SP, 20, R0, 10))
-STRFY(P_MUL_BACK2(SP, 24)) 
-
-//TEST
-"MOV R1, #0			   \n\t"//CARRY
-"ADDS R1, R1, R1	\n\t"
-"LDR R0, [SP, #4 * 30] \n\t"//RESULT POINTER
-
-//ROUND#1
-STRFY(P_LOAD_M)
-STRFY(P_LOAD_Q(SP, P_OP_Q0, P_OP_Q1, P_OP_Q2, P_OP_Q3, 0))
-STRFY(P_RED_FRONT(SP, SP, 6, 6))
-STRFY(P_RED_MID(SP, 10))
-
-//ROUND#2
-STRFY(P_LOAD_M)
-STRFY(P_LOAD_Q(SP, P_OP_Q0, P_OP_Q1, P_OP_Q2, P_OP_Q3, 4))
-STRFY(P_RED_FRONT(SP, SP, 10, 10))
-STRFY(P_RED_MID(SP, 14))
-
-//ROUND#3
-STRFY(P_LOAD_M)
-STRFY(P_LOAD_Q(SP, P_OP_Q0, P_OP_Q1, P_OP_Q2, P_OP_Q3, 8))
-"LDR R0, [SP, #4 * 30] \n\t"// RESULT
-STRFY(P_RED_FRONT(R0, SP, 0, 14))
-//STRFY(RED_MID2(R0, SP, 4, 18))
-STRFY(P_RED_MID(SP, 18))
-
-//ROUND#4
-STRFY(P_LOAD_M2)
-STRFY(P_LOAD_Q2(SP, P_OP_Q0, P_OP_Q1, 12))
-"LDR R0, [SP, #4 * 30] \n\t"// RESULT
-STRFY(P_RED_FRONT2(R0, SP, 4, 18))
-STRFY(P_RED_MID3(R0, SP, 6,  20))
+P_MUL_ROUNDS
+P_RDC_ROUNDS
 
 "ADD SP, #4*31 		   \n\t"
 STRFY(P_MUL_EPILOG)
@@ -579,6 +585,19 @@ STRFY(P_MUL_EPILOG)
 );
 }
 
+#else
+
+void fpmul_mont(const felm_t ma, const felm_t mb, felm_t mc)
+{ // Multiprecision multiplication, c = a*b mod p.
+    dfelm_t temp = {0};
+
+    OP_COUNT_INC(OP_FPMUL);
+    mp_mul(ma, mb, temp, NWORDS_FIELD);
+    rdc_mont(temp, mc);
+}
+
+#endif
+
 
 //SQR
 #define S_TMP  R1
@@ -1107,9 +1126,12 @@ STRFY(P_MUL_EPILOG)
     UMAAL SP_TMP, SP_RST1, SP_OP_Q0, SP_OP_M1         EOL\
     STR SP_TMP, [R_OUT, CV(4*OFFSET + 4)]    EOL\
 
+#if (TARGET == TARGET_ARM)
+
 void __attribute__ ((noinline, naked)) fpsqr_mont(const felm_t ma, felm_t mc)
 { // Multiprecision squaring, c = a^2 mod p.
 asm volatile(\
+OP_COUNT_ASM(OP_FPSQR)
 STRFY(SQR_PROLOG)
 "SUB SP, #4*42 		\n\t"//32 result + 16 operands
 
@@ -1172,10 +1194,28 @@ STRFY(SQR_EPILOG)
 );
 }
 
+#else
+
+void fpsqr_mont(const felm_t ma, felm_t mc)
+{ // Multiprecision squaring, c = a^2 mod p.
+    dfelm_t temp = {0};
+
+    OP_COUNT_INC(OP_FPSQR);
+    mp_mul(ma, ma, temp, NWORDS_FIELD);
+    rdc_mont(temp, mc);
+}
+
+#endif
+
 
 void fpinv_mont(felm_t a)
 { // Field inversion using Montgomery arithmetic, a = a^(-1)*R mod p.
+#if defined(FP_INV_CHAIN)
+    OP_COUNT_INC(OP_FPINV);
     fpinv_chain_mont(a);
+#else
+    fpinv_mont_bingcd(a);
+#endif
 }
 
 
@@ -1228,6 +1268,8 @@ void fp2correction(f2elm_t a)
 }
 
 
+#if (TARGET == TARGET_ARM)
+
 void __attribute__ ((noinline, naked))  mp_addfast(const digit_t* a, const digit_t* b, digit_t* c)
 { // Multiprecision addition, c = a+b.
     asm(
@@ -1282,6 +1324,16 @@ void __attribute__ ((noinline, naked))  mp_addfast(const digit_t* a, const digit
 
 }
 
+#else
+
+void mp_addfast(const digit_t* a, const digit_t* b, digit_t* c)
+{ // Multiprecision addition, c = a+b.
+
+    mp_add_asm(a, b, c);
+}
+
+#endif
+
 
 __inline static void mp_addfastx2(const digit_t* a, const digit_t* b, digit_t* c)
 { // Double-length multiprecision addition, c = a+b.    
@@ -1317,35 +1369,515 @@ __inline unsigned int mp_sub(const digit_t* a, const digit_t* b, digit_t* c, con
 
 
 __inline static digit_t mp_subfast(const digit_t* a, const digit_t* b, digit_t* c)
-{ // Multiprecision subtraction, c = a-b, where lng(a) = lng(b) = 2*NWORDS_FIELD. 
-  // If c < 0 then returns mask = 0xFF..F, else mask = 0x00..0 
+{ // Multiprecision subtraction, c = a-b, where lng(a) = lng(b) = 2*NWORDS_FIELD.
+  // If c < 0 then returns mask = 0xFF..F, else mask = 0x00..0
+#if (TARGET == TARGET_AMD64)
+
+    return mp_subx2_asm(a, b, c);
+
+#else
+
+    return (0 - (digit_t)mp_sub(a, b, c, 2*NWORDS_FIELD));
+
+#endif
+}
+
+
+__inline static void mp_dblsubfast(const digit_t* a, const digit_t* b, digit_t* c)
+{ // Multiprecision subtraction, c = c-a-b, where lng(a) = lng(b) = 2*NWORDS_FIELD.
+  // Inputs should be s.t. c > a and c > b
+#if (TARGET == TARGET_AMD64)
+
+    mp_dblsubx2_asm(a, b, c);
+
+#else
+
+    mp_sub(c, a, c, 2*NWORDS_FIELD);
+    mp_sub(c, b, c, 2*NWORDS_FIELD);
 
-	return (0 - (digit_t)mp_sub(a, b, c, 2*NWORDS_FIELD));
+#endif
 }
 
+// Chunked multiprecision addition/subtraction, c [R2] = a [R0] OP b [R1], where the carry
+// (resp. borrow) flag is chained through consecutive chunks
+#define P_LAZY4(OP0, OP) \
+    LDMIA R0!, {R3-R6}                      EOL\
+    LDMIA R1!, {R7-R10}                     EOL\
+    OP0 R3, R3, R7                          EOL\
+    OP R4, R4, R8                           EOL\
+    OP R5, R5, R9                           EOL\
+    OP R6, R6, R10                          EOL\
+    STMIA R2!, {R3-R6}                      EOL\
+
+#define P_LAZY2(OP0, OP) \
+    LDMIA R0!, {R3-R4}                      EOL\
+    LDMIA R1!, {R7-R8}                      EOL\
+    OP0 R3, R3, R7                          EOL\
+    OP R4, R4, R8                           EOL\
+    STMIA R2!, {R3-R4}                      EOL\
+
+// c [R2] = a [R0] + b [R1], NWORDS_FIELD words
+#define P_ADD_FIELD \
+    P_LAZY4(ADDS, ADCS) \
+    P_LAZY4(ADCS, ADCS) \
+    P_LAZY4(ADCS, ADCS) \
+    P_LAZY2(ADCS, ADCS)
+
+// c [R2] = a [R0] - b [R1], 2*NWORDS_FIELD words. The final borrow is left in the carry flag
+#define P_SUB_DOUBLE \
+    P_LAZY4(SUBS, SBCS) \
+    P_LAZY4(SBCS, SBCS) \
+    P_LAZY4(SBCS, SBCS) \
+    P_LAZY4(SBCS, SBCS) \
+    P_LAZY4(SBCS, SBCS) \
+    P_LAZY4(SBCS, SBCS) \
+    P_LAZY4(SBCS, SBCS)
+
+// [R0] = [R0] + (p434 & mask [R11]), NWORDS_FIELD words
+#define P_ADD_PRIME_MASKED \
+    LDMIA R0, {R3-R6}                       EOL\
+    ADDS R3, R3, R11                        EOL\
+    ADCS R4, R4, R11                        EOL\
+    ADCS R5, R5, R11                        EOL\
+    ADCS R6, R6, R11                        EOL\
+    STMIA R0!, {R3-R6}                      EOL\
+    LDMIA R0, {R3-R6}                       EOL\
+    ADCS R3, R3, R11                        EOL\
+    ADCS R4, R4, R11                        EOL\
+    MOVW R7, #0xFFFF                        EOL\
+    MOVT R7, #0xE2FF                        EOL\
+    AND R7, R7, R11                         EOL\
+    ADCS R5, R5, R7                         EOL\
+    MOVW R7, #0x767A                        EOL\
+    MOVT R7, #0xFDC1                        EOL\
+    AND R7, R7, R11                         EOL\
+    ADCS R6, R6, R7                         EOL\
+    STMIA R0!, {R3-R6}                      EOL\
+    LDMIA R0, {R3-R6}                       EOL\
+    MOVW R7, #0xAEA3                        EOL\
+    MOVT R7, #0x3158                        EOL\
+    AND R7, R7, R11                         EOL\
+    ADCS R3, R3, R7                         EOL\
+    MOVW R7, #0x5C78                        EOL\
+    MOVT R7, #0x7BC6                        EOL\
+    AND R7, R7, R11                         EOL\
+    ADCS R4, R4, R7                         EOL\
+    MOVW R7, #0x2056                        EOL\
+    MOVT R7, #0x81C5                        EOL\
+    AND R7, R7, R11                         EOL\
+    ADCS R5, R5, R7                         EOL\
+    MOVW R7, #0x5FD6                        EOL\
+    MOVT R7, #0x6CFC                        EOL\
+    AND R7, R7, R11                         EOL\
+    ADCS R6, R6, R7                         EOL\
+    STMIA R0!, {R3-R6}                      EOL\
+    LDMIA R0, {R3-R4}                       EOL\
+    MOVW R7, #0x7344                        EOL\
+    MOVT R7, #0x2717                        EOL\
+    AND R7, R7, R11                         EOL\
+    ADCS R3, R3, R7                         EOL\
+    MOVW R7, #0x341F                        EOL\
+    MOVT R7, #0x0002                        EOL\
+    AND R7, R7, R11                         EOL\
+    ADCS R4, R4, R7                         EOL\
+    STMIA R0!, {R3-R4}                      EOL\
+
+
+// Body of fp2mul_mont, shared with the chained kernels fp2mul_chain and fp2mulk_chain. The sums t1 and t2
+// are written to [SP] and [SP+4*14], a and b being saved at [SP+4*28] and [SP+4*29], and R0 and R1 are
+// left pointing to them
+#define P_FP2MUL_SUMS \
+/*t1 = a0+a1, t2 = b0+b1 */                                 \
+"LDR R0, [SP, #4 * 28] \n\t"                                \
+"ADD R1, R0, #4*14 \n\t"                                    \
+"MOV R2, SP \n\t"                                           \
+STRFY(P_ADD_FIELD)                                          \
+"LDR R0, [SP, #4 * 29] \n\t"                                \
+"ADD R1, R0, #4*14 \n\t"                                    \
+STRFY(P_ADD_FIELD)                                          \
+/*FRAME#3 operands */                                       \
+"MOV R0, SP \n\t"                                           \
+"ADD R1, SP, #4*14 \n\t"
+
+// Same as P_FP2MUL_SUMS, with t2 = b0+b1 read from b+4*28 as laid out by fp2pre_chain
+#define P_FP2MUL_SUMS_PRE \
+/*t1 = a0+a1, t2 = b0+b1 precomputed at b+4*28 */           \
+"LDR R0, [SP, #4 * 28] \n\t"                                \
+"ADD R1, R0, #4*14 \n\t"                                    \
+"MOV R2, SP \n\t"                                           \
+STRFY(P_ADD_FIELD)                                          \
+/*FRAME#3 operands */                                       \
+"MOV R0, SP \n\t"                                           \
+"LDR R1, [SP, #4 * 29] \n\t"                                \
+"ADD R1, R1, #4*28 \n\t"
+
+// Products of t1 [R0] and t2 [R1], a0*b0 and a1*b1 in stacked frames, then reductions to c saved at [SP+4*30]
+#define P_FP2MUL_PRODUCTS \
+/*FRAME#3: tt3 = t1*t2, result pointer c1 */                \
+"LDR R2, [SP, #4 * 30] \n\t"                                \
+"ADD R2, R2, #4*14 \n\t"                                    \
+"SUB SP, #4*31 \n\t"                                        \
+"STR R0, [SP, #4 * 28] \n\t"                                \
+"STR R1, [SP, #4 * 29] \n\t"                                \
+"STR R2, [SP, #4 * 30] \n\t"                                \
+P_MUL_ROUNDS                                                \
+/*FRAME#2: tt2 = a1*b1 */                                   \
+"LDR R0, [SP, #4 * 59] \n\t"                                \
+"LDR R1, [SP, #4 * 60] \n\t"                                \
+"ADD R0, R0, #4*14 \n\t"                                    \
+"ADD R1, R1, #4*14 \n\t"                                    \
+"SUB SP, #4*31 \n\t"                                        \
+"STR R0, [SP, #4 * 28] \n\t"                                \
+"STR R1, [SP, #4 * 29] \n\t"                                \
+P_MUL_ROUNDS                                                \
+/*FRAME#1: tt1 = a0*b0, result pointer c0 */                \
+"LDR R0, [SP, #4 * 90] \n\t"                                \
+"LDR R1, [SP, #4 * 91] \n\t"                                \
+"LDR R2, [SP, #4 * 92] \n\t"                                \
+"SUB SP, #4*31 \n\t"                                        \
+"STR R0, [SP, #4 * 28] \n\t"                                \
+"STR R1, [SP, #4 * 29] \n\t"                                \
+"STR R2, [SP, #4 * 30] \n\t"                                \
+P_MUL_ROUNDS                                                \
+/*tt3 = tt3 - tt1 - tt2 */                                  \
+"ADD R0, SP, #4*62 \n\t"                                    \
+"MOV R1, SP \n\t"                                           \
+"MOV R2, R0 \n\t"                                           \
+STRFY(P_SUB_DOUBLE)                                         \
+"ADD R0, SP, #4*62 \n\t"                                    \
+"ADD R1, SP, #4*31 \n\t"                                    \
+"MOV R2, R0 \n\t"                                           \
+STRFY(P_SUB_DOUBLE)                                         \
+/*tt1 = tt1 - tt2, plus p*2^448 if negative */              \
+"MOV R0, SP \n\t"                                           \
+"ADD R1, SP, #4*31 \n\t"                                    \
+"MOV R2, R0 \n\t"                                           \
+STRFY(P_SUB_DOUBLE)                                         \
+"SBC R11, R11, R11 \n\t" /* MASK */                         \
+"ADD R0, SP, #4*14 \n\t"                                    \
+STRFY(P_ADD_PRIME_MASKED)                                   \
+/*c0 = tt1*R^-1, c1 = tt3*R^-1 */                           \
+P_RDC_ROUNDS                                                \
+"ADD SP, #4*62 \n\t"                                        \
+P_RDC_ROUNDS
+
+
+#if (TARGET == TARGET_ARM)
+
+void __attribute__ ((noinline, naked)) fp2mul_mont(const f2elm_t a, const f2elm_t b, f2elm_t c)
+{ // GF(p^2) multiplication using Montgomery arithmetic with lazy reduction, c = a*b in GF(p^2).
+  // Inputs: a = a0+a1*i and b = b0+b1*i, where a0, a1, b0, b1 are in [0, 2*p-1] 
+  // Output: c = c0+c1*i, where c0, c1 are in [0, 2*p-1] 
+  // The three products are kept unreduced in stacked frames laid out as the one of fpmul_mont,
+  // so that the rounds of fpmul_mont are shared and a single reduction is done per component.
+asm volatile(\
+OP_COUNT_ASM(OP_FP2MUL)
+STRFY(P_MUL_PROLOG)
+"SUB SP, #4*28 			\n\t"
+P_FP2MUL_SUMS
+P_FP2MUL_PRODUCTS
+
+"ADD SP, #4*62 		   \n\t"
+STRFY(P_MUL_EPILOG)
+  :
+  : 
+  : "cc", "memory"
+);
+}
+
+#else
+
 void fp2mul_mont(const f2elm_t a, const f2elm_t b, f2elm_t c)
 { // GF(p^2) multiplication using Montgomery arithmetic, c = a*b in GF(p^2).
   // Inputs: a = a0+a1*i and b = b0+b1*i, where a0, a1, b0, b1 are in [0, 2*p-1] 
   // Output: c = c0+c1*i, where c0, c1 are in [0, 2*p-1] 
     felm_t t1, t2;
-    dfelm_t tt1, tt2, tt3; 
+    dfelm_t tt1, tt2, tt3;
     digit_t mask;
     unsigned int i;
-    
+
+    OP_COUNT_INC(OP_FP2MUL);
     mp_addfast(a[0], a[1], t1);                      // t1 = a0+a1
     mp_addfast(b[0], b[1], t2);                      // t2 = b0+b1
-    
-	fpmul_mont(a[0], b[0], c[0]);
-	fpmul_mont(a[1], b[1], tt2);
-	fpmul_mont(t1, t2, c[1]);
-	
-	fpsub(c[1],c[0],c[1]);
-	fpsub(c[1],tt2,c[1]);
-	
-	fpsub(c[0],tt2,c[0]);
+    mp_mul(a[0], b[0], tt1, NWORDS_FIELD);           // tt1 = a0*b0
+    mp_mul(a[1], b[1], tt2, NWORDS_FIELD);           // tt2 = a1*b1
+    mp_mul(t1, t2, tt3, NWORDS_FIELD);               // tt3 = (a0+a1)*(b0+b1)
+    mp_dblsubfast(tt1, tt2, tt3);                    // tt3 = (a0+a1)*(b0+b1) - a0*b0 - a1*b1
+    mask = mp_subfast(tt1, tt2, tt1);                // tt1 = a0*b0 - a1*b1. If tt1 < 0 then mask = 0xFF..F, else if tt1 >= 0 then mask = 0x00..0
+    for (i = 0; i < NWORDS_FIELD; i++) {
+        t1[i] = ((digit_t*)PRIME)[i] & mask;
+    }
+    rdc_mont(tt3, c[1]);                             // c[1] = (a0+a1)*(b0+b1) - a0*b0 - a1*b1
+    mp_addfast((digit_t*)&tt1[NWORDS_FIELD], t1, (digit_t*)&tt1[NWORDS_FIELD]);
+    rdc_mont(tt1, c[0]);                             // c[0] = a0*b0 - a1*b1
+}
+
+#endif
+
+
+#if (TARGET == TARGET_ARM)
+
+// Kernels chained by xDBLe and xTPLe (see ec_isogeny.c). They take their arguments in R0-R2 as the kernels above, but
+// save no register other than LR: the chains save R4-R11 once and keep their own state in S0-S15 and in their stack
+// frame. The results are those of the functions they replace, bit for bit, and they are counted as those
+
+// c [R2] = a [R0] - b [R1], NWORDS_FIELD words. The final borrow is left in the carry flag
+#define P_SUB_FIELD \
+    P_LAZY4(SUBS, SBCS) \
+    P_LAZY4(SBCS, SBCS) \
+    P_LAZY4(SBCS, SBCS) \
+    P_LAZY2(SBCS, SBCS)
+
+// c [R2] = a [R0] + b [R1] - 2p [R14], chunked as P_LAZY4. Between chunks the carry of the addition is kept in R11
+// and the borrow of the subtraction in R12, as 0 or -1, and restored by RSBS
+#define P_ADDSUB4_FIRST \
+    LDMIA R0!, {R3-R6}                      EOL\
+    LDMIA R1!, {R7-R10}                     EOL\
+    ADDS R3, R3, R7                         EOL\
+    ADCS R4, R4, R8                         EOL\
+    ADCS R5, R5, R9                         EOL\
+    ADCS R6, R6, R10                        EOL\
+    SBC R11, R11, R11                       EOL\
+    LDMIA R14!, {R7-R10}                    EOL\
+    SUBS R3, R3, R7                         EOL\
+    SBCS R4, R4, R8                         EOL\
+    SBCS R5, R5, R9                         EOL\
+    SBCS R6, R6, R10                        EOL\
+    SBC R12, R12, R12                       EOL\
+    STMIA R2!, {R3-R6}                      EOL\
+
+#define P_ADDSUB4 \
+    LDMIA R0!, {R3-R6}                      EOL\
+    LDMIA R1!, {R7-R10}                     EOL\
+    RSBS R11, R11, #0                       EOL\
+    ADCS R3, R3, R7                         EOL\
+    ADCS R4, R4, R8                         EOL\
+    ADCS R5, R5, R9                         EOL\
+    ADCS R6, R6, R10                        EOL\
+    SBC R11, R11, R11                       EOL\
+    LDMIA R14!, {R7-R10}                    EOL\
+    RSBS R12, R12, #0                       EOL\
+    SBCS R3, R3, R7                         EOL\
+    SBCS R4, R4, R8                         EOL\
+    SBCS R5, R5, R9                         EOL\
+    SBCS R6, R6, R10                        EOL\
+    SBC R12, R12, R12                       EOL\
+    STMIA R2!, {R3-R6}                      EOL\
+
+#define P_ADDSUB2 \
+    LDMIA R0!, {R3-R4}                      EOL\
+    LDMIA R1!, {R7-R8}                      EOL\
+    RSBS R11, R11, #0                       EOL\
+    ADCS R3, R3, R7                         EOL\
+    ADCS R4, R4, R8                         EOL\
+    LDMIA R14!, {R7-R8}                     EOL\
+    RSBS R12, R12, #0                       EOL\
+    SBCS R3, R3, R7                         EOL\
+    SBCS R4, R4, R8                         EOL\
+    SBC R12, R12, R12                       EOL\
+    STMIA R2!, {R3-R4}                      EOL\
+
+// c [R2] = a [R0] + b [R1] - 2p [R14], NWORDS_FIELD words. R12 is left as the mask of the final borrow
+#define P_ADDSUB_FIELD \
+    P_ADDSUB4_FIRST \
+    P_ADDSUB4 \
+    P_ADDSUB4 \
+    P_ADDSUB2
+
+// [R12] = [R12] + ([R14] & mask [R11]), chunked as P_LAZY4
+#define P_ADD_MASKED4(OP0) \
+    LDMIA R12, {R3-R6}                      EOL\
+    LDMIA R14!, {R7-R10}                    EOL\
+    AND R7, R7, R11                         EOL\
+    AND R8, R8, R11                         EOL\
+    AND R9, R9, R11                         EOL\
+    AND R10, R10, R11                       EOL\
+    OP0 R3, R3, R7                          EOL\
+    ADCS R4, R4, R8                         EOL\
+    ADCS R5, R5, R9                         EOL\
+    ADCS R6, R6, R10                        EOL\
+    STMIA R12!, {R3-R6}                     EOL\
+
+#define P_ADD_MASKED2(OP0) \
+    LDMIA R12, {R3-R4}                      EOL\
+    LDMIA R14!, {R7-R8}                     EOL\
+    AND R7, R7, R11                         EOL\
+    AND R8, R8, R11                         EOL\
+    OP0 R3, R3, R7                          EOL\
+    ADCS R4, R4, R8                         EOL\
+    STMIA R12!, {R3-R4}                     EOL\
+
+// [R12] = [R12] + ([R14] & mask [R11]), NWORDS_FIELD words
+#define P_ADD_MASKED_FIELD \
+    P_ADD_MASKED4(ADDS) \
+    P_ADD_MASKED4(ADCS) \
+    P_ADD_MASKED4(ADCS) \
+    P_ADD_MASKED2(ADCS)
+
+#define P_LOAD_PRIMEX2 \
+    MOVW R14, #:lower16:p434x2              EOL\
+    MOVT R14, #:upper16:p434x2              EOL\
+
+// c [R2] = a [R0] + b [R1] mod p as in fpadd, a+b-2p plus 2p if negative. R0, R1 and R2 are left past the operands
+#define P_ADD_MOD \
+    P_LOAD_PRIMEX2 \
+    P_ADDSUB_FIELD \
+    MOV R11, R12                            EOL\
+    SUB R12, R2, #4*14                      EOL\
+    P_LOAD_PRIMEX2 \
+    P_ADD_MASKED_FIELD
+
+// c [R2] = a [R0] - b [R1] mod p as in fpsub, a-b plus 2p if negative. R0, R1 and R2 are left past the operands
+#define P_SUB_MOD \
+    MOV R12, R2                             EOL\
+    P_SUB_FIELD \
+    SBC R11, R11, R11                       EOL\
+    P_LOAD_PRIMEX2 \
+    P_ADD_MASKED_FIELD
+
+
+static void __attribute__ ((noinline, naked, used)) fp2add_chain(const f2elm_t a, const f2elm_t b, f2elm_t c)
+{ // GF(p^2) addition, c = a+b in GF(p^2), as fp2add.
+asm volatile(\
+OP_COUNT_ASM(OP_FPADD)
+OP_COUNT_ASM(OP_FPADD)
+"PUSH {R14} \n\t"
+STRFY(P_ADD_MOD)
+STRFY(P_ADD_MOD)
+"POP {PC} \n\t"
+  :
+  :
+  : "cc", "memory"
+);
+}
+
+
+static void __attribute__ ((noinline, naked, used)) fp2sub_chain(const f2elm_t a, const f2elm_t b, f2elm_t c)
+{ // GF(p^2) subtraction, c = a-b in GF(p^2), as fp2sub.
+asm volatile(\
+OP_COUNT_ASM(OP_FPSUB)
+OP_COUNT_ASM(OP_FPSUB)
+"PUSH {R14} \n\t"
+STRFY(P_SUB_MOD)
+STRFY(P_SUB_MOD)
+"POP {PC} \n\t"
+  :
+  :
+  : "cc", "memory"
+);
+}
+
+
+static void __attribute__ ((noinline, naked, used)) fp2sqr_chain(const f2elm_t a, f2elm_t c)
+{ // GF(p^2) squaring, c = a^2 in GF(p^2), as fp2sqr_mont. t1, t2 and t3 are at [SP], [SP+4*14] and [SP+4*28],
+  // and each product is reduced in a frame of fpmul_mont pushed below them.
+asm volatile(\
+OP_COUNT_ASM(OP_FPSUB)
+OP_COUNT_ASM(OP_FPMUL)
+OP_COUNT_ASM(OP_FPMUL)
+"PUSH {R0, R1, R14} \n\t"
+"SUB SP, #4*42 \n\t"
+
+//t1 = a0+a1
+"ADD R1, R0, #4*14 \n\t"
+"MOV R2, SP \n\t"
+STRFY(P_ADD_FIELD)
+//t2 = a0-a1
+"LDR R0, [SP, #4 * 42] \n\t"
+"ADD R1, R0, #4*14 \n\t"
+STRFY(P_SUB_MOD)
+//t3 = 2*a0
+"LDR R0, [SP, #4 * 42] \n\t"
+"MOV R1, R0 \n\t"
+STRFY(P_ADD_FIELD)
+
+//c0 = t1*t2
+"MOV R0, SP \n\t"
+"ADD R1, SP, #4*14 \n\t"
+"LDR R2, [SP, #4 * 43] \n\t"
+"PUSH {R0, R1, R2} \n\t"
+"SUB SP, #4*28 \n\t"
+P_MUL_ROUNDS
+P_RDC_ROUNDS
+"ADD SP, #4*31 \n\t"
+
+//c1 = t3*a1
+"ADD R0, SP, #4*28 \n\t"
+"LDR R1, [SP, #4 * 42] \n\t"
+"ADD R1, R1, #4*14 \n\t"
+"LDR R2, [SP, #4 * 43] \n\t"
+"ADD R2, R2, #4*14 \n\t"
+"PUSH {R0, R1, R2} \n\t"
+"SUB SP, #4*28 \n\t"
+P_MUL_ROUNDS
+P_RDC_ROUNDS
+"ADD SP, #4*75 \n\t"
+"POP {PC} \n\t"
+  :
+  :
+  : "cc", "memory"
+);
+}
+
+
+static void __attribute__ ((noinline, naked, used)) fp2pre_chain(const f2elm_t b, digit_t* bk)
+{ // Constant operand of fp2mulk_chain, bk = {b0, b1, b0+b1} in 3*NWORDS_FIELD words.
+asm volatile(\
+"MOV R12, #7 \n\t"
+"1: \n\t"
+"LDMIA R0!, {R3-R6} \n\t"
+"STMIA R1!, {R3-R6} \n\t"
+"SUBS R12, R12, #1 \n\t"
+"BNE 1b \n\t"
+"MOV R2, R1 \n\t"
+"SUB R0, R1, #4*28 \n\t"
+"SUB R1, R1, #4*14 \n\t"
+STRFY(P_ADD_FIELD)
+"BX LR \n\t"
+  :
+  :
+  : "cc", "memory"
+);
+}
+
+
+static void __attribute__ ((noinline, naked, used)) fp2mul_chain(const f2elm_t a, const f2elm_t b, f2elm_t c)
+{ // GF(p^2) multiplication, c = a*b in GF(p^2), as fp2mul_mont.
+asm volatile(\
+OP_COUNT_ASM(OP_FP2MUL)
+"PUSH {R0, R1, R2, R14} \n\t"
+"SUB SP, #4*28 \n\t"
+P_FP2MUL_SUMS
+P_FP2MUL_PRODUCTS
+"ADD SP, #4*62 \n\t"
+"POP {PC} \n\t"
+  :
+  :
+  : "cc", "memory"
+);
 }
 
 
+static void __attribute__ ((noinline, naked, used)) fp2mulk_chain(const f2elm_t a, const digit_t* bk, f2elm_t c)
+{ // GF(p^2) multiplication by a constant of the chain, c = a*b in GF(p^2), as fp2mul_mont, with bk laid out by
+  // fp2pre_chain so that b0+b1 is added once per chain.
+asm volatile(\
+OP_COUNT_ASM(OP_FP2MUL)
+"PUSH {R0, R1, R2, R14} \n\t"
+"SUB SP, #4*28 \n\t"
+P_FP2MUL_SUMS_PRE
+P_FP2MUL_PRODUCTS
+"ADD SP, #4*62 \n\t"
+"POP {PC} \n\t"
+  :
+  :
+  : "cc", "memory"
+);
+}
+
+#endif
+
+
 void fpinv_chain_mont(felm_t a)
 {// Field inversion using Montgomery arithmetic, a = a^-1*R mod p434
     felm_t t[20], tt;
@@ -1465,6 +1997,320 @@ void fp2inv_mont(f2elm_t a)
 }
 
 
+/************ Constant-time inversion with the safegcd algorithm of Bernstein and Yang *************/
+//
+// Field elements are converted to a signed radix-2^BGCD_BITS representation with BGCD_LIMBS limbs.
+// Divsteps are done in batches of BGCD_BITS on the low word of f and g, the resulting transition
+// matrix is then applied to the full f, g (update_fg) and to the cofactors d, e mod p (update_de).
+// Starting from f = p, g = a, d = 0, e = R^2, the loop ends with f = +-1 and d = +-a^(-1)*R^2 mod p,
+// so that a Montgomery input a*R gives the Montgomery output a^(-1)*R without extra multiplications.
+
+#if (TARGET == TARGET_AMD64)
+    #define BGCD_BITS           62
+    typedef int64_t             bgcd_t;
+    typedef __int128            bgcd2_t;
+#else
+    #define BGCD_BITS           30
+    typedef int32_t             bgcd_t;
+    typedef int64_t             bgcd2_t;
+#endif
+
+#define BGCD_MASK               (((bgcd_t)1 << BGCD_BITS) - 1)
+#define BGCD_LIMBS              ((NBITS_FIELD + 2 + BGCD_BITS - 1) / BGCD_BITS)
+#define BGCD_ZERO_LIMBS         (OALICE_BITS / BGCD_BITS)                        // Number of "0" limbs in the least significant part of p+1
+#define BGCD_DIVSTEPS           ((49*NBITS_FIELD + 80) / 17)                     // Bound on the number of divsteps for NBITS_FIELD-bit inputs
+#define BGCD_BATCHES            ((BGCD_DIVSTEPS + BGCD_BITS - 1) / BGCD_BITS)
+
+
+static void bgcd_from_words(const digit_t* a, bgcd_t* r)
+{ // Conversion of an NWORDS_FIELD-word integer in [0, 2^(BGCD_BITS*BGCD_LIMBS)) to BGCD_LIMBS limbs.
+    unsigned int i, w, sh;
+    digit_t t;
+
+    for (i = 0; i < BGCD_LIMBS; i++) {
+        w = (i*BGCD_BITS) / RADIX;
+        sh = (i*BGCD_BITS) % RADIX;
+        t = 0;
+        if (w < NWORDS_FIELD) {
+            t = a[w] >> sh;
+            if ((sh + BGCD_BITS > RADIX) && (w + 1 < NWORDS_FIELD)) {
+                t |= a[w+1] << (RADIX - sh);
+            }
+        }
+        r[i] = (bgcd_t)(t & BGCD_MASK);
+    }
+}
+
+
+static void bgcd_to_words(const bgcd_t* r, digit_t* a)
+{ // Conversion of BGCD_LIMBS limbs in [0, 2^BGCD_BITS) to an NWORDS_FIELD-word integer.
+    unsigned int i, w, sh;
+
+    for (i = 0; i < NWORDS_FIELD; i++) {
+        a[i] = 0;
+    }
+    for (i = 0; i < BGCD_LIMBS; i++) {
+        w = (i*BGCD_BITS) / RADIX;
+        sh = (i*BGCD_BITS) % RADIX;
+        if (w < NWORDS_FIELD) {
+            a[w] |= (digit_t)r[i] << sh;
+            if ((sh + BGCD_BITS > RADIX) && (w + 1 < NWORDS_FIELD)) {
+                a[w+1] |= (digit_t)r[i] >> (RADIX - sh);
+            }
+        }
+    }
+}
+
+
+#if (TARGET == TARGET_ARM)
+
+#define P_DIVSTEP \
+    ASR R8, R0, CV(31) EOL\
+    SBFX R9, R2, CV(0), CV(1) EOL\
+    EOR R10, R1, R8 EOL\
+    EOR R11, R4, R8 EOL\
+    EOR R12, R5, R8 EOL\
+    SUB R10, R10, R8 EOL\
+    SUB R11, R11, R8 EOL\
+    SUB R12, R12, R8 EOL\
+    AND R10, R10, R9 EOL\
+    AND R11, R11, R9 EOL\
+    AND R12, R12, R9 EOL\
+    ADD R2, R2, R10 EOL\
+    ADD R6, R6, R11 EOL\
+    ADD R7, R7, R12 EOL\
+    AND R8, R8, R9 EOL\
+    EOR R0, R0, R8 EOL\
+    SUB R0, R0, R8 EOL\
+    SUB R0, R0, CV(1) EOL\
+    AND R10, R2, R8 EOL\
+    AND R11, R6, R8 EOL\
+    AND R12, R7, R8 EOL\
+    ADD R1, R1, R10 EOL\
+    ADD R4, R4, R11 EOL\
+    ADD R5, R5, R12 EOL\
+    LSR R2, R2, CV(1) EOL\
+    LSL R4, R4, CV(1) EOL\
+    LSL R5, R5, CV(1) EOL
+
+static bgcd_t __attribute__ ((noinline, naked)) bgcd_divsteps(bgcd_t eta, digit_t f, digit_t g, bgcd_t* t)
+{ // BGCD_BITS divsteps on the low words f and g, eta = -delta. Returns the new eta and the
+  // transition matrix t = [u, v, q, r] scaled by 2^BGCD_BITS.
+  // R0 = eta, R1 = f, R2 = g, R4-R7 = u, v, q, r, R8 = swap mask, R9 = odd mask, R14 = counter.
+    asm volatile(
+        "PUSH {R4-R11, R14} \n\t"
+        "MOV R4, #1 \n\t"
+        "MOV R5, #0 \n\t"
+        "MOV R6, #0 \n\t"
+        "MOV R7, #1 \n\t"
+        "MOV R14, #15 \n\t"
+        "1: \n\t"
+        STRFY(P_DIVSTEP)
+        STRFY(P_DIVSTEP)
+        "SUBS R14, R14, #1 \n\t"
+        "BNE 1b \n\t"
+        "STMIA R3, {R4-R7} \n\t"
+        "POP {R4-R11, PC} \n\t"
+    :
+    :
+    : "cc", "memory"
+    );
+}
+
+#else
+
+static bgcd_t bgcd_divsteps(bgcd_t eta, digit_t f, digit_t g, bgcd_t* t)
+{ // BGCD_BITS divsteps on the low words f and g, eta = -delta. Returns the new eta and the
+  // transition matrix t = [u, v, q, r] scaled by 2^BGCD_BITS.
+    digit_t u = 1, v = 0, q = 0, r = 1, c1, c2, x, y, z;
+    unsigned int i;
+
+    for (i = 0; i < BGCD_BITS; i++) {
+        c1 = (digit_t)(eta >> (RADIX-1));            // c1 = -1 if eta < 0
+        c2 = 0 - (g & 1);                            // c2 = -1 if g is odd
+        x = (f ^ c1) - c1;
+        y = (u ^ c1) - c1;
+        z = (v ^ c1) - c1;
+        g += x & c2;
+        q += y & c2;
+        r += z & c2;
+        c1 &= c2;                                    // Swap if eta < 0 and g is odd
+        eta = (bgcd_t)(((digit_t)eta ^ c1) - (c1 + 1));
+        f += g & c1;
+        u += q & c1;
+        v += r & c1;
+        g >>= 1;
+        u <<= 1;
+        v <<= 1;
+    }
+    t[0] = (bgcd_t)u;
+    t[1] = (bgcd_t)v;
+    t[2] = (bgcd_t)q;
+    t[3] = (bgcd_t)r;
+
+    return eta;
+}
+
+#endif
+
+
+static void bgcd_update_fg(bgcd_t* f, bgcd_t* g, const bgcd_t* t)
+{ // [f, g] = t*[f, g]/2^BGCD_BITS. The division is exact.
+    const bgcd_t u = t[0], v = t[1], q = t[2], r = t[3];
+    bgcd2_t cf, cg;
+    unsigned int i;
+
+    cf = (bgcd2_t)u*f[0] + (bgcd2_t)v*g[0];
+    cg = (bgcd2_t)q*f[0] + (bgcd2_t)r*g[0];
+    cf >>= BGCD_BITS;
+    cg >>= BGCD_BITS;
+    for (i = 1; i < BGCD_LIMBS; i++) {
+        cf += (bgcd2_t)u*f[i] + (bgcd2_t)v*g[i];
+        cg += (bgcd2_t)q*f[i] + (bgcd2_t)r*g[i];
+        f[i-1] = (bgcd_t)cf & BGCD_MASK;
+        g[i-1] = (bgcd_t)cg & BGCD_MASK;
+        cf >>= BGCD_BITS;
+        cg >>= BGCD_BITS;
+    }
+    f[BGCD_LIMBS-1] = (bgcd_t)cf;
+    g[BGCD_LIMBS-1] = (bgcd_t)cg;
+}
+
+
+static void bgcd_update_de(bgcd_t* d, bgcd_t* e, const bgcd_t* t, const bgcd_t* pp1)
+{ // [d, e] = t*[d, e]/2^BGCD_BITS mod p, with d, e in (-2p, p).
+  // p is taken as (p+1) - 1: its least significant limb is -1 and the next BGCD_ZERO_LIMBS-1 limbs are 0.
+    const bgcd_t u = t[0], v = t[1], q = t[2], r = t[3];
+    bgcd_t sd, se, md, me;
+    bgcd2_t cd, ce;
+    unsigned int i;
+
+    sd = d[BGCD_LIMBS-1] >> (RADIX-1);               // Add p to the result if d (resp. e) is negative
+    se = e[BGCD_LIMBS-1] >> (RADIX-1);
+    md = (u & sd) + (v & se);
+    me = (q & sd) + (r & se);
+    cd = (bgcd2_t)u*d[0] + (bgcd2_t)v*e[0];
+    ce = (bgcd2_t)q*d[0] + (bgcd2_t)r*e[0];
+    md -= (bgcd_t)(((digit_t)md - (digit_t)cd) & BGCD_MASK);    // p = -1 mod 2^BGCD_BITS, so md = cd mod 2^BGCD_BITS
+    me -= (bgcd_t)(((digit_t)me - (digit_t)ce) & BGCD_MASK);
+    cd -= md;
+    ce -= me;
+    cd >>= BGCD_BITS;
+    ce >>= BGCD_BITS;
+    for (i = 1; i < BGCD_ZERO_LIMBS; i++) {
+        cd += (bgcd2_t)u*d[i] + (bgcd2_t)v*e[i];
+        ce += (bgcd2_t)q*d[i] + (bgcd2_t)r*e[i];
+        d[i-1] = (bgcd_t)cd & BGCD_MASK;
+        e[i-1] = (bgcd_t)ce & BGCD_MASK;
+        cd >>= BGCD_BITS;
+        ce >>= BGCD_BITS;
+    }
+    for (i = BGCD_ZERO_LIMBS; i < BGCD_LIMBS; i++) {
+        cd += (bgcd2_t)u*d[i] + (bgcd2_t)v*e[i] + (bgcd2_t)pp1[i]*md;
+        ce += (bgcd2_t)q*d[i] + (bgcd2_t)r*e[i] + (bgcd2_t)pp1[i]*me;
+        d[i-1] = (bgcd_t)cd & BGCD_MASK;
+        e[i-1] = (bgcd_t)ce & BGCD_MASK;
+        cd >>= BGCD_BITS;
+        ce >>= BGCD_BITS;
+    }
+    d[BGCD_LIMBS-1] = (bgcd_t)cd;
+    e[BGCD_LIMBS-1] = (bgcd_t)ce;
+}
+
+
+static void bgcd_addp_masked(bgcd_t* d, const bgcd_t* pp1, const bgcd_t mask)
+{ // d = d + (p & mask), followed by a carry propagation.
+    bgcd_t c;
+    unsigned int i;
+
+    d[0] -= 1 & mask;
+    for (i = BGCD_ZERO_LIMBS; i < BGCD_LIMBS; i++) {
+        d[i] += pp1[i] & mask;
+    }
+    for (i = 0; i < BGCD_LIMBS-1; i++) {
+        c = d[i] >> BGCD_BITS;
+        d[i] &= BGCD_MASK;
+        d[i+1] += c;
+    }
+}
+
+
+void fpinv_mont_bingcd(felm_t a)
+{ // Field inversion using the constant-time safegcd algorithm, a = a^(-1)*R mod p.
+  // Input: a in [0, 2p-1] in Montgomery representation. Output: a in [0, p-1].
+    bgcd_t f[BGCD_LIMBS], g[BGCD_LIMBS], d[BGCD_LIMBS], e[BGCD_LIMBS], pp1[BGCD_LIMBS], t[4];
+    bgcd_t eta = -1, sf, mask;
+    felm_t tt;
+    unsigned int i, j;
+
+    OP_COUNT_INC(OP_FPINV);
+    fpcopy(a, tt);
+    fpcorrection(tt);
+    bgcd_from_words((digit_t*)PRIME, f);
+    bgcd_from_words(tt, g);
+    bgcd_from_words((digit_t*)p434p1, pp1);
+    bgcd_from_words((digit_t*)&Montgomery_R2, e);
+    for (i = 0; i < BGCD_LIMBS; i++) {
+        d[i] = 0;
+    }
+
+    for (j = 0; j < BGCD_BATCHES; j++) {
+        eta = bgcd_divsteps(eta, (digit_t)f[0], (digit_t)g[0], t);
+        bgcd_update_de(d, e, t, pp1);
+        bgcd_update_fg(f, g, t);
+    }
+
+    // d in (-2p, p), f = +-1
+    sf = f[BGCD_LIMBS-1] >> (RADIX-1);
+    mask = d[BGCD_LIMBS-1] >> (RADIX-1);
+    bgcd_addp_masked(d, pp1, mask);                  // d in (-p, p)
+    for (i = 0; i < BGCD_LIMBS; i++) {
+        d[i] = (d[i] ^ sf) - sf;                     // d = d*f
+    }
+    bgcd_addp_masked(d, pp1, 0);
+    mask = d[BGCD_LIMBS-1] >> (RADIX-1);
+    bgcd_addp_masked(d, pp1, mask);                  // d in [0, p-1]
+    bgcd_to_words(d, a);
+}
+
+
+void fp2inv_mont_bingcd(f2elm_t a)
+{// GF(p^2) inversion using Montgomery arithmetic, a = (a0-i*a1)/(a0^2+a1^2), GF(p) inversion done with safegcd.
+    f2elm_t t1;
+
+    fpsqr_mont(a[0], t1[0]);                         // t10 = a0^2
+    fpsqr_mont(a[1], t1[1]);                         // t11 = a1^2
+    fpadd(t1[0], t1[1], t1[0]);                      // t10 = a0^2+a1^2
+    fpinv_mont_bingcd(t1[0]);                        // t10 = (a0^2+a1^2)^-1
+    fpneg(a[1]);                                     // a = a0-i*a1
+    fpmul_mont(a[0], t1[0], a[0]);
+    fpmul_mont(a[1], t1[0], a[1]);                   // a = (a0-i*a1)*(a0^2+a1^2)^-1
+}
+
+
+void mont_n_way_inv(const f2elm_t* vec, const int n, f2elm_t* out)
+{ // n-way simultaneous inversion using Montgomery's trick, one GF(p^2) inversion and 3(n-1) multiplications.
+  // Input:  vec[0..n-1], n >= 1. The output array holds the partial products, so vec and out cannot overlap.
+  // Output: out[i] = 1/vec[i]. If any vec[i] is zero, all outputs are zero.
+    f2elm_t t1;
+    int i;
+
+    fp2copy(vec[0], out[0]);                         // out[0] = vec[0]
+    for (i = 1; i < n; i++) {
+        fp2mul_mont(out[i-1], vec[i], out[i]);       // out[i] = vec[0]*...*vec[i]
+    }
+
+    fp2copy(out[n-1], t1);
+    fp2inv_mont(t1);                                 // t1 = 1/(vec[0]*...*vec[n-1])
+
+    for (i = n-1; i >= 1; i--) {
+        fp2mul_mont(out[i-1], t1, out[i]);           // out[i] = 1/vec[i]
+        fp2mul_mont(t1, vec[i], t1);                 // t1 = 1/(vec[0]*...*vec[i-1])
+    }
+    fp2copy(t1, out[0]);                             // out[0] = 1/vec[0]
+}
+
+
 void to_fp2mont(const f2elm_t a, f2elm_t mc)
 { // Conversion of a GF(p^2) element to Montgomery representation,
   // mc_i = a_i*R^2*R^(-1) = a_i*R in GF(p^2). 
@@ -1482,11 +2328,19 @@ void from_fp2mont(const f2elm_t ma, f2elm_t c)
     from_mont(ma[1], c[1]);
 }
 
-unsigned int __attribute__ ((noinline, naked)) mp_add(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int nwords)
+__inline unsigned int mp_add(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int nwords)
 { // Multiprecision addition, c = a+b, where lng(a) = lng(b) = nwords. Returns the carry bit.
+    unsigned int i, carry = 0;
+        
+    for (i = 0; i < nwords; i++) {                      
+        ADDC(carry, a[i], b[i], carry, c[i]);
+    }
+
+    return carry;
 }
 
 
+
 void mp_shiftleft(digit_t* x, unsigned int shift, const unsigned int nwords)
 {
     unsigned int i, j = 0;
@@ -1528,3 +2382,53 @@ void mp_shiftl1(digit_t* x, const unsigned int nwords)
     }
     x[0] <<= 1;
 }
+
+
+#if defined(OP_COUNT)
+
+uint32_t op_count[OP_COUNT_OPS];
+static uint32_t op_count_phases[OP_COUNT_PHASES][OP_COUNT_OPS];
+static unsigned int op_count_current = OP_PHASE_OTHER;
+
+
+void op_count_phase(const unsigned int phase)
+{ // Charges the operations counted so far to the current phase, then switches to the given phase
+    unsigned int i;
+
+    for (i = 0; i < OP_COUNT_OPS; i++) {
+        op_count_phases[op_count_current][i] += op_count[i];
+        op_count[i] = 0;
+    }
+    op_count_current = phase;
+}
+
+
+void op_count_snapshot(uint32_t counts[OP_COUNT_PHASES][OP_COUNT_OPS])
+{ // Copies the per-phase counts accumulated since the last reset
+    unsigned int i, j;
+
+    op_count_phase(op_count_current);
+    for (i = 0; i < OP_COUNT_PHASES; i++) {
+        for (j = 0; j < OP_COUNT_OPS; j++) {
+            counts[i][j] = op_count_phases[i][j];
+        }
+    }
+}
+
+
+void op_count_reset(void)
+{ // Clears all counts and switches to OP_PHASE_OTHER
+    unsigned int i, j;
+
+    for (i = 0; i < OP_COUNT_PHASES; i++) {
+        for (j = 0; j < OP_COUNT_OPS; j++) {
+            op_count_phases[i][j] = 0;
+        }
+    }
+    for (j = 0; j < OP_COUNT_OPS; j++) {
+        op_count[j] = 0;
+    }
+    op_count_current = OP_PHASE_OTHER;
+}
+
+#endif
@@ -21,6 +21,7 @@ __inline void fpadd434(const digit_t* a, const digit_t* b, digit_t* c)
 	asm(
 		
 		"push  {r4-r11,lr}			\n\t"
+		OP_COUNT_ASM(OP_FPADD)
 		"MOVW  R14,#0xFFFF	\n\t"
 		"MOVT  R14,#0xFFFF	\n\t"
 
@@ -207,6 +208,7 @@ __inline void fpsub434(const digit_t* a, const digit_t* b, digit_t* c)
 	asm(
 		
 		"push  {r4-r11,lr}			\n\t"
+		OP_COUNT_ASM(OP_FPSUB)
 		
 		"mov r3, r2 \n\t"
 
@@ -363,6 +365,7 @@ void fpcorrection434(digit_t* a)
     unsigned int i, borrow = 0;
     digit_t mask;
 
+    OP_COUNT_INC(OP_FPCORRECTION);
     for (i = 0; i < NWORDS_FIELD; i++) {
         SUBC(borrow, a[i], ((digit_t*)p434)[i], borrow, a[i]); 
     }
@@ -0,0 +1,236 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: host thread pool for the point evaluations of the isogeny tree traversal
+*********************************************************************************************/
+
+#include "P434_internal.h"
+
+#if defined(THREADS)
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <immintrin.h>
+
+#ifndef POOL_SPIN
+    #define POOL_SPIN           4096        // Busy-wait iterations before yielding the core, or before an idle worker sleeps
+#endif
+
+// Job of the current round, published by incrementing generation. Worker t evaluates the points t-1, t-1 + nworkers, ...
+// of the concatenation of pts and phi.
+// A job of pool_call is fn(arg), run by worker 1 alone. Workers that find no new job within POOL_SPIN iterations
+// sleep on wake, sleepers counting them so that a new generation only takes the idle mutex when one of them sleeps.
+// started is the generation at pool_start, the first one a new worker waits past
+static struct {
+    pthread_t thread[POOL_MAX_WORKERS];
+    pthread_mutex_t lock, idle;
+    pthread_cond_t wake;
+    unsigned int nworkers;
+    uint32_t generation, done, stop, pending, sleepers, started;
+    unsigned int deg, npts, nphi;
+    point_proj_t *pts, *phi;
+    const f2elm_t* coeff;
+    void (*fn)(void*);
+    void* arg;
+} pool = { .lock = PTHREAD_MUTEX_INITIALIZER, .idle = PTHREAD_MUTEX_INITIALIZER, .wake = PTHREAD_COND_INITIALIZER };
+
+static __thread unsigned int pool_background = 0;      // Set on the keypair pool and KEM service workers, which never take the pool
+
+
+static void pool_wait(void)
+{ // Spins for a while, then gives the core away to the other threads. The caller waits on the workers this way,
+  // a round lasts the evaluation of a few points
+    static __thread unsigned int spins = 0;
+
+    if (++spins < POOL_SPIN) {
+        _mm_pause();
+    } else {
+        spins = 0;
+        sched_yield();
+    }
+}
+
+
+static uint32_t pool_next(const uint32_t seen)
+{ // Waits for a generation other than seen: spins for POOL_SPIN iterations, then sleeps until pool_publish.
+  // sleepers is raised before generation is read again, and pool_publish reads sleepers after raising generation,
+  // so that one of them sees the other
+    uint32_t gen;
+    unsigned int spins;
+
+    for (spins = 0; spins < POOL_SPIN; spins++) {
+        if ((gen = __atomic_load_n(&pool.generation, __ATOMIC_ACQUIRE)) != seen) {
+            return gen;
+        }
+        _mm_pause();
+    }
+    pthread_mutex_lock(&pool.idle);
+    __atomic_add_fetch(&pool.sleepers, 1, __ATOMIC_SEQ_CST);
+    while ((gen = __atomic_load_n(&pool.generation, __ATOMIC_SEQ_CST)) == seen) {
+        pthread_cond_wait(&pool.wake, &pool.idle);
+    }
+    __atomic_sub_fetch(&pool.sleepers, 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&pool.idle);
+    return gen;
+}
+
+
+static void pool_publish(void)
+{ // Starts a new generation and wakes the sleeping workers
+    __atomic_add_fetch(&pool.generation, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&pool.sleepers, __ATOMIC_SEQ_CST) != 0) {
+        pthread_mutex_lock(&pool.idle);
+        pthread_cond_broadcast(&pool.wake);
+        pthread_mutex_unlock(&pool.idle);
+    }
+}
+
+
+static void pool_run(const unsigned int t)
+{
+    unsigned int k, n = pool.npts + pool.nphi;
+
+    for (k = t - 1; k < n; k += pool.nworkers) {
+        point_proj* P = (k < pool.npts) ? pool.pts[k] : pool.phi[k - pool.npts];
+        if (pool.deg == 4) {
+            eval_4_isog(P, (f2elm_t*)pool.coeff);
+        } else {
+            eval_3_isog(P, pool.coeff);
+        }
+    }
+}
+
+
+static void* pool_worker(void* arg)
+{
+    const unsigned int t = (unsigned int)(uintptr_t)arg;
+    uint32_t seen = pool.started;
+
+    for (;;) {
+        seen = pool_next(seen);
+        if (__atomic_load_n(&pool.stop, __ATOMIC_RELAXED)) {
+            break;
+        }
+        if (pool.fn == NULL) {
+            pool_run(t);
+        } else if (t == 1) {
+            pool.fn(pool.arg);
+        }
+        __atomic_add_fetch(&pool.done, 1, __ATOMIC_RELEASE);
+    }
+    return NULL;
+}
+
+
+unsigned int pool_start(unsigned int nworkers)
+{ // Worker t is pinned to core t modulo the number of cores, core 0 being left to the caller
+    long ncores = sysconf(_SC_NPROCESSORS_ONLN);
+    cpu_set_t cores;
+    unsigned int t;
+
+    pool_stop();
+    if (ncores < 1) {
+        ncores = 1;
+    }
+    if (nworkers == 0) {
+        nworkers = (unsigned int)ncores - 1;
+    }
+    if (nworkers > POOL_MAX_WORKERS) {
+        nworkers = POOL_MAX_WORKERS;
+    }
+
+    pthread_mutex_lock(&pool.lock);
+    pool.stop = 0;
+    pool.started = pool.generation;
+    for (t = 0; t < nworkers; t++) {
+        if (pthread_create(&pool.thread[t], NULL, pool_worker, (void*)(uintptr_t)(t + 1)) != 0) {
+            break;
+        }
+        CPU_ZERO(&cores);
+        CPU_SET((t + 1) % ncores, &cores);
+        pthread_setaffinity_np(pool.thread[t], sizeof(cores), &cores);
+    }
+    pool.nworkers = t;
+    pthread_mutex_unlock(&pool.lock);
+    return t;
+}
+
+
+void pool_stop(void)
+{
+    unsigned int t;
+
+    pthread_mutex_lock(&pool.lock);
+    if (pool.nworkers != 0) {
+        __atomic_store_n(&pool.stop, 1, __ATOMIC_RELAXED);
+        pool_publish();
+        for (t = 0; t < pool.nworkers; t++) {
+            pthread_join(pool.thread[t], NULL);
+        }
+        pool.nworkers = 0;
+    }
+    pthread_mutex_unlock(&pool.lock);
+}
+
+
+unsigned int pool_begin(void)
+{
+    if (pool.nworkers == 0 || pool_background != 0 || pthread_mutex_trylock(&pool.lock) != 0) {
+        return 0;
+    }
+    if (pool.nworkers == 0) {                   // Stopped in the meantime
+        pthread_mutex_unlock(&pool.lock);
+        return 0;
+    }
+    pool.pending = 0;
+    return pool.nworkers + 1;
+}
+
+
+void pool_submit(const unsigned int deg, point_proj_t* pts, const unsigned int npts, point_proj_t* phi, const unsigned int nphi, const f2elm_t* coeff)
+{ // The workers evaluate the points, the caller continues until pool_join
+    if (npts + nphi == 0) {
+        return;
+    }
+    pool.deg = deg;
+    pool.pts = pts;
+    pool.npts = npts;
+    pool.phi = phi;
+    pool.nphi = nphi;
+    pool.coeff = coeff;
+    pool.fn = NULL;
+    pool.done = 0;
+    pool.pending = 1;
+    pool_publish();
+}
+
+
+void pool_call(void (*fn)(void*), void* arg)
+{ // Runs fn(arg) on the first reserved worker, the caller continues until pool_join
+    pool.fn = fn;
+    pool.arg = arg;
+    pool.done = 0;
+    pool.pending = 1;
+    pool_publish();
+}
+
+
+void pool_join(void)
+{
+    if (pool.pending != 0) {
+        while (__atomic_load_n(&pool.done, __ATOMIC_ACQUIRE) != pool.nworkers) {
+            pool_wait();
+        }
+        pool.pending = 0;
+    }
+}
+
+
+void pool_end(void)
+{
+    pool_join();
+    pthread_mutex_unlock(&pool.lock);
+}
+
+#endif
@@ -0,0 +1,354 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: AVX2 arithmetic over GF(p503) and GF(p503^2) on 4 independent elements at once
+*********************************************************************************************/
+
+#include "../P503_internal.h"
+
+#if defined(AVX2)
+
+#include <string.h>
+#include <immintrin.h>
+
+// The functions using AVX2 are compiled for it individually, the library itself keeps running on any x64 CPU
+#define AVX2_TARGET             __attribute__((target("avx2")))
+// Loops over the limbs are unrolled completely, GCC does it by itself only up to 16 iterations
+#define AVX2_UNROLL             _Pragma("GCC unroll 32")
+
+#define NLIMBS29                18          // Radix-2^29 limbs, 2^(29*NLIMBS29) > 4*p503
+#define ZLIMBS29                8           // Low limbs of p503+1 that are zero
+#define MASK29                  0x1FFFFFFFULL
+
+#if (NLIMBS29 % 2 == 1) || (ZLIMBS29 < 2)
+    #error -- "yfpmul_mont requires an even number of limbs and two zero limbs of p+1"
+#endif
+
+// Lane-sliced elements: limb i of the element in lane k is the k-th 64-bit word of v[i], below 2^29 between operations.
+// Elements are in [0, 2p-1] in Montgomery representation with R = 2^(29*NLIMBS29)
+typedef __m256i yfelm_t[NLIMBS29];
+typedef yfelm_t yf2elm_t[2];
+typedef struct { yf2elm_t X; yf2elm_t Z; } ypoint_proj;
+typedef ypoint_proj ypoint_proj_t[1];
+
+static const uint64_t avx2_p[NLIMBS29]         = { 0x1FFFFFFF, 0x1FFFFFFF, 0x1FFFFFFF, 0x1FFFFFFF, 0x1FFFFFFF, 0x1FFFFFFF, 0x1FFFFFFF, 0x1FFFFFFF,
+                                                   0x00ABFFFF, 0x11108F3D, 0x04C216F6, 0x16FCFB5E, 0x19BF6C87, 0x1BD2680D, 0x171AF769, 0x03C3CC08,
+                                                   0x06F54181, 0x00000203 };
+static const uint64_t avx2_px2[NLIMBS29]       = { 0x1FFFFFFE, 0x1FFFFFFF, 0x1FFFFFFF, 0x1FFFFFFF, 0x1FFFFFFF, 0x1FFFFFFF, 0x1FFFFFFF, 0x1FFFFFFF,
+                                                   0x0157FFFF, 0x02211E7A, 0x09842DED, 0x0DF9F6BC, 0x137ED90F, 0x17A4D01B, 0x0E35EED3, 0x07879811,
+                                                   0x0DEA8302, 0x00000406 };
+// 2^(29*NLIMBS29) - p503 and 2^(29*NLIMBS29) - 2*p503
+static const uint64_t avx2_pneg[NLIMBS29]      = { 0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+                                                   0x1F540000, 0x0EEF70C2, 0x1B3DE909, 0x090304A1, 0x06409378, 0x042D97F2, 0x08E50896, 0x1C3C33F7,
+                                                   0x190ABE7E, 0x1FFFFDFC };
+static const uint64_t avx2_px2neg[NLIMBS29]    = { 0x00000002, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+                                                   0x1EA80000, 0x1DDEE185, 0x167BD212, 0x12060943, 0x0C8126F0, 0x085B2FE4, 0x11CA112C, 0x187867EE,
+                                                   0x12157CFD, 0x1FFFFBF9 };
+// p503+1, its ZLIMBS29 low limbs are zero
+static const uint64_t avx2_p1[NLIMBS29]        = { 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+                                                   0x00AC0000, 0x11108F3D, 0x04C216F6, 0x16FCFB5E, 0x19BF6C87, 0x1BD2680D, 0x171AF769, 0x03C3CC08,
+                                                   0x06F54181, 0x00000203 };
+// Montgomery one, R mod p503
+static const uint64_t avx2_one[NLIMBS29]       = { 0x000FE66B, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+                                                   0x101C0000, 0x18CFFE0A, 0x09CCE88A, 0x1FE81E78, 0x0587ED75, 0x1CC30970, 0x1E3D6E26, 0x0F570DA4,
+                                                   0x0812DA31, 0x000001AE };
+// Conversion constants R^2/2^512 and 2^512 mod p503, between the scalar (R = 2^512) and the radix-2^29 representations
+static const uint64_t avx2_to_mont[NLIMBS29]   = { 0x1F99AF57, 0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+                                                   0x118C0000, 0x01A9C536, 0x0F6779B8, 0x198E59C8, 0x01625EB5, 0x006C3A96, 0x0AA84902, 0x094822A6,
+                                                   0x0E4AFFAF, 0x00000043 };
+static const uint64_t avx2_from_mont[NLIMBS29] = { 0x000003F9, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+                                                   0x14B40000, 0x1536F695, 0x18F2C69B, 0x0CFD66FA, 0x1689D8D6, 0x1920A128, 0x15DF1C6A, 0x0B2A7159,
+                                                   0x1BAEC60F, 0x00000137 };
+
+
+static void avx2_repack(const uint64_t* in, const unsigned int inbits, const unsigned int nin, uint64_t* out, const unsigned int outbits, const unsigned int nout)
+{ // Changes the radix of a little-endian integer from 2^inbits to 2^outbits, inbits and outbits <= 64.
+  // Bits beyond nout digits are dropped
+    unsigned __int128 acc = 0;
+    unsigned int i, j = 0, n = 0;
+    uint64_t mask = (outbits == 64) ? (uint64_t)-1 : ((uint64_t)1 << outbits) - 1;
+
+    for (i = 0; i < nout; i++) {
+        while (n < outbits && j < nin) {
+            acc |= (unsigned __int128)in[j++] << n;
+            n += inbits;
+        }
+        out[i] = (uint64_t)acc & mask;
+        acc >>= outbits;
+        n = (n > outbits) ? n - outbits : 0;
+    }
+}
+
+
+static AVX2_TARGET __m256i yfp_carry(__m256i* a)
+{ // Propagates the carries of a to 29-bit limbs, returns the carry out of the top limb
+    __m256i carry = _mm256_setzero_si256(), mask = _mm256_set1_epi64x(MASK29);
+    unsigned int i;
+
+    AVX2_UNROLL
+    for (i = 0; i < NLIMBS29; i++) {
+        a[i] = _mm256_add_epi64(a[i], carry);
+        carry = _mm256_srli_epi64(a[i], 29);
+        a[i] = _mm256_and_si256(a[i], mask);
+    }
+    return carry;
+}
+
+
+static AVX2_TARGET void yfp_select(__m256i* t, __m256i* u, __m256i* c)
+{ // c = t mod 2^(29*NLIMBS29) if the carry out of t is 1, u mod 2^(29*NLIMBS29) otherwise. The carries of
+  // both are propagated in the same pass, so that the conditional correction does not need a second one
+    __m256i ct = _mm256_setzero_si256(), cu = _mm256_setzero_si256(), mask = _mm256_set1_epi64x(MASK29);
+    unsigned int i;
+
+    AVX2_UNROLL
+    for (i = 0; i < NLIMBS29; i++) {
+        t[i] = _mm256_add_epi64(t[i], ct);
+        u[i] = _mm256_add_epi64(u[i], cu);
+        ct = _mm256_srli_epi64(t[i], 29);
+        cu = _mm256_srli_epi64(u[i], 29);
+        t[i] = _mm256_and_si256(t[i], mask);
+        u[i] = _mm256_and_si256(u[i], mask);
+    }
+    ct = _mm256_sub_epi64(_mm256_setzero_si256(), ct);
+    AVX2_UNROLL
+    for (i = 0; i < NLIMBS29; i++) {
+        c[i] = _mm256_blendv_epi8(u[i], t[i], ct);
+    }
+}
+
+
+static AVX2_TARGET void yfpcopy(const __m256i* a, __m256i* c)
+{
+    unsigned int i;
+
+    AVX2_UNROLL
+    for (i = 0; i < NLIMBS29; i++) {
+        c[i] = a[i];
+    }
+}
+
+
+static AVX2_TARGET void yfpadd(const __m256i* a, const __m256i* b, __m256i* c)
+{ // Modular addition, c = a+b mod p503, selecting a+b+(2^(29*NLIMBS29)-2*p503) if it carries out, a+b otherwise.
+  // Inputs: a, b in [0, 2*p503-1]
+  // Output: c in [0, 2*p503-1]
+    __m256i t[NLIMBS29], u[NLIMBS29];
+    unsigned int i;
+
+    AVX2_UNROLL
+    for (i = 0; i < NLIMBS29; i++) {
+        u[i] = _mm256_add_epi64(a[i], b[i]);
+        t[i] = _mm256_add_epi64(u[i], _mm256_set1_epi64x((long long)avx2_px2neg[i]));
+    }
+    yfp_select(t, u, c);
+}
+
+
+static AVX2_TARGET void yfpsub(const __m256i* a, const __m256i* b, __m256i* c)
+{ // Modular subtraction, c = a-b mod p503, selecting a+(2^(29*NLIMBS29)-1-b)+1 if it carries out, i.e. a >= b, a-b+2*p503 otherwise.
+  // Inputs: a, b in [0, 2*p503-1]
+  // Output: c in [0, 2*p503-1]
+    __m256i t[NLIMBS29], u[NLIMBS29], mask = _mm256_set1_epi64x(MASK29);
+    unsigned int i;
+
+    AVX2_UNROLL
+    for (i = 0; i < NLIMBS29; i++) {
+        t[i] = _mm256_add_epi64(a[i], _mm256_sub_epi64(mask, b[i]));
+        u[i] = _mm256_add_epi64(t[i], _mm256_set1_epi64x((long long)avx2_px2[i]));
+    }
+    t[0] = _mm256_add_epi64(t[0], _mm256_set1_epi64x(1));
+    u[0] = _mm256_add_epi64(u[0], _mm256_set1_epi64x(1));
+    yfp_select(t, u, c);
+}
+
+
+static AVX2_TARGET void yfpcorrection(__m256i* a)
+{ // Modular correction to reduce field element a in [0, 2*p503-1] to [0, p503-1].
+    __m256i t[NLIMBS29];
+    unsigned int i;
+
+    AVX2_UNROLL
+    for (i = 0; i < NLIMBS29; i++) {
+        t[i] = _mm256_add_epi64(a[i], _mm256_set1_epi64x((long long)avx2_pneg[i]));
+    }
+    yfp_select(t, a, a);
+}
+
+
+static AVX2_TARGET void yfpmul_mont(const __m256i* a, const __m256i* b, __m256i* c)
+{ // Montgomery multiplication, c = a*b*R^(-1) mod p503, in operand scanning over two limbs of b at a time, with the reduction
+  // interleaved. Since p503 = -1 mod 2^29, the reduction adds q*(p503+1) - q with q = t[0] mod 2^29, skipping the zero limbs
+  // of p503+1 (at least two). The accumulators are not normalized in between, they stay below 2*NLIMBS29*2^58 < 2^64.
+  // Inputs: a, b in [0, 2*p503-1]
+  // Output: c in [0, 2*p503-1]
+    __m256i t[NLIMBS29], s, q0, q1, mask = _mm256_set1_epi64x(MASK29);
+    unsigned int i, j;
+
+    AVX2_UNROLL
+    for (j = 0; j < NLIMBS29; j++) {
+        t[j] = _mm256_setzero_si256();
+    }
+    for (i = 0; i < NLIMBS29; i += 2) {
+        s = _mm256_add_epi64(t[0], _mm256_mul_epu32(a[0], b[i]));
+        q0 = _mm256_and_si256(s, mask);
+        s = _mm256_add_epi64(_mm256_add_epi64(t[1], _mm256_srli_epi64(s, 29)), _mm256_add_epi64(_mm256_mul_epu32(a[1], b[i]), _mm256_mul_epu32(a[0], b[i+1])));
+        q1 = _mm256_and_si256(s, mask);
+        AVX2_UNROLL
+        for (j = 0; j < NLIMBS29-2; j++) {      // t <- (t + a*b[i] + 2^29*a*b[i+1] + q0*(p+1) + 2^29*q1*(p+1)) / 2^58
+            t[j] = _mm256_add_epi64(t[j+2], _mm256_add_epi64(_mm256_mul_epu32(a[j+2], b[i]), _mm256_mul_epu32(a[j+1], b[i+1])));
+            if (j+2 >= ZLIMBS29) {
+                t[j] = _mm256_add_epi64(t[j], _mm256_mul_epu32(q0, _mm256_set1_epi64x((long long)avx2_p1[j+2])));
+            }
+            if (j+1 >= ZLIMBS29) {
+                t[j] = _mm256_add_epi64(t[j], _mm256_mul_epu32(q1, _mm256_set1_epi64x((long long)avx2_p1[j+1])));
+            }
+        }
+        t[NLIMBS29-2] = _mm256_add_epi64(_mm256_mul_epu32(a[NLIMBS29-1], b[i+1]), _mm256_mul_epu32(q1, _mm256_set1_epi64x((long long)avx2_p1[NLIMBS29-1])));
+        t[NLIMBS29-1] = _mm256_setzero_si256();
+        t[0] = _mm256_add_epi64(t[0], _mm256_srli_epi64(s, 29));
+    }
+    yfp_carry(t);
+    yfpcopy(t, c);
+}
+
+
+static AVX2_TARGET void yfp2copy(const yfelm_t* a, yfelm_t* c)
+{
+    yfpcopy(a[0], c[0]);
+    yfpcopy(a[1], c[1]);
+}
+
+
+static AVX2_TARGET void yfp2add(const yfelm_t* a, const yfelm_t* b, yfelm_t* c)
+{ // GF(p503^2) addition, c = a+b in GF(p503^2).
+    yfpadd(a[0], b[0], c[0]);
+    yfpadd(a[1], b[1], c[1]);
+}
+
+
+static AVX2_TARGET void yfp2sub(const yfelm_t* a, const yfelm_t* b, yfelm_t* c)
+{ // GF(p503^2) subtraction, c = a-b in GF(p503^2).
+    yfpsub(a[0], b[0], c[0]);
+    yfpsub(a[1], b[1], c[1]);
+}
+
+
+static AVX2_TARGET void yfp2mul_mont(const yfelm_t* a, const yfelm_t* b, yfelm_t* c)
+{ // GF(p503^2) multiplication using Montgomery arithmetic, c = a*b in GF(p503^2), with 3 GF(p503) multiplications.
+  // Inputs: a = a0+a1*i and b = b0+b1*i, where a0, a1, b0, b1 are in [0, 2*p503-1]
+  // Output: c = c0+c1*i, where c0, c1 are in [0, 2*p503-1]
+    yfelm_t t0, t1, t2, t3;
+
+    yfpadd(a[0], a[1], t0);                         // t0 = a0+a1
+    yfpadd(b[0], b[1], t1);                         // t1 = b0+b1
+    yfpmul_mont(t0, t1, t2);                        // t2 = (a0+a1)*(b0+b1)
+    yfpmul_mont(a[0], b[0], t0);                    // t0 = a0*b0
+    yfpmul_mont(a[1], b[1], t1);                    // t1 = a1*b1
+    yfpsub(t2, t0, t3);
+    yfpsub(t3, t1, c[1]);                           // c1 = a0*b1+a1*b0
+    yfpsub(t0, t1, c[0]);                           // c0 = a0*b0-a1*b1
+}
+
+
+static AVX2_TARGET void yfp2sqr_mont(const yfelm_t* a, yfelm_t* c)
+{ // GF(p503^2) squaring using Montgomery arithmetic, c = a^2 in GF(p503^2).
+  // Inputs: a = a0+a1*i, where a0, a1 are in [0, 2*p503-1]
+  // Output: c = c0+c1*i, where c0, c1 are in [0, 2*p503-1]
+    yfelm_t t0, t1, t2;
+
+    yfpadd(a[0], a[1], t0);                         // t0 = a0+a1
+    yfpsub(a[0], a[1], t1);                         // t1 = a0-a1
+    yfpadd(a[0], a[0], t2);                         // t2 = 2a0
+    yfpmul_mont(t2, a[1], c[1]);                    // c1 = 2a0*a1
+    yfpmul_mont(t0, t1, c[0]);                      // c0 = (a0+a1)(a0-a1)
+}
+
+
+static AVX2_TARGET void yfp_load(__m256i* r, const digit_t* const* a)
+{ // Lane k of r <- the GF(p503) element at a[k], still in the scalar Montgomery representation
+    uint64_t t[AVX2_LANES][NLIMBS29], u[NLIMBS29][AVX2_LANES];
+    unsigned int i, k;
+
+    for (k = 0; k < AVX2_LANES; k++) {
+        avx2_repack((const uint64_t*)a[k], 64, NWORDS64_FIELD, t[k], 29, NLIMBS29);
+    }
+    for (i = 0; i < NLIMBS29; i++) {
+        for (k = 0; k < AVX2_LANES; k++) {
+            u[i][k] = t[k][i];
+        }
+        memcpy(&r[i], u[i], sizeof(u[i]));
+    }
+}
+
+
+static AVX2_TARGET void yfp2_load(yfelm_t* r, const felm_t* const* a)
+{ // Lane k of r <- the GF(p503^2) element at a[k], converted from the scalar Montgomery representation.
+  // Input: a[k] in [0, 2*p503-1]
+  // Output: r in [0, 2*p503-1]
+    const digit_t* a0[AVX2_LANES], *a1[AVX2_LANES];
+    yfelm_t c;
+    unsigned int k;
+
+    for (k = 0; k < AVX2_LANES; k++) {
+        a0[k] = a[k][0];
+        a1[k] = a[k][1];
+    }
+    for (k = 0; k < NLIMBS29; k++) {
+        c[k] = _mm256_set1_epi64x((long long)avx2_to_mont[k]);
+    }
+    yfp_load(r[0], a0);
+    yfp_load(r[1], a1);
+    yfpmul_mont(r[0], c, r[0]);
+    yfpmul_mont(r[1], c, r[1]);
+}
+
+
+static AVX2_TARGET void yfp2_store(const yfelm_t* a, felm_t* const* r, const unsigned int n)
+{ // The GF(p503^2) elements in lanes k < n of a -> r[k], converted to the scalar Montgomery representation in [0, p503-1]
+    uint64_t t[AVX2_LANES][NLIMBS29], u[NLIMBS29][AVX2_LANES];
+    yfelm_t b, c;
+    unsigned int i, j, k;
+
+    for (i = 0; i < NLIMBS29; i++) {
+        c[i] = _mm256_set1_epi64x((long long)avx2_from_mont[i]);
+    }
+    for (j = 0; j < 2; j++) {
+        yfpmul_mont(a[j], c, b);
+        yfpcorrection(b);
+        for (i = 0; i < NLIMBS29; i++) {
+            memcpy(u[i], &b[i], sizeof(u[i]));
+            for (k = 0; k < AVX2_LANES; k++) {
+                t[k][i] = u[i][k];
+            }
+        }
+        for (k = 0; k < n; k++) {
+            avx2_repack(t[k], 29, NLIMBS29, (uint64_t*)r[k][j], 64, NWORDS64_FIELD);
+        }
+    }
+}
+
+
+static AVX2_TARGET void yfp2_set(yfelm_t* r, const f2elm_t a)
+{ // All lanes of r <- a
+    const felm_t* p[AVX2_LANES];
+    unsigned int k;
+
+    for (k = 0; k < AVX2_LANES; k++) {
+        p[k] = a;
+    }
+    yfp2_load(r, p);
+}
+
+
+static AVX2_TARGET void yfp2_one(yfelm_t* r)
+{ // All lanes of r <- 1 in GF(p503^2)
+    unsigned int i;
+
+    for (i = 0; i < NLIMBS29; i++) {
+        r[0][i] = _mm256_set1_epi64x((long long)avx2_one[i]);
+        r[1][i] = _mm256_setzero_si256();
+    }
+}
+
+#endif
@@ -0,0 +1,39 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: AVX2 engine of the batch functions, the ladder and the tree traversal of 4 independent
+*           operations of one party computed in the lanes of the vector arithmetic of fp_avx2.c
+*********************************************************************************************/
+
+#include "../P503_internal.h"
+
+#if defined(AVX2)
+
+#define LANE(name)              y##name
+#define LANE_API(name)          name##_avx2
+#define LANE_TARGET             AVX2_TARGET
+#define LANES                   AVX2_LANES
+#define LANE_LIMBS              NLIMBS29
+#define lane_t                  __m256i
+#define LANE_ZERO()             _mm256_setzero_si256()
+#define LANE_ONE()              _mm256_set1_epi64x(1)
+#define LANE_AND(a, b)          _mm256_and_si256(a, b)
+#define LANE_XOR(a, b)          _mm256_xor_si256(a, b)
+#define LANE_SUB(a, b)          _mm256_sub_epi64(a, b)
+#define LANE_SRLI(a, n)         _mm256_srli_epi64(a, n)
+
+#include "sidh_lanes.c"
+
+
+int avx2_available(void)
+{ // CPUID and OS support of AVX2, checked on the first call
+    static int available = -1;
+
+    if (available < 0) {
+        __builtin_cpu_init();
+        available = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return available;
+}
+
+#endif
@@ -63,6 +63,10 @@ const uint64_t Montgomery_one[NWORDS64_FIELD]    = { 0x00000000000003F9, 0x00000
                                                      0x63CB1A6EA6DED2B4, 0x51689D8D667EB37D, 0x8ACD77C71AB24142, 0x0026FBAEC60F5953 };
 
 
+// Precomputed multiples of the generators QA and QB for the fixed-base ladders
+#include "P503_tables.h"
+
+
 // Fixed parameters for isogeny tree computation
 const unsigned int strat_Alice[MAX_Alice-1] = { 
 61, 32, 16, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1, 
@@ -79,6 +83,11 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 2, 1, 1, 8, 4, 2, 1, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 16, 8, 4, 2, 1, 1, 1, 2, 
 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1 };
            
+#if defined(THREADS)
+// Strategies of the overlapped traversal of the host thread pool
+#include "P503_strategies.h"
+#endif
+
 // Setting up macro defines and including GF(p), GF(p^2), curve, isogeny and kex functions
 #define fpcopy                        fpcopy503
 #define fpzero                        fpzero503
@@ -103,6 +112,52 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define fp2sqr_mont                   fp2sqr503_mont
 #define fp2inv_mont                   fp2inv503_mont
 #define fp2inv_mont_bingcd            fp2inv503_mont_bingcd
+#define op_count                      op_count503
+#define op_count_phase                op_count_phase503
+#define op_count_snapshot             op_count_snapshot503
+#define op_count_reset                op_count_reset503
+#define strategy_check                strategy_check503
+#define strategy_set                  strategy_set503
+#define strategy_get                  strategy_get503
+#define pool_start                    pool_start503
+#define pool_stop                     pool_stop503
+#define pool_begin                    pool_begin503
+#define pool_submit                   pool_submit503
+#define pool_join                     pool_join503
+#define pool_call                     pool_call503
+#define pool_end                      pool_end503
+#define ifma_available                ifma_available503
+#define KeyGeneration_ifma            KeyGeneration_ifma503
+#define SecretAgreement_ifma          SecretAgreement_ifma503
+#define avx2_available                avx2_available503
+#define KeyGeneration_avx2            KeyGeneration_avx2503
+#define SecretAgreement_avx2          SecretAgreement_avx2503
+#define keypool_config                keypool_config503
+#define keypool_take                  keypool_take503
+#define keypool_refill                keypool_refill503
+#define keypool_size                  keypool_size503
+#define keypool_flush                 keypool_flush503
+#define keypool_start                 keypool_start503
+#define keypool_stop                  keypool_stop503
+#define kemsvc_start                  kemsvc_start503
+#define kemsvc_stop                   kemsvc_stop503
+#define kemsvc_submit                 kemsvc_submit503
+#define kemsvc_drain                  kemsvc_drain503
+#define kemsvc_stats                  kemsvc_stats503
+#define ladder_cache_config           ladder_cache_config503
+#define ladder_cache_flush            ladder_cache_flush503
+#define ladder_cache_stats            ladder_cache_stats503
+#define ladder_cache_acquire          ladder_cache_acquire503
+#define ladder_cache_release          ladder_cache_release503
+#define fixed_base_tables             fixed_base_tables503
+#define table_file_load               table_file_load503
+#define trace_set_clock               trace_set_clock503
+#define trace_record                  trace_record503
+#define trace_reset                   trace_reset503
+#define trace_export_json             trace_export_json503
+#define trace_clock_dwt               trace_clock_dwt503
+#define trace_clock_rdtsc             trace_clock_rdtsc503
+#define trace_clock_gettime           trace_clock_gettime503
 #define fpequal_non_constant_time     fpequal503_non_constant_time
 #define mp_add_asm                    mp_add503_asm
 #define mp_subx2_asm                  mp_sub503x2_asm
@@ -111,4 +166,15 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #include "fpx.c"
 #include "ec_isogeny.c"
 #include "sidh.c"
-#include "sike.c"
\ No newline at end of file
+#include "sike.c"
+#include "trace.c"
+#include "pool.c"
+#include "keypool.c"
+#include "kemsvc.c"
+#include "compression.c"
+#include "laddercache.c"
+#include "tablefile.c"
+#include "AMD64/fp_ifma.c"
+#include "AMD64/sidh_ifma.c"
+#include "AMD64/fp_avx2.c"
+#include "AMD64/sidh_avx2.c"
\ No newline at end of file
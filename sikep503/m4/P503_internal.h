@@ -38,6 +38,7 @@
 #define MAXWORDS_ORDER          ((MAXBITS_ORDER+RADIX-1)/RADIX)     // Max. number of words to represent elements in [1, oA-1] or [1, oB].
 #define ALICE                   0
 #define BOB                     1 
+#define BOB_FULL                2       // LADDER3PT on any scalar modulo oB
 #define OALICE_BITS             250  
 #define OBOB_BITS               253     
 #define OBOB_EXPON              159    
@@ -130,6 +131,7 @@ void fpdiv2_503(const digit_t* a, digit_t* c);
 
 // Modular correction to reduce field element a in [0, 2*p503-1] to [0, p503-1].
 void fpcorrection503(digit_t* a);
+void fpcorrection503_asm(digit_t* a);
 
 // 503-bit Montgomery reduction, c = a mod p
 void rdc_mont(const digit_t* a, digit_t* c);
@@ -198,7 +200,7 @@ void fp2inv503_mont(f2elm_t a);
 // GF(p503^2) inversion, a = (a0-i*a1)/(a0^2+a1^2), GF(p503) inversion done using the binary GCD 
 void fp2inv503_mont_bingcd(f2elm_t a);
 
-// n-way Montgomery inversion
+// n-way Montgomery inversion, out[i] = 1/vec[i] with a single GF(p^2) inversion, vec and out cannot overlap
 void mont_n_way_inv(const f2elm_t* vec, const int n, f2elm_t* out);
 
 /************ Elliptic curve and isogeny functions *************/
@@ -206,8 +208,11 @@ void mont_n_way_inv(const f2elm_t* vec, const int n, f2elm_t* out);
 // Computes the j-invariant of a Montgomery curve with projective constant.
 void j_inv(const f2elm_t A, const f2elm_t C, f2elm_t jinv);
 
+// Inversion-free variant of j_inv, j = num/den.
+void j_inv_proj(const f2elm_t A, const f2elm_t C, f2elm_t num, f2elm_t den);
+
 // Simultaneous doubling and differential addition.
-void xDBLADD(point_proj_t P, point_proj_t Q, const f2elm_t xPQ, const f2elm_t A24);
+void xDBLADD(point_proj_t P, point_proj_t Q, const f2elm_t xPQ, const f2elm_t A24plus, const felm_t C24);
 
 // Doubling of a Montgomery point in projective coordinates (X:Z).
 void xDBL(const point_proj_t P, point_proj_t Q, const f2elm_t A24plus, const f2elm_t C24);
@@ -239,8 +244,503 @@ void eval_3_isog(point_proj_t Q, const f2elm_t* coeff);
 // 3-way simultaneous inversion
 void inv_3_way(f2elm_t z1, f2elm_t z2, f2elm_t z3);
 
+// Simultaneous conversion of n projective points to affine x-coordinates, x[i] = X_i/Z_i, z is scratch for n elements
+void proj_to_affine(point_proj_t* P, const int n, f2elm_t* x, f2elm_t* z);
+
 // Given the x-coordinates of P, Q, and R, returns the value A corresponding to the Montgomery curve E_A: y^2=x^3+A*x^2+x such that R=Q-P on E_A.
 void get_A(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xR, f2elm_t A);
 
+// Inversion-free variant of get_A, returns the projective coefficients (A:C) of the same curve, with C in GF(p).
+void get_A_proj(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xR, f2elm_t A, f2elm_t C);
+
+
+/************ Isogeny strategies *************/
+
+// Strategy of a tree traversal: the preorder list of the nisog-1 walk lengths (xDBLe/xTPLe steps
+// between two stored points) for nisog = MAX_Alice or MAX_Bob isogenies, storing at most
+// MAX_INT_POINTS_ALICE/BOB points. Tables are generated with tools/gen_strategy.py
+typedef struct { const unsigned int* table; unsigned int nisog; } strategy_t;
+
+// SIDH operations with their own strategy. Key generation pushes three more points through every
+// isogeny, these evaluations do not depend on the strategy and the defaults of both paths share a table
+#define STRATEGY_KEYGEN_A       0
+#define STRATEGY_KEYGEN_B       1
+#define STRATEGY_AGREEMENT_A    2
+#define STRATEGY_AGREEMENT_B    3
+#define STRATEGY_OPS            4
+
+// Checks that strategy is a valid traversal of nisog isogenies. Returns 0 on success, 1 otherwise
+int strategy_check503(const strategy_t* strategy, const unsigned int nisog);
+
+// Registers the strategy used by operation op (STRATEGY_KEYGEN_A, ...), strategy = NULL restores the default.
+// The descriptor and its table are not copied. Returns 0 on success, 1 if op or strategy is invalid
+int strategy_set503(const unsigned int op, const strategy_t* strategy);
+
+// Strategy currently registered for operation op, NULL if op is invalid
+const strategy_t* strategy_get503(const unsigned int op);
+
+// SIDH functions with an explicit strategy, strategy = NULL selects the registered one.
+// They return 1 without computing anything if the strategy is invalid
+int EphemeralKeyGeneration_A_strategy(const unsigned char* PrivateKeyA, unsigned char* PublicKeyA, const strategy_t* strategy);
+int EphemeralKeyGeneration_B_strategy(const unsigned char* PrivateKeyB, unsigned char* PublicKeyB, const strategy_t* strategy);
+int EphemeralSecretAgreement_A_strategy(const unsigned char* PrivateKeyA, const unsigned char* PublicKeyB, unsigned char* SharedSecretA, const strategy_t* strategy);
+int EphemeralSecretAgreement_B_strategy(const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, unsigned char* SharedSecretB, const strategy_t* strategy);
+
+/************ Batch operations *************/
+
+// The batch functions process n independent operations, PrivateKey[i], PublicKey[i] and SharedSecret[i] pointing
+// to the keys of operation i. Their outputs are identical to n calls of the single functions. Each chunk of up
+// to SIDH_BATCH operations shares the final inversion: the affine conversion of the public keys and the division
+// of the j-invariants. The normalization inputs of a chunk are stored as contiguous arrays of GF(p^2) elements
+
+#ifndef SIDH_BATCH
+    #define SIDH_BATCH          8
+#endif
+
+int EphemeralKeyGeneration_A_batch(const unsigned char* const* PrivateKeyA, unsigned char* const* PublicKeyA, const unsigned int n);
+int EphemeralKeyGeneration_B_batch(const unsigned char* const* PrivateKeyB, unsigned char* const* PublicKeyB, const unsigned int n);
+int EphemeralSecretAgreement_A_batch(const unsigned char* const* PrivateKeyA, const unsigned char* const* PublicKeyB, unsigned char* const* SharedSecretA, const unsigned int n);
+int EphemeralSecretAgreement_B_batch(const unsigned char* const* PrivateKeyB, const unsigned char* const* PublicKeyA, unsigned char* const* SharedSecretB, const unsigned int n);
+
+
+/************ Expanded public keys *************/
+
+// Bob's public key decoded once for repeated shared secret computations of Alice (crypto_kem_pk_expand): the images
+// of Bob's basis in Montgomery form and the constants A24plus = A+2C, C24 = 4C of their curve, C in GF(p)
+typedef struct { f2elm_t PKB[3]; f2elm_t A24plus; f2elm_t C24; } pk_expanded_B_t;
+
+void PublicKeyExpand_B(const unsigned char* PublicKeyB, pk_expanded_B_t* PublicKeyBx);
+int EphemeralSecretAgreement_A_expanded(const unsigned char* PrivateKeyA, const pk_expanded_B_t* PublicKeyBx, unsigned char* SharedSecretA);
+
+
+/************ Ladder cache *************/
+
+// With -D _LADDER_CACHE_ Alice's shared secret computation keeps, for public keys of Bob used repeatedly, the table
+// of the affine x([2^i]Q) of the key, on which the three-point ladder runs right to left with one differential
+// addition per bit (LADDER3PT_FB) instead of a doubling and an addition. A table is built on the second miss of a key
+// among the last LADDER_CACHE_GHOSTS ones, and the least recently used tables are evicted to stay within the byte
+// budget. Whether a table is used depends on the public key only, the ladder is constant time in the secret key.
+// On the M4 the cache is for a single thread
+
+#if defined(LADDER_CACHE)
+
+#ifndef LADDER_CACHE_BYTES
+    #if (TARGET == TARGET_ARM)
+        #define LADDER_CACHE_BYTES  1           // Rounded up to a single table
+    #else
+        #define LADDER_CACHE_BYTES  (4 << 20)   // Upper bound of the budget set at run time
+    #endif
+#endif
+#ifndef LADDER_CACHE_GHOSTS
+    #define LADDER_CACHE_GHOSTS     16
+#endif
+
+typedef struct {
+    uint64_t hits, misses, builds, evictions;   // Ladders on a table, ladders without one, tables built, evicted
+    uint64_t entries, bytes, budget;            // Tables held, their memory, memory allowed by the budget
+} ladder_cache_stats_t;
+
+// Sets the memory budget of the tables, at most LADDER_CACHE_BYTES, and evicts the tables beyond it. Returns the
+// budget in use, a multiple of the size of a table (OALICE_BITS+3 GF(p^2) elements and a few words)
+size_t ladder_cache_config503(const size_t bytes);
+
+// Evicts all tables, e.g. when the keys of the peers are rotated
+void ladder_cache_flush503(void);
+
+// Copies the counters to stats, then clears hits, misses, builds and evictions if reset != 0
+void ladder_cache_stats503(ladder_cache_stats_t* stats, const unsigned int reset);
+
+// Table of the ladder on PublicKeyBx or NULL, and its release once the ladder is done (used by sidh.c)
+const f2elm_t* ladder_cache_acquire503(const pk_expanded_B_t* PublicKeyBx);
+void ladder_cache_release503(const f2elm_t* table);
+
+#endif
+
+
+/************ Table files *************/
+
+// With -D _TABLE_FILE_ (host library only) the fixed-base tables of the key generation ladders can be read from a
+// file written by tools/gen_ladder_tables.py --file, mapped read-only and shared through the page cache by all the
+// processes loading it. The file is a table_file_header_t followed by Alice's table, 2*bits_alice*NWORDS64_FIELD
+// words, and Bob's, bits_bob*NWORDS64_FIELD words, in 64-bit little-endian words and Montgomery representation.
+// Until a file is loaded the tables of P503_tables.h are used
+
+#if defined(TABLE_FILE)
+
+#define TABLE_FILE_MAGIC        "SIKETBL"       // 8 bytes with the terminating zero
+#define TABLE_FILE_VERSION      1
+
+// Results of table_file_load503
+#define TABLE_FILE_OK           0
+#define TABLE_FILE_ERR_IO       -1              // File missing, unreadable, shorter than a header or not mappable
+#define TABLE_FILE_ERR_FORMAT   -2              // Other magic or version, or size not matching the header
+#define TABLE_FILE_ERR_PARAMS   -3              // Other parameter set, or more entries than the scalars have bits
+#define TABLE_FILE_ERR_CHECKSUM -4
+#define TABLE_FILE_ERR_LOADED   -5              // A file is already in use
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t prime;                             // 503
+    uint32_t nwords64;                          // NWORDS64_FIELD
+    uint32_t bits_alice, bits_bob;              // Entries of the tables, at most OALICE_BITS and OBOB_BITS-1
+    uint32_t reserved;                          // Zero
+    uint64_t params;                            // FNV-1a hash of the generators A_gen and B_gen of P503.c
+    uint64_t checksum;                          // FNV-1a hash of the tables
+} table_file_header_t;
+
+typedef struct {
+    const uint64_t* A;                          // Affine x([2^i]QA), NULL if bits_alice = 0
+    const uint64_t* B;                          // Affine x([2^i]QB) in GF(p), NULL if bits_bob = 0
+    unsigned int bits_alice, bits_bob;
+} fixed_base_tables_t;
+
+// Tables in use by the key generation ladders, those of P503_tables.h until a file is loaded
+const fixed_base_tables_t* fixed_base_tables503(void);
+
+// Maps the table file at path and, once it is checked, switches the ladders to its tables. Returns TABLE_FILE_OK or
+// one of the errors above, in which case the tables in use are unchanged. A single file can be loaded, e.g. at the
+// start of a worker process, and stays mapped until exit. The mapping is shared and its checksum is only checked
+// here: a loaded file must be replaced (renamed over, as gen_ladder_tables.py does), never modified in place
+int table_file_load503(const char* path);
+
+#endif
+
+
+/************ Host thread pool *************/
+
+// With -D _THREADS_ (host library only) the point evaluations of the tree traversal, eval_4_isog/eval_3_isog
+// on the stored points and, in key generation, on the three basis images, are spread over a pool of worker
+// threads pinned to distinct cores. Without running workers they are evaluated sequentially. With workers the
+// traversal overlaps them with the walk to the next kernel point, following the strategies of P503_strategies.h
+// optimized for the thread count (tools/gen_strategy.py --cores). Encapsulation runs its two independent
+// operations, EphemeralKeyGeneration_A and EphemeralSecretAgreement_A, concurrently when workers are running
+
+#if defined(THREADS)
+
+#ifndef POOL_MAX_WORKERS
+    #define POOL_MAX_WORKERS    7
+#endif
+
+// Starts nworkers worker threads, restarting a running pool. nworkers = 0 starts one per additional online core.
+// Returns the number of running workers, 0 on a single core
+unsigned int pool_start503(unsigned int nworkers);
+
+// Stops the workers
+void pool_stop503(void);
+
+// Reserves the workers for one operation. Returns the number of threads including the caller, 0 if there are
+// no workers or another operation holds them
+unsigned int pool_begin503(void);
+
+// Starts the evaluation of pts and phi on the reserved workers and returns. The points and coeff must not be
+// touched until pool_join503(), which waits for the evaluation to complete
+void pool_submit503(const unsigned int deg, point_proj_t* pts, const unsigned int npts, point_proj_t* phi, const unsigned int nphi, const f2elm_t* coeff);
+void pool_join503(void);
+
+// Starts fn(arg) on one of the reserved workers and returns, pool_join503() waits for it to return. Traversals
+// run by fn or by the caller in the meantime do not get workers and are sequential
+void pool_call503(void (*fn)(void*), void* arg);
+
+// Joins and releases the workers
+void pool_end503(void);
+
+#endif
+
+
+/************ AVX-512 IFMA engine *************/
+
+// With -D _IFMA_ (host library only) the batch functions compute the ladders and tree traversals of IFMA_LANES
+// operations at once, each in one 64-bit lane of AVX-512 registers with GF(p) elements in radix 2^52 for the
+// vpmadd52luq/vpmadd52huq multiply-adds. The functions are compiled for AVX-512 individually and used only if
+// ifma_available503() reports CPU support, otherwise the batch functions run the scalar backend
+
+#if defined(IFMA)
+
+#define IFMA_LANES          8
+
+// Returns 1 if the CPU supports AVX-512F and AVX-512 IFMA
+int ifma_available503(void);
+
+// Key generation of Alice (alice = 1) or Bob (alice = 0) for the n keys PrivateKey[i] up to the normalization.
+// Output: the images phi[3*i..3*i+2] of the other party's basis in projective coordinates
+void KeyGeneration_ifma503(const unsigned int alice, const unsigned char* const* PrivateKey, point_proj_t* phi, const unsigned int n);
+
+// Shared secret computation of Alice or Bob for the n key pairs (PrivateKey[i], PublicKey[i]) up to the normalization.
+// Output: the projective constants (jA[i]:jC[i]) of the curves whose j-invariants are the shared secrets
+void SecretAgreement_ifma503(const unsigned int alice, const unsigned char* const* PrivateKey, const unsigned char* const* PublicKey, f2elm_t* jA, f2elm_t* jC, const unsigned int n);
+
+#endif
+
+
+/************ AVX2 engine *************/
+
+// With -D _AVX2_ (host library only) the batch functions compute AVX2_LANES operations at once in the 64-bit lanes
+// of AVX2 registers, with GF(p) elements in radix 2^29 for the 32x32-bit vpmuludq multiplications. It is used for
+// the chunks the IFMA engine does not take, if avx2_available503() reports CPU support
+
+#if defined(AVX2)
+
+#define AVX2_LANES          4
+
+// Returns 1 if the CPU supports AVX2
+int avx2_available503(void);
+
+// As KeyGeneration_ifma503() and SecretAgreement_ifma503()
+void KeyGeneration_avx2503(const unsigned int alice, const unsigned char* const* PrivateKey, point_proj_t* phi, const unsigned int n);
+void SecretAgreement_avx2503(const unsigned int alice, const unsigned char* const* PrivateKey, const unsigned char* const* PublicKey, f2elm_t* jA, f2elm_t* jC, const unsigned int n);
+
+#endif
+
+
+/************ Keypair pool *************/
+
+// With -D _KEYPOOL_ crypto_kem_keypair pops a precomputed key pair from a pool instead of running Bob's key
+// generation, and generates it itself only when the pool is empty. Once a take leaves fewer than threshold key
+// pairs, the pool is refilled up to capacity, by low-priority worker threads on the host (keypool_start503) or by
+// keypool_refill503 called from the idle task of an RTOS. Slots are zeroized when their key pair is taken or evicted
+
+#if defined(KEYPOOL)
+
+#ifndef KEYPOOL_CAPACITY
+    #define KEYPOOL_CAPACITY    16          // Number of slots, upper bound of the capacity set at run time
+#endif
+#ifndef KEYPOOL_THRESHOLD
+    #define KEYPOOL_THRESHOLD   (KEYPOOL_CAPACITY/2)
+#endif
+#ifndef KEYPOOL_MAX_WORKERS
+    #define KEYPOOL_MAX_WORKERS 4
+#endif
+
+// Sets the number of key pairs kept, at most KEYPOOL_CAPACITY, and the fill level below which refilling starts,
+// between 1 (refill when empty) and capacity (refill after every take). Key pairs beyond capacity are evicted
+void keypool_config503(unsigned int capacity, unsigned int threshold);
+
+// Moves a key pair to pk and sk and zeroizes its slot. Returns 0, or -1 if the pool is empty.
+// Lock-free, for a single consumer thread; it never waits for the producers
+int keypool_take503(unsigned char* pk, unsigned char* sk);
+
+// Generates key pairs for empty slots if a refill is due, one per call on the M4 and up to SIDH_BATCH on the host.
+// Returns the number of key pairs added, 0 once the pool is full again
+unsigned int keypool_refill503(void);
+
+// Number of key pairs ready to be taken
+unsigned int keypool_size503(void);
+
+// Zeroizes and discards the key pairs of the pool and starts a refill, e.g. after a fork() or, with the workers
+// stopped, at shutdown
+void keypool_flush503(void);
+
+#if (TARGET != TARGET_ARM)
+// Starts nworkers refill threads in the SCHED_IDLE class, restarting running ones. nworkers = 0 starts one per
+// online core, up to KEYPOOL_MAX_WORKERS. Returns the number of running workers, always 0 with _TRACE_
+unsigned int keypool_start503(unsigned int nworkers);
+
+// Stops the workers, the key pairs stay in the pool
+void keypool_stop503(void);
+#endif
+
+#endif
+
+
+/************ KEM service *************/
+
+// With -D _KEMSVC_ (host library only) encapsulations and decapsulations can be submitted as jobs to a service of
+// worker threads pinned to distinct cores. A job is queued on the deque of the worker of the submitting core, the
+// worker runs its deque oldest first and idle workers steal from the newest end of the others. A worker finding
+// several jobs of the same kind at the front of its deque runs up to max_batch of them with the batch functions.
+// Without running workers jobs run on the caller during kemsvc_submit503()
+
+#if defined(KEMSVC)
+
+#ifndef KEMSVC_MAX_WORKERS
+    #define KEMSVC_MAX_WORKERS  64
+#endif
+#ifndef KEMSVC_QUEUE
+    #define KEMSVC_QUEUE        64          // Jobs queued per worker, beyond which kemsvc_submit503 refuses jobs
+#endif
+#define KEMSVC_HISTOGRAM        32          // Bucket i counts latencies from 2^i to 2^(i+1) microseconds, bucket 0 from 0
+
+#define KEMSVC_ENC              0
+#define KEMSVC_DEC              1
+
+typedef struct kemsvc_job {
+    unsigned int op;                        // KEMSVC_ENC: ct, ss <- pk. KEMSVC_DEC: ss <- ct, sk
+    unsigned char* ct;
+    unsigned char* ss;
+    const unsigned char* pk;
+    const unsigned char* sk;
+    void (*done)(struct kemsvc_job* job);   // Called on the worker when the job is complete, may be NULL
+    void* arg;                              // For the caller
+    int status;                             // Set by the service: return value of the KEM function,
+    unsigned int batch;                     //   number of jobs run together, this one included,
+    uint64_t submitted, started, completed; //   CLOCK_MONOTONIC in nanoseconds
+} kemsvc_job_t;
+
+typedef struct {
+    uint64_t jobs, batched, stolen, rejected;   // Completed, completed in a batch of two or more, stolen, refused
+    uint64_t wait_ns, run_ns, max_ns;           // Sums of queueing and run times, longest submit-to-completion time
+    uint64_t histogram[KEMSVC_HISTOGRAM];       // Submit-to-completion times
+} kemsvc_stats_t;
+
+// Starts nworkers workers, restarting a running service. nworkers = 0 starts one per online core. max_batch
+// (at most SIDH_BATCH, 0 = SIDH_BATCH) bounds the jobs run together, 1 runs every job on its own.
+// Returns the number of running workers, always 0 with _TRACE_
+unsigned int kemsvc_start503(unsigned int nworkers, unsigned int max_batch);
+
+// Waits for the submitted jobs and stops the workers
+void kemsvc_stop503(void);
+
+// Queues job, which must stay valid until its done callback. Returns 0, or -1 if the deques are full, in which
+// case the caller has to retry later or run the operation itself
+int kemsvc_submit503(kemsvc_job_t* job);
+
+// Waits until no submitted job is pending
+void kemsvc_drain503(void);
+
+// Copies the counters of the service to stats, then clears them if reset != 0
+void kemsvc_stats503(kemsvc_stats_t* stats, const unsigned int reset);
+
+#endif
+
+
+/************ Compressed keys *************/
+
+// With -D _COMPRESS_ the *_compressed functions exchange public keys made of the curve coefficient A and of the
+// coordinates of the images of the basis of the other party in a deterministic basis (R0, R1) of that torsion on
+// the curve, found among the points with x = 1+k*i and identified by the two k's. The coordinates are discrete
+// logarithms of Tate pairings, divided by one of them. The shared secret computation combines them with the secret
+// key into a single kernel point, computed by one ladder on (R0, R1) in constant time in the secret key
+
+#if defined(COMPRESS)
+
+#define COMPRESSED_PKA_BYTES    (FP2_ENCODED_BYTES + 3*NBITS_TO_NBYTES(OBOB_BITS) + 3)      // Alice's public key, on the images of Bob's basis
+#define COMPRESSED_PKB_BYTES    (FP2_ENCODED_BYTES + 3*NBITS_TO_NBYTES(OALICE_BITS) + 3)    // Bob's public key, on the images of Alice's basis
+
+// Key generation with compression. They return 1 if no basis is found, which has a negligible probability
+int EphemeralKeyGeneration_A_compressed(const unsigned char* PrivateKeyA, unsigned char* PublicKeyA);
+int EphemeralKeyGeneration_B_compressed(const unsigned char* PrivateKeyB, unsigned char* PublicKeyB);
+
+// Shared secret computation on a compressed public key. They return 1 if the basis of the key cannot be rebuilt
+int EphemeralSecretAgreement_A_compressed(const unsigned char* PrivateKeyA, const unsigned char* PublicKeyB, unsigned char* SharedSecretA);
+int EphemeralSecretAgreement_B_compressed(const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, unsigned char* SharedSecretB);
+
+// Re-encryption check of decapsulation. Returns 0 if PublicKeyA is the compressed public key of PrivateKeyA, 1 otherwise.
+// The basis is rebuilt from PublicKeyA and its coefficients are checked on pairings of the images, without compressing
+// them again: the cost only depends on PublicKeyA, and the comparison is constant time whether the keys match or not
+int EphemeralKeyVerify_A_compressed(const unsigned char* PrivateKeyA, const unsigned char* PublicKeyA);
+
+#endif
+
+
+/************ Operation counting *************/
+
+// Counted operations. The GF(p^2) functions are counted through the GF(p) functions they call,
+// except fp2mul_mont, which is a single kernel with lazy reduction
+#define OP_FPMUL                0
+#define OP_FPSQR                1
+#define OP_FP2MUL               2
+#define OP_FPADD                3
+#define OP_FPSUB                4
+#define OP_FPCORRECTION         5
+#define OP_FPINV                6
+#define OP_SWAP_POINTS          7
+#define OP_COUNT_OPS            8
+
+// Phases of the key generation and shared secret computations the counts are charged to
+#define OP_PHASE_OTHER          0       // Basis and constant initialization, decoding, hashing
+#define OP_PHASE_LADDER         1       // Three-point ladder
+#define OP_PHASE_TREE           2       // Isogeny tree traversal, including the final isogeny
+#define OP_PHASE_NORMALIZE      3       // Conversion to affine coordinates or j-invariant, and encoding
+#define OP_COUNT_PHASES         4
+
+#if defined(OP_COUNT)
+
+// Counters of the current phase, incremented at the entry of the counted functions
+extern uint32_t op_count503[OP_COUNT_OPS];
+
+// Charges the operations counted so far to the current phase, then switches to the given phase
+void op_count_phase503(const unsigned int phase);
+
+// Copies the per-phase counts accumulated since the last reset
+void op_count_snapshot503(uint32_t counts[OP_COUNT_PHASES][OP_COUNT_OPS]);
+
+// Clears all counts and switches to OP_PHASE_OTHER
+void op_count_reset503(void);
+
+#define OP_COUNT_INC(op)        (op_count503[(op)]++)
+#define OP_COUNT_PHASE(phase)   op_count_phase503(phase)
+
+// Same increment for the assembly functions, placed before their prologue. Only R12 is clobbered
+#define OP_COUNT_STR(x)         #x
+#define OP_COUNT_STRFY(x)       OP_COUNT_STR(x)
+#define OP_COUNT_ASM(op)        "PUSH {R0}                           \n\t"         \
+                                "MOVW R12, #:lower16:op_count503    \n\t"         \
+                                "MOVT R12, #:upper16:op_count503    \n\t"         \
+                                "LDR R0, [R12, #4*" OP_COUNT_STRFY(op) "]     \n\t" \
+                                "ADD R0, R0, #1                      \n\t"         \
+                                "STR R0, [R12, #4*" OP_COUNT_STRFY(op) "]     \n\t" \
+                                "POP {R0}                            \n\t"
+
+#else
+
+#define OP_COUNT_INC(op)
+#define OP_COUNT_PHASE(phase)
+#define OP_COUNT_ASM(op)        ""
+
+#endif
+
+
+/************ Phase tracing *************/
+
+// Begin/end events of the KEM operations, SIDH functions and their phases are recorded in a ring
+// buffer of TRACE_EVENTS entries when built with -D _TRACE_. Timestamps are raw ticks of the clock
+// selected with trace_set_clock503(), converted to microseconds when exported.
+
+#if defined(TRACE)
+
+#ifndef TRACE_EVENTS
+    #define TRACE_EVENTS        128
+#endif
+
+typedef uint64_t (*trace_clock_t)(void);
+
+typedef struct { const char* name; uint64_t ts; uint32_t begin; } trace_event_t;
+
+// Selects the timestamp source and its rate, clock = NULL restores the default of the target
+// (DWT cycle counter at TRACE_CLOCK_MHZ on ARM, clock_gettime on the host)
+void trace_set_clock503(trace_clock_t clock, const uint32_t ticks_per_us);
+
+// Records a begin (begin = 1) or end (begin = 0) event, name must be a string with static storage
+void trace_record503(const char* name, const unsigned int begin);
+
+// Discards all events
+void trace_reset503(void);
+
+// Exports the events in the ring in Chrome trace-event JSON format (chrome://tracing, Perfetto).
+// Returns the length of the NUL-terminated output, or 0 if it does not fit in outlen bytes
+size_t trace_export_json503(char* out, const size_t outlen);
+
+#if (TARGET == TARGET_ARM)
+// Cycle counter of the Cortex-M4 DWT unit extended to 64 bits, enabled on first use
+uint64_t trace_clock_dwt503(void);
+#else
+// Time-stamp counter, its rate has to be given to trace_set_clock503()
+uint64_t trace_clock_rdtsc503(void);
+
+// CLOCK_MONOTONIC in nanoseconds
+uint64_t trace_clock_gettime503(void);
+#endif
+
+#define TRACE_BEGIN(name)       trace_record503((name), 1)
+#define TRACE_END(name)         trace_record503((name), 0)
+
+#else
+
+#define TRACE_BEGIN(name)
+#define TRACE_END(name)
+
+#endif
+
 
 #endif
\ No newline at end of file
@@ -7,6 +7,10 @@
 #ifndef __CONFIG_H__
 #define __CONFIG_H__
 
+#if (defined(_THREADS_) || defined(_KEYPOOL_) || defined(_KEMSVC_)) && defined(_AMD64_) && !defined(_GNU_SOURCE)
+    #define _GNU_SOURCE                 // pthread_setaffinity_np, sched_getcpu and SCHED_IDLE, before the first system header
+#endif
+
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
@@ -27,10 +31,17 @@
 #define TARGET_ARM          3
 #define TARGET_ARM64        4
 
-#define TARGET TARGET_ARM
-#define RADIX           32
-#define LOG2RADIX       5  
-typedef uint32_t        digit_t;        // Unsigned 32-bit digit
+#if defined(_AMD64_)
+    #define TARGET TARGET_AMD64
+    #define RADIX           64
+    #define LOG2RADIX       6  
+    typedef uint64_t        digit_t;        // Unsigned 64-bit digit
+#else
+    #define TARGET TARGET_ARM
+    #define RADIX           32
+    #define LOG2RADIX       5  
+    typedef uint32_t        digit_t;        // Unsigned 32-bit digit
+#endif
 
 #define RADIX64             64
 
@@ -42,6 +53,83 @@ typedef uint32_t        digit_t;        // Unsigned 32-bit digit
 #endif
 
 
+// Selection of field inversion: constant-time safegcd by default, addition chain with _FP_INV_CHAIN_
+
+#if defined(_FP_INV_CHAIN_)
+    #define FP_INV_CHAIN
+#endif
+
+
+// Field-operation counting per KEM phase, enabled with _OP_COUNT_ (see OP_COUNT_INC in P*_internal.h)
+
+#if defined(_OP_COUNT_)
+    #define OP_COUNT
+#endif
+
+
+// Per-phase tracing with Chrome trace-event export, enabled with _TRACE_ (see TRACE_BEGIN in P*_internal.h)
+
+#if defined(_TRACE_)
+    #define TRACE
+#endif
+
+
+// Host thread pool for the isogeny evaluations of the tree traversal, enabled with _THREADS_ (see pool_start in P*_internal.h)
+
+#if defined(_THREADS_) && defined(_AMD64_)
+    #define THREADS
+#endif
+
+
+// AVX-512 IFMA engine of the batch functions on the host, enabled with _IFMA_ (see ifma_available in P*_internal.h)
+
+#if defined(_IFMA_) && defined(_AMD64_)
+    #define IFMA
+#endif
+
+
+// AVX2 engine of the batch functions on the host, enabled with _AVX2_ (see avx2_available in P*_internal.h)
+
+#if defined(_AVX2_) && defined(_AMD64_)
+    #define AVX2
+#endif
+
+
+// Pool of precomputed key pairs for crypto_kem_keypair, enabled with _KEYPOOL_ (see keypool_take in P*_internal.h)
+
+#if defined(_KEYPOOL_)
+    #define KEYPOOL
+#endif
+
+
+// Host job service for encapsulation and decapsulation, enabled with _KEMSVC_ (see kemsvc_submit in P*_internal.h)
+
+#if defined(_KEMSVC_) && defined(_AMD64_)
+    #define KEMSVC
+#endif
+
+
+// Compressed public keys and ciphertexts, enabled with _COMPRESS_ (see crypto_kem_keypair_compressed in api.h)
+
+#if defined(_COMPRESS_)
+    #define COMPRESS
+#endif
+
+
+// Tables of Alice's ladder for repeated public keys, enabled with _LADDER_CACHE_ (see ladder_cache_config in P*_internal.h)
+
+#if defined(_LADDER_CACHE_)
+    #define LADDER_CACHE
+#endif
+
+
+// Fixed-base ladder tables from memory-mapped table files on the host, enabled with _TABLE_FILE_ (see table_file_load in P*_internal.h)
+
+#if defined(_TABLE_FILE_) && defined(_AMD64_)
+    #define TABLE_FILE
+#endif
+
+
 // Extended datatype support
                      
 typedef uint64_t uint128_t[2];
@@ -0,0 +1,39 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: AVX-512 IFMA engine of the batch functions, the ladder and the tree traversal of 8 independent
+*           operations of one party computed in the lanes of the vector arithmetic of fp_ifma.c
+*********************************************************************************************/
+
+#include "../P610_internal.h"
+
+#if defined(IFMA)
+
+#define LANE(name)              v##name
+#define LANE_API(name)          name##_ifma
+#define LANE_TARGET             IFMA_TARGET
+#define LANES                   IFMA_LANES
+#define LANE_LIMBS              NLIMBS52
+#define lane_t                  __m512i
+#define LANE_ZERO()             _mm512_setzero_si512()
+#define LANE_ONE()              _mm512_set1_epi64(1)
+#define LANE_AND(a, b)          _mm512_and_si512(a, b)
+#define LANE_XOR(a, b)          _mm512_xor_si512(a, b)
+#define LANE_SUB(a, b)          _mm512_sub_epi64(a, b)
+#define LANE_SRLI(a, n)         _mm512_srli_epi64(a, n)
+
+#include "sidh_lanes.c"
+
+
+int ifma_available(void)
+{ // CPUID and OS support of AVX-512F and AVX-512 IFMA, checked on the first call
+    static int available = -1;
+
+    if (available < 0) {
+        __builtin_cpu_init();
+        available = (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512ifma")) ? 1 : 0;
+    }
+    return available;
+}
+
+#endif
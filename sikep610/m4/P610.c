@@ -63,6 +63,10 @@ const uint64_t Montgomery_one[NWORDS64_FIELD]    = { 0x00000000670CC8E6, 0x00000
                                                      0x4D99C2BD28717A3F, 0x0A4A1839A323D41C, 0xD2B62215D06AD1E2, 0x1369026E862CAF3D, 0x000000010894E964 };
 
 
+// Precomputed multiples of the generators QA and QB for the fixed-base ladders
+#include "P610_tables.h"
+
+
 // Fixed parameters for isogeny tree computation
 const unsigned int strat_Alice[MAX_Alice-1] = { 
 67, 37, 21, 12, 7, 4, 2, 1, 1, 2, 1, 1, 3, 2, 1, 1, 1, 1, 5, 3, 2, 1, 1, 1, 1, 
@@ -82,6 +86,11 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 1, 1, 2, 1, 1, 1, 4, 2, 1, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 
 1, 1 };
 
+#if defined(THREADS)
+// Strategies of the overlapped traversal of the host thread pool
+#include "P610_strategies.h"
+#endif
+
 // Setting up macro defines and including GF(p), GF(p^2), curve, isogeny and kex functions
 #define fpcopy                        fpcopy610
 #define fpzero                        fpzero610
@@ -106,6 +115,52 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define fp2sqr_mont                   fp2sqr610_mont
 #define fp2inv_mont                   fp2inv610_mont
 #define fp2inv_mont_bingcd            fp2inv610_mont_bingcd
+#define op_count                      op_count610
+#define op_count_phase                op_count_phase610
+#define op_count_snapshot             op_count_snapshot610
+#define op_count_reset                op_count_reset610
+#define strategy_check                strategy_check610
+#define strategy_set                  strategy_set610
+#define strategy_get                  strategy_get610
+#define pool_start                    pool_start610
+#define pool_stop                     pool_stop610
+#define pool_begin                    pool_begin610
+#define pool_submit                   pool_submit610
+#define pool_join                     pool_join610
+#define pool_call                     pool_call610
+#define pool_end                      pool_end610
+#define ifma_available                ifma_available610
+#define KeyGeneration_ifma            KeyGeneration_ifma610
+#define SecretAgreement_ifma          SecretAgreement_ifma610
+#define avx2_available                avx2_available610
+#define KeyGeneration_avx2            KeyGeneration_avx2610
+#define SecretAgreement_avx2          SecretAgreement_avx2610
+#define keypool_config                keypool_config610
+#define keypool_take                  keypool_take610
+#define keypool_refill                keypool_refill610
+#define keypool_size                  keypool_size610
+#define keypool_flush                 keypool_flush610
+#define keypool_start                 keypool_start610
+#define keypool_stop                  keypool_stop610
+#define kemsvc_start                  kemsvc_start610
+#define kemsvc_stop                   kemsvc_stop610
+#define kemsvc_submit                 kemsvc_submit610
+#define kemsvc_drain                  kemsvc_drain610
+#define kemsvc_stats                  kemsvc_stats610
+#define ladder_cache_config           ladder_cache_config610
+#define ladder_cache_flush            ladder_cache_flush610
+#define ladder_cache_stats            ladder_cache_stats610
+#define ladder_cache_acquire          ladder_cache_acquire610
+#define ladder_cache_release          ladder_cache_release610
+#define fixed_base_tables             fixed_base_tables610
+#define table_file_load               table_file_load610
+#define trace_set_clock               trace_set_clock610
+#define trace_record                  trace_record610
+#define trace_reset                   trace_reset610
+#define trace_export_json             trace_export_json610
+#define trace_clock_dwt               trace_clock_dwt610
+#define trace_clock_rdtsc             trace_clock_rdtsc610
+#define trace_clock_gettime           trace_clock_gettime610
 #define fpequal_non_constant_time     fpequal610_non_constant_time
 #define mp_add_asm                    mp_add610_asm
 #define mp_subx2_asm                  mp_sub610x2_asm
@@ -115,3 +170,14 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #include "ec_isogeny.c"
 #include "sidh.c"
 #include "sike.c"
+#include "trace.c"
+#include "pool.c"
+#include "keypool.c"
+#include "kemsvc.c"
+#include "compression.c"
+#include "laddercache.c"
+#include "tablefile.c"
+#include "AMD64/fp_ifma.c"
+#include "AMD64/sidh_ifma.c"
+#include "AMD64/fp_avx2.c"
+#include "AMD64/sidh_avx2.c"
@@ -0,0 +1,1221 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: public key compression. Torsion bases, Tate pairings, discrete logarithms in the groups of
+*           2^eA-th and 3^eB-th roots of unity, and decompression into the kernel point of the shared secret
+*********************************************************************************************/
+
+#include <string.h>
+#include "P610_internal.h"
+
+#if defined(COMPRESS)
+
+#define COMPRESS_NLOGS          4           // Discrete logarithms per public key
+
+typedef struct { f2elm_t x; f2elm_t y; } point_affine;                  // Affine point (x,y) on y^2 = x^3+A*x^2+x
+
+typedef struct { unsigned int alice; digit_t ninv; digit_t r2[NWORDS_ORDER]; } order_t;   // Arithmetic modulo oA = 2^eA or oB = 3^eB
+
+
+/************ Helpers over GF(p) and GF(p^2), on public values *************/
+
+static void fp2_one(f2elm_t a)
+{ // a = 1 in Montgomery representation
+    fp2zero(a);
+    fpcopy((digit_t*)&Montgomery_one, a[0]);
+}
+
+
+static bool fp_is_equal(const felm_t a, const felm_t b)
+{ // Non constant-time comparison of two field elements in [0, 2p-1]
+    felm_t t0, t1;
+    unsigned int i;
+
+    fpcopy(a, t0);
+    fpcopy(b, t1);
+    fpcorrection(t0);
+    fpcorrection(t1);
+    for (i = 0; i < NWORDS_FIELD; i++) {
+        if (t0[i] != t1[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+static bool fp2_is_equal(const f2elm_t a, const f2elm_t b)
+{ // Non constant-time comparison of two GF(p^2) elements
+    return fp_is_equal(a[0], b[0]) && fp_is_equal(a[1], b[1]);
+}
+
+
+static bool fp2_is_zero(const f2elm_t a)
+{ // Non constant-time test of a = 0
+    f2elm_t zero = {0};
+
+    return fp2_is_equal(a, zero);
+}
+
+
+static void fp_pow_sqrt(const felm_t a, felm_t c)
+{ // c = a^((p+1)/4) = a^(2^(eA-2)*3^eB), a square root of a if a is a square in GF(p)
+    felm_t t;
+    unsigned int i;
+
+    fpcopy(a, c);
+    for (i = 0; i < OALICE_BITS-2; i++) {
+        fpsqr_mont(c, c);
+    }
+    for (i = 0; i < OBOB_EXPON; i++) {
+        fpsqr_mont(c, t);
+        fpmul_mont(c, t, c);
+    }
+}
+
+
+static bool fp2_is_square(const f2elm_t a)
+{ // Is a a square in GF(p^2)? Since p = 3 mod 4, that is the case if its norm a0^2+a1^2 is a square in GF(p)
+    felm_t t0, t1;
+
+    fpsqr_mont(a[0], t0);
+    fpsqr_mont(a[1], t1);
+    fpadd(t0, t1, t0);
+    fp_pow_sqrt(t0, t1);
+    fpsqr_mont(t1, t1);
+    return fp_is_equal(t0, t1);
+}
+
+
+static int fp2_sqrt(const f2elm_t a, f2elm_t c)
+{ // c = sqrt(a), always the same root for a given a. Returns 1 if a is not a square in GF(p^2).
+  // With n = sqrt(a0^2+a1^2) in GF(p), one of (a0+n)/2 and (a0-n)/2 is a square x^2 in GF(p), and c = x+a1/(2x)*i
+    felm_t n, x2, t0, t1;
+
+    fpsqr_mont(a[0], t0);
+    fpsqr_mont(a[1], t1);
+    fpadd(t0, t1, t0);
+    fp_pow_sqrt(t0, n);
+    fpsqr_mont(n, t1);
+    if (!fp_is_equal(t0, t1)) {
+        return 1;
+    }
+
+    fpzero(t0);
+    if (fp_is_equal(a[1], t0)) {                // a in GF(p): c = sqrt(a0), or c = sqrt(-a0)*i since -1 is not a square
+        fp_pow_sqrt(a[0], c[0]);
+        fpsqr_mont(c[0], t1);
+        if (fp_is_equal(t1, a[0])) {
+            fpzero(c[1]);
+        } else {
+            fpcopy(a[0], t1);
+            fpneg(t1);
+            fp_pow_sqrt(t1, c[1]);
+            fpzero(c[0]);
+        }
+        return 0;
+    }
+
+    fpadd(a[0], n, x2);
+    fpdiv2(x2, x2);
+    fp_pow_sqrt(x2, c[0]);
+    fpsqr_mont(c[0], t1);
+    if (!fp_is_equal(t1, x2)) {
+        fpsub(a[0], n, x2);
+        fpdiv2(x2, x2);
+        fp_pow_sqrt(x2, c[0]);
+    }
+    fpadd(c[0], c[0], t0);
+    fpinv_mont(t0);
+    fpmul_mont(a[1], t0, c[1]);
+    return 0;
+}
+
+
+static void curve_rhs(const f2elm_t A, const f2elm_t x, f2elm_t c)
+{ // c = x^3+A*x^2+x = ((x+A)*x+1)*x
+    f2elm_t one;
+
+    fp2_one(one);
+    fp2add(x, A, c);
+    fp2mul_mont(c, x, c);
+    fp2add(c, one, c);
+    fp2mul_mont(c, x, c);
+}
+
+
+static void recover_y(const f2elm_t A, const point_affine* P, const f2elm_t xQ, const f2elm_t xPQ, point_affine* Q)
+{ // Q = (xQ,yQ) such that x(P-Q) = xPQ, from (yP+yQ)^2 = (xPQ+A+xP+xQ)*(xP-xQ)^2
+    f2elm_t t0, t1, t2;
+
+    fp2sub(P->x, xQ, t0);
+    fp2sqr_mont(t0, t0);
+    fp2add(xPQ, A, t1);
+    fp2add(t1, P->x, t1);
+    fp2add(t1, xQ, t1);
+    fp2mul_mont(t0, t1, t0);                    // t0 = (yP+yQ)^2
+    fp2sqr_mont(P->y, t1);
+    fp2sub(t0, t1, t0);
+    curve_rhs(A, xQ, t2);
+    fp2sub(t0, t2, t0);                         // t0 = 2*yP*yQ
+    fp2add(P->y, P->y, t1);
+    fp2inv_mont(t1);
+    fp2copy(xQ, Q->x);
+    fp2mul_mont(t0, t1, Q->y);
+}
+
+
+static void cyc_sqr(const f2elm_t a, f2elm_t c)
+{ // c = a^2 for a of norm 1: c = (2*a0^2-1) + ((a0+a1)^2-1)*i
+    felm_t t0, t1;
+
+    fpsqr_mont(a[0], t0);
+    fpadd(a[0], a[1], t1);
+    fpsqr_mont(t1, t1);
+    fpsub(t1, (digit_t*)&Montgomery_one, c[1]);
+    fpadd(t0, t0, t0);
+    fpsub(t0, (digit_t*)&Montgomery_one, c[0]);
+}
+
+
+static void cyc_cube(const f2elm_t a, f2elm_t c)
+{ // c = a^3 for a of norm 1: c = a0*(4*a0^2-3) + a1*(4*a0^2-1)*i
+    felm_t t0;
+
+    fpsqr_mont(a[0], t0);
+    fpadd(t0, t0, t0);
+    fpadd(t0, t0, t0);
+    fpsub(t0, (digit_t*)&Montgomery_one, t0);
+    fpmul_mont(a[1], t0, c[1]);
+    fpsub(t0, (digit_t*)&Montgomery_one, t0);
+    fpsub(t0, (digit_t*)&Montgomery_one, t0);
+    fpmul_mont(a[0], t0, c[0]);
+}
+
+
+static void cyc_pow_l(const unsigned int AliceOrBob, const f2elm_t a, f2elm_t c, const unsigned int k)
+{ // c = a^(2^k) for Alice's torsion, a^(3^k) for Bob's, with a of norm 1
+    unsigned int i;
+
+    fp2copy(a, c);
+    for (i = 0; i < k; i++) {
+        if (AliceOrBob == ALICE) {
+            cyc_sqr(c, c);
+        } else {
+            cyc_cube(c, c);
+        }
+    }
+}
+
+
+static void cyc_exp(const f2elm_t a, const digit_t* x, f2elm_t c)
+{ // c = a^x for a of norm 1, left to right. Not constant time, x is public
+    int i = NWORDS_ORDER*RADIX - 1;
+
+    fp2_one(c);
+    while (i >= 0 && ((x[i >> LOG2RADIX] >> (i & (RADIX-1))) & 1) == 0) {
+        i--;
+    }
+    for (; i >= 0; i--) {
+        cyc_sqr(c, c);
+        if ((x[i >> LOG2RADIX] >> (i & (RADIX-1))) & 1) {
+            fp2mul_mont(c, a, c);
+        }
+    }
+}
+
+
+/************ Arithmetic modulo the torsion orders *************/
+
+static void order_digit_mul(const digit_t a, const digit_t b, digit_t* c)
+{ // Digit multiplication, digit * digit -> 2-digit result, on half digits since digit_x_digit is only in the generic backend
+    const unsigned int h = sizeof(digit_t)*4;
+    const digit_t mask_low = (digit_t)(-1) >> h;
+    digit_t al = a & mask_low, ah = a >> h, bl = b & mask_low, bh = b >> h;
+    digit_t albl = al*bl, albh = al*bh, ahbl = ah*bl, ahbh = ah*bh, mid;
+
+    mid = (albl >> h) + (albh & mask_low) + (ahbl & mask_low);
+    c[0] = (albl & mask_low) | (mid << h);
+    c[1] = ahbh + (albh >> h) + (ahbl >> h) + (mid >> h);
+}
+
+
+static void mont_mul_order_B(const order_t* o, const digit_t* a, const digit_t* b, digit_t* c)
+{ // Montgomery multiplication modulo oB, c = a*b/2^(RADIX*NWORDS_ORDER) mod oB for a, b < oB (CIOS). Constant time
+    const digit_t* n = (const digit_t*)Bob_order;
+    digit_t t[NWORDS_ORDER+2] = {0}, d[NWORDS_ORDER], UV[2], carry, q, mask;
+    unsigned int i, j, cy, borrow;
+
+    for (i = 0; i < NWORDS_ORDER; i++) {
+        carry = 0;
+        for (j = 0; j < NWORDS_ORDER; j++) {                     // t = t+a[i]*b
+            order_digit_mul(a[i], b[j], UV);
+            ADDC(0, UV[0], carry, cy, UV[0]);
+            UV[1] += cy;
+            ADDC(0, t[j], UV[0], cy, t[j]);
+            carry = UV[1] + cy;
+        }
+        ADDC(0, t[NWORDS_ORDER], carry, cy, t[NWORDS_ORDER]);
+        t[NWORDS_ORDER+1] = cy;
+
+        q = t[0]*o->ninv;                                         // t = (t+q*oB)/2^RADIX
+        order_digit_mul(q, n[0], UV);
+        ADDC(0, t[0], UV[0], cy, UV[0]);
+        carry = UV[1] + cy;
+        for (j = 1; j < NWORDS_ORDER; j++) {
+            order_digit_mul(q, n[j], UV);
+            ADDC(0, UV[0], carry, cy, UV[0]);
+            UV[1] += cy;
+            ADDC(0, t[j], UV[0], cy, t[j-1]);
+            carry = UV[1] + cy;
+        }
+        ADDC(0, t[NWORDS_ORDER], carry, cy, t[NWORDS_ORDER-1]);
+        t[NWORDS_ORDER] = t[NWORDS_ORDER+1] + cy;
+    }
+
+    borrow = mp_sub(t, n, d, NWORDS_ORDER);                       // t < 2*oB, subtract oB unless t < oB
+    mask = 0 - (digit_t)(borrow & (1 ^ (unsigned int)t[NWORDS_ORDER]));
+    for (i = 0; i < NWORDS_ORDER; i++) {
+        c[i] = (t[i] & mask) | (d[i] & ~mask);
+    }
+}
+
+
+static void mp_mul_low(const digit_t* a, const digit_t* b, digit_t* c)
+{ // c = a*b mod 2^(RADIX*NWORDS_ORDER), schoolbook, since mp_mul has the size of the field on some targets
+    digit_t t[NWORDS_ORDER] = {0}, UV[2], carry;
+    unsigned int i, j, cy;
+
+    for (i = 0; i < NWORDS_ORDER; i++) {
+        carry = 0;
+        for (j = 0; i + j < NWORDS_ORDER; j++) {
+            order_digit_mul(a[i], b[j], UV);
+            ADDC(0, UV[0], carry, cy, UV[0]);
+            UV[1] += cy;
+            ADDC(0, t[i+j], UV[0], cy, t[i+j]);
+            carry = UV[1] + cy;
+        }
+    }
+    copy_words(t, c, NWORDS_ORDER);
+}
+
+
+static void order_reduce_A(digit_t* a)
+{ // a = a mod 2^eA
+    unsigned int i;
+
+    for (i = OALICE_BITS/RADIX; i < NWORDS_ORDER; i++) {
+        a[i] &= (i == OALICE_BITS/RADIX) ? ((digit_t)1 << (OALICE_BITS % RADIX)) - 1 : 0;
+    }
+}
+
+
+static void order_add(const order_t* o, const digit_t* a, const digit_t* b, digit_t* c)
+{ // c = a+b mod oA or oB, for a, b reduced. Constant time
+    const digit_t* n = (const digit_t*)Bob_order;
+    digit_t d[NWORDS_ORDER], mask;
+    unsigned int i;
+
+    mp_add(a, b, c, NWORDS_ORDER);
+    if (o->alice) {
+        order_reduce_A(c);
+    } else {
+        mask = 0 - (digit_t)mp_sub(c, n, d, NWORDS_ORDER);
+        for (i = 0; i < NWORDS_ORDER; i++) {
+            c[i] = (c[i] & mask) | (d[i] & ~mask);
+        }
+    }
+}
+
+
+static void order_sub(const order_t* o, const digit_t* a, const digit_t* b, digit_t* c)
+{ // c = a-b mod oA or oB, for a, b reduced. Constant time
+    const digit_t* n = (const digit_t*)Bob_order;
+    digit_t d[NWORDS_ORDER], mask;
+    unsigned int i;
+
+    mask = 0 - (digit_t)mp_sub(a, b, c, NWORDS_ORDER);
+    if (o->alice) {
+        order_reduce_A(c);
+    } else {
+        for (i = 0; i < NWORDS_ORDER; i++) {
+            d[i] = n[i] & mask;
+        }
+        mp_add(c, d, c, NWORDS_ORDER);
+    }
+}
+
+
+static void order_mul(const order_t* o, const digit_t* a, const digit_t* b, digit_t* c)
+{ // c = a*b mod oA or oB, for a, b reduced. Constant time
+    digit_t t[NWORDS_ORDER];
+
+    if (o->alice) {
+        mp_mul_low(a, b, c);
+        order_reduce_A(c);
+    } else {
+        mont_mul_order_B(o, a, b, t);
+        mont_mul_order_B(o, t, o->r2, c);
+    }
+}
+
+
+static void order_init(order_t* o, const unsigned int AliceOrBob)
+{ // Arithmetic modulo oA for Alice's torsion, oB for Bob's
+    const digit_t* n = (const digit_t*)Bob_order;
+    digit_t x;
+    unsigned int i;
+
+    o->alice = (AliceOrBob == ALICE);
+    if (o->alice == 0) {
+        x = n[0];                                           // 1/oB mod 2^RADIX by Newton's iteration, x = oB is correct
+        for (i = 0; i < 5; i++) {                           // to 3 bits and every step doubles them
+            x *= 2 - n[0]*x;
+        }
+        o->ninv = 0 - x;
+        clear_words((void*)o->r2, NWORDS_ORDER);            // 2^(2*RADIX*NWORDS_ORDER) mod oB by doublings
+        o->r2[0] = 1;
+        for (i = 0; i < 2*RADIX*NWORDS_ORDER; i++) {
+            order_add(o, o->r2, o->r2, o->r2);
+        }
+    }
+}
+
+
+static unsigned int order_is_unit(const order_t* o, const digit_t* a)
+{ // Is a invertible modulo oA or oB, i.e., odd or not divisible by 3? Constant time. As 2^16 = 1 mod 3, a mod 3 is
+  // that of the sum of its 16-bit chunks, which is folded down by 2^8, 2^4 and 2^2 = 1 mod 3 to a value in [0, 3]
+    uint32_t s = 0;
+    unsigned int i, j;
+
+    if (o->alice) {
+        return (unsigned int)(a[0] & 1);
+    }
+    for (i = 0; i < NWORDS_ORDER; i++) {
+        for (j = 0; j < RADIX; j += 16) {
+            s += (uint32_t)(a[i] >> j) & 0xFFFF;
+        }
+    }
+    s = (s & 0xFFFF) + (s >> 16);
+    s = (s & 0xFF) + (s >> 8);
+    s = (s & 0xF) + (s >> 4);
+    for (i = 0; i < 5; i++) {
+        s = (s & 0x3) + (s >> 2);
+    }
+    return is_digit_nonzero_ct((digit_t)s) & is_digit_nonzero_ct((digit_t)(s ^ 3));
+}
+
+
+static void order_inv(const order_t* o, const digit_t* a, digit_t* c)
+{ // c = 1/a mod oA or oB for a unit a, by Newton's iteration c = c*(2-a*c), which doubles the number of correct 2-adic
+  // or 3-adic digits of c = a, correct to 3 bits or 1 trit. The number of steps is fixed, the time is constant
+    digit_t t[NWORDS_ORDER], two[NWORDS_ORDER] = {2};
+    unsigned int prec = (o->alice) ? 3 : 1, e = (o->alice) ? OALICE_BITS : OBOB_EXPON;
+
+    copy_words(a, c, NWORDS_ORDER);
+    while (prec < e) {
+        order_mul(o, a, c, t);
+        order_sub(o, two, t, t);
+        order_mul(o, c, t, c);
+        prec *= 2;
+    }
+}
+
+
+static void order_power(const unsigned int AliceOrBob, const unsigned int k, digit_t* c)
+{ // c = 2^k for Alice's torsion, 3^k for Bob's
+    digit_t t[NWORDS_ORDER];
+    unsigned int i;
+
+    clear_words((void*)c, NWORDS_ORDER);
+    if (AliceOrBob == ALICE) {
+        c[k >> LOG2RADIX] = (digit_t)1 << (k & (RADIX-1));
+        return;
+    }
+    c[0] = 1;
+    for (i = 0; i < k; i++) {
+        mp_add(c, c, t, NWORDS_ORDER);
+        mp_add(c, t, c, NWORDS_ORDER);
+    }
+}
+
+
+/************ Constant-time helpers, on secret values *************/
+
+static void ct_select(const digit_t* a, const digit_t* b, digit_t* c, const digit_t mask, const unsigned int nwords)
+{ // c = a if mask = -1, c = b if mask = 0
+    unsigned int i;
+
+    for (i = 0; i < nwords; i++) {
+        c[i] = (a[i] & mask) | (b[i] & ~mask);
+    }
+}
+
+
+static digit_t fp_equal_mask(const felm_t a, const felm_t b)
+{ // Returns all ones if a = b, 0 otherwise, in constant time. a and b are in [0, 2p-1]
+    f2elm_t t = {0};
+
+    fpsub(a, b, t[0]);
+    return fp2_zero_mask(t);
+}
+
+
+static void fp2_sqrt_ct(const f2elm_t a, f2elm_t c)
+{ // c = sqrt(a) for a square a, as fp2_sqrt but in constant time, on secret values. All the candidate roots are computed
+  // and selected with masks, the root may differ from that of fp2_sqrt. c is 0 if a is not a square
+    felm_t n, x2, r0, r1, t0, t1;
+    f2elm_t c1;
+    digit_t mask;
+
+    fpsqr_mont(a[0], t0);
+    fpsqr_mont(a[1], t1);
+    fpadd(t0, t1, t0);
+    fp_pow_sqrt(t0, n);
+
+    // x = sqrt((a0+n)/2) or sqrt((a0-n)/2), c = x+a1/(2x)*i
+    fpadd(a[0], n, x2);
+    fpdiv2(x2, x2);
+    fp_pow_sqrt(x2, r0);
+    fpsqr_mont(r0, t0);
+    mask = fp_equal_mask(t0, x2);
+    fpsub(a[0], n, x2);
+    fpdiv2(x2, x2);
+    fp_pow_sqrt(x2, r1);
+    ct_select(r0, r1, c[0], mask, NWORDS_FIELD);
+    fpadd(c[0], c[0], t0);
+    fpinv_mont(t0);
+    fpmul_mont(a[1], t0, c[1]);
+
+    // a in GF(p): c = sqrt(a0), or c = sqrt(-a0)*i since -1 is not a square
+    fp_pow_sqrt(a[0], r0);
+    fpsqr_mont(r0, t0);
+    mask = fp_equal_mask(t0, a[0]);
+    fpcopy(a[0], t1);
+    fpneg(t1);
+    fp_pow_sqrt(t1, r1);
+    fpzero(t0);
+    ct_select(r0, t0, c1[0], mask, NWORDS_FIELD);
+    ct_select(t0, r1, c1[1], mask, NWORDS_FIELD);
+    mask = fp_equal_mask(a[1], t0);
+    ct_select((digit_t*)c1, (digit_t*)c, (digit_t*)c, mask, 2*NWORDS_FIELD);
+}
+
+
+/************ Tate pairings *************/
+
+static void miller_tangent(const f2elm_t A, const f2elm_t X, const f2elm_t Y, const f2elm_t Z, f2elm_t L, f2elm_t M, f2elm_t W, f2elm_t X2, f2elm_t Y2, f2elm_t Z2)
+{ // Tangent at T = (X:Y:Z) in homogeneous projective coordinates, of slope L/M = (3X^2+2AXZ+Z^2)/(2YZ), and
+  // 2T = (X2:Y2:Z2) = (Xn*M*Z : L*(X*W-Xn*Z)-Y*M*W : M*Z*W) with W = M^2*Z and Xn = L^2*Z-(A*Z+2X)*M^2
+    f2elm_t t0, t1;
+
+    fp2sqr_mont(X, t0);
+    fp2add(t0, t0, L);
+    fp2add(L, t0, L);
+    fp2mul_mont(A, X, t0);
+    fp2add(t0, t0, t0);
+    fp2add(t0, Z, t0);
+    fp2mul_mont(t0, Z, t0);
+    fp2add(L, t0, L);                           // L = 3X^2+(2AX+Z)*Z
+    fp2mul_mont(Y, Z, M);
+    fp2add(M, M, M);                            // M = 2YZ
+
+    fp2sqr_mont(M, t0);
+    fp2mul_mont(t0, Z, W);                      // W = M^2*Z
+    fp2mul_mont(A, Z, t1);
+    fp2add(t1, X, t1);
+    fp2add(t1, X, t1);
+    fp2mul_mont(t1, t0, t1);
+    fp2sqr_mont(L, X2);
+    fp2mul_mont(X2, Z, X2);
+    fp2sub(X2, t1, X2);                         // X2 = Xn
+    fp2mul_mont(X, W, t0);
+    fp2mul_mont(X2, Z, t1);
+    fp2sub(t0, t1, t0);
+    fp2mul_mont(L, t0, t0);
+    fp2mul_mont(M, W, t1);
+    fp2mul_mont(Y, t1, t1);
+    fp2sub(t0, t1, Y2);
+    fp2mul_mont(M, Z, t0);
+    fp2mul_mont(X2, t0, X2);
+    fp2mul_mont(t0, W, Z2);
+}
+
+
+static void miller_line(const f2elm_t L, const f2elm_t M, const f2elm_t X, const f2elm_t Y, const f2elm_t Z, const point_affine* Q, f2elm_t l)
+{ // l = M*(yQ*Z-Y)-L*(xQ*Z-X), the line through (X:Y:Z) of slope L/M at Q, times M*Z
+    f2elm_t t0, t1;
+
+    fp2mul_mont(Q->y, Z, t0);
+    fp2sub(t0, Y, t0);
+    fp2mul_mont(M, t0, t0);
+    fp2mul_mont(Q->x, Z, t1);
+    fp2sub(t1, X, t1);
+    fp2mul_mont(L, t1, t1);
+    fp2sub(t0, t1, l);
+}
+
+
+static void miller_vertical(const f2elm_t X, const f2elm_t Z, const point_affine* Q, f2elm_t v)
+{ // v = xQ*Z-X, the vertical line at (X:Y:Z) at Q, times Z
+    fp2mul_mont(Q->x, Z, v);
+    fp2sub(v, X, v);
+}
+
+
+static void miller_2(const f2elm_t A, const point_affine* P, const point_affine* Q, const unsigned int nq, f2elm_t* num, f2elm_t* den)
+{ // num[j]/den[j] = f(Q[j]) for the Miller function f of divisor 2^eA(P)-2^eA(O), P of order 2^eA. Each step turns f into
+  // f^2*l/v, with l the tangent at T = [2^i]P and v the vertical line at 2T. Their common factor W goes to cn
+    f2elm_t X, Y, Z, L, M, W, X2, Y2, Z2, t0, t1, cn;
+    unsigned int i, j;
+
+    fp2copy(P->x, X);
+    fp2copy(P->y, Y);
+    fp2_one(Z);
+    fp2_one(cn);
+    for (j = 0; j < nq; j++) {
+        fp2_one(num[j]);
+        fp2_one(den[j]);
+    }
+
+    for (i = 0; i < OALICE_BITS-1; i++) {
+        miller_tangent(A, X, Y, Z, L, M, W, X2, Y2, Z2);
+        for (j = 0; j < nq; j++) {
+            miller_line(L, M, X, Y, Z, &Q[j], t0);
+            miller_vertical(X2, Z2, &Q[j], t1);
+            fp2sqr_mont(num[j], num[j]);
+            fp2mul_mont(num[j], t0, num[j]);
+            fp2sqr_mont(den[j], den[j]);
+            fp2mul_mont(den[j], t1, den[j]);
+        }
+        fp2sqr_mont(cn, cn);
+        fp2mul_mont(cn, W, cn);
+        fp2copy(X2, X);
+        fp2copy(Y2, Y);
+        fp2copy(Z2, Z);
+    }
+
+    // T has order 2, its tangent is the vertical line
+    for (j = 0; j < nq; j++) {
+        miller_vertical(X, Z, &Q[j], t0);
+        fp2sqr_mont(num[j], num[j]);
+        fp2mul_mont(num[j], t0, num[j]);
+        fp2sqr_mont(den[j], den[j]);
+    }
+    fp2sqr_mont(cn, cn);
+    for (j = 0; j < nq; j++) {
+        fp2mul_mont(num[j], cn, num[j]);
+        fp2mul_mont(den[j], Z, den[j]);
+    }
+}
+
+
+static void miller_3(const f2elm_t A, const point_affine* P, const point_affine* Q, const unsigned int nq, f2elm_t* num, f2elm_t* den)
+{ // num[j]/den[j] = f(Q[j]) for the Miller function f of divisor 3^eB(P)-3^eB(O), P of order 3^eB. Each step turns f into
+  // f^3*l1*l2/(v2*v3), with l1 the tangent at T = [3^i]P, l2 the line through T and 2T, and v2, v3 the vertical lines at
+  // 2T and 3T. Their common factors go to cn/cd
+    f2elm_t X, Y, Z, L, M, W, X2, Y2, Z2, Mn, Md, t0, t1, t2, cn, cd;
+    unsigned int i, j;
+
+    fp2copy(P->x, X);
+    fp2copy(P->y, Y);
+    fp2_one(Z);
+    fp2_one(cn);
+    fp2_one(cd);
+    for (j = 0; j < nq; j++) {
+        fp2_one(num[j]);
+        fp2_one(den[j]);
+    }
+
+    for (i = 0; i < OBOB_EXPON-1; i++) {
+        miller_tangent(A, X, Y, Z, L, M, W, X2, Y2, Z2);
+        fp2mul_mont(Y2, Z, Mn);                 // Slope Mn/Md = (Y2*Z-Y*Z2)/(X2*Z-X*Z2) of the line through T and 2T
+        fp2mul_mont(Y, Z2, t0);
+        fp2sub(Mn, t0, Mn);
+        fp2mul_mont(X2, Z, Md);
+        fp2mul_mont(X, Z2, t0);
+        fp2sub(Md, t0, Md);
+        for (j = 0; j < nq; j++) {
+            miller_line(L, M, X, Y, Z, &Q[j], t0);
+            miller_line(Mn, Md, X, Y, Z, &Q[j], t1);
+            fp2mul_mont(t0, t1, t0);
+            fp2sqr_mont(num[j], t1);
+            fp2mul_mont(num[j], t1, num[j]);
+            fp2mul_mont(num[j], t0, num[j]);
+            miller_vertical(X2, Z2, &Q[j], t0);
+            fp2sqr_mont(den[j], t1);
+            fp2mul_mont(den[j], t1, den[j]);
+            fp2mul_mont(den[j], t0, den[j]);
+        }
+        fp2sqr_mont(cd, t0);                    // cd = cd^3*M*Md*Z^2, cn = cn^3*Z2*Z3
+        fp2mul_mont(cd, t0, cd);
+        fp2mul_mont(cd, M, cd);
+        fp2mul_mont(cd, Md, cd);
+        fp2sqr_mont(Z, t0);
+        fp2mul_mont(cd, t0, cd);
+        fp2sqr_mont(cn, t0);
+        fp2mul_mont(cn, t0, cn);
+        fp2mul_mont(cn, Z2, cn);
+
+        // 3T = (X3*Md*Z : Mn*(X*Z3-X3*Z)-Y*Md*Z3 : Md*Z*Z3) with X3 = Mn^2*Z*Z2-(A*Z*Z2+X*Z2+X2*Z)*Md^2 and Z3 = Md^2*Z*Z2
+        fp2mul_mont(Z, Z2, t0);                 // t0 = Z*Z2
+        fp2sqr_mont(Md, t1);
+        fp2mul_mont(t1, t0, L);                 // L = Z3
+        fp2mul_mont(A, t0, t2);
+        fp2mul_mont(X, Z2, W);
+        fp2add(t2, W, t2);
+        fp2mul_mont(X2, Z, W);
+        fp2add(t2, W, t2);
+        fp2mul_mont(t2, t1, t2);
+        fp2sqr_mont(Mn, t1);
+        fp2mul_mont(t1, t0, M);
+        fp2sub(M, t2, M);                       // M = X3
+        fp2mul_mont(X, L, t0);
+        fp2mul_mont(M, Z, t1);
+        fp2sub(t0, t1, t0);
+        fp2mul_mont(Mn, t0, t0);
+        fp2mul_mont(Md, L, t1);
+        fp2mul_mont(Y, t1, t1);
+        fp2sub(t0, t1, Y);
+        fp2mul_mont(Md, Z, t0);
+        fp2mul_mont(M, t0, X);
+        fp2mul_mont(t0, L, Z);
+        for (j = 0; j < nq; j++) {
+            miller_vertical(X, Z, &Q[j], t0);
+            fp2mul_mont(den[j], t0, den[j]);
+        }
+        fp2mul_mont(cn, Z, cn);
+    }
+
+    // T has order 3, its tangent meets E only at T and f is multiplied by l1 = l/(M*Z)
+    fp2sqr_mont(X, t0);
+    fp2add(t0, t0, L);
+    fp2add(L, t0, L);
+    fp2mul_mont(A, X, t0);
+    fp2add(t0, t0, t0);
+    fp2add(t0, Z, t0);
+    fp2mul_mont(t0, Z, t0);
+    fp2add(L, t0, L);
+    fp2mul_mont(Y, Z, M);
+    fp2add(M, M, M);
+    for (j = 0; j < nq; j++) {
+        miller_line(L, M, X, Y, Z, &Q[j], t0);
+        fp2sqr_mont(num[j], t1);
+        fp2mul_mont(num[j], t1, num[j]);
+        fp2mul_mont(num[j], t0, num[j]);
+        fp2sqr_mont(den[j], t1);
+        fp2mul_mont(den[j], t1, den[j]);
+    }
+    fp2sqr_mont(cd, t0);
+    fp2mul_mont(cd, t0, cd);
+    fp2mul_mont(cd, M, cd);
+    fp2mul_mont(cd, Z, cd);
+    fp2sqr_mont(cn, t0);
+    fp2mul_mont(cn, t0, cn);
+    for (j = 0; j < nq; j++) {
+        fp2mul_mont(num[j], cn, num[j]);
+        fp2mul_mont(den[j], cd, den[j]);
+    }
+}
+
+
+static void final_exp(const unsigned int AliceOrBob, f2elm_t* num, f2elm_t* den, const unsigned int n)
+{ // num[j] = (num[j]/den[j])^((p^2-1)/l^e) for n values, with a single inversion. z^(p-1) = conj(z)/z, and (p+1)/2^eA = 3^eB,
+  // (p+1)/3^eB = 2^eA. den is overwritten
+    f2elm_t a[5], inv[5];
+    unsigned int j;
+
+    for (j = 0; j < n; j++) {
+        fp2copy(den[j], a[j]);
+        fpneg(a[j][1]);
+        fp2mul_mont(num[j], a[j], a[j]);        // a = num*conj(den)
+        fpneg(num[j][1]);
+        fp2mul_mont(num[j], den[j], den[j]);    // den = conj(num)*den
+    }
+    mont_n_way_inv((const f2elm_t*)a, (int)n, inv);
+    for (j = 0; j < n; j++) {
+        fp2mul_mont(den[j], inv[j], num[j]);
+        if (AliceOrBob == ALICE) {
+            cyc_pow_l(BOB, num[j], num[j], OBOB_EXPON);
+        } else {
+            cyc_pow_l(ALICE, num[j], num[j], OALICE_BITS);
+        }
+    }
+}
+
+
+static void dlog(const unsigned int AliceOrBob, f2elm_t* h, const f2elm_t g, const unsigned int e, digit_t x[COMPRESS_NLOGS][NWORDS_ORDER])
+{ // Pohlig-Hellman, h[j] = g^x[j] for the COMPRESS_NLOGS values h[j] and g of order l^e, l = 2 for Alice's torsion and 3 for
+  // Bob's. Divide and conquer: with e = e0+e1, x = x0+l^e0*x1, where x0 is the logarithm of h^(l^e1) to the base g^(l^e1)
+  // and x1 that of h*g^-x0 to the base g^(l^e0). h is overwritten. Not constant time, for public values only
+    f2elm_t hh[COMPRESS_NLOGS], gg, t;
+    digit_t y[COMPRESS_NLOGS][NWORDS_ORDER], le0[NWORDS_ORDER], w[NWORDS_ORDER];
+    unsigned int j, e0 = e/2, e1 = e - e0;
+
+    if (e == 1) {
+        for (j = 0; j < COMPRESS_NLOGS; j++) {
+            clear_words((void*)x[j], NWORDS_ORDER);
+            fp2_one(t);
+            if (!fp2_is_equal(h[j], t)) {
+                x[j][0] = fp2_is_equal(h[j], g) ? 1 : 2;
+            }
+        }
+        return;
+    }
+
+    for (j = 0; j < COMPRESS_NLOGS; j++) {
+        cyc_pow_l(AliceOrBob, h[j], hh[j], e1);
+    }
+    cyc_pow_l(AliceOrBob, g, gg, e1);
+    dlog(AliceOrBob, hh, gg, e0, x);
+
+    fp2copy(g, gg);                             // g^-1 = conj(g)
+    fpneg(gg[1]);
+    for (j = 0; j < COMPRESS_NLOGS; j++) {
+        cyc_exp(gg, x[j], t);
+        fp2mul_mont(h[j], t, h[j]);
+    }
+    cyc_pow_l(AliceOrBob, g, gg, e0);
+    dlog(AliceOrBob, h, gg, e1, y);
+
+    order_power(AliceOrBob, e0, le0);
+    for (j = 0; j < COMPRESS_NLOGS; j++) {
+        mp_mul_low(le0, y[j], w);
+        mp_add(x[j], w, x[j], NWORDS_ORDER);
+    }
+}
+
+
+/************ Torsion bases *************/
+
+static int torsion_basis(const unsigned int AliceOrBob, const f2elm_t A, point_affine* R, unsigned char* hint, const int use_hint)
+{ // Basis R[0], R[1] of E_A[2^eA] for Alice's torsion, E_A[3^eB] for Bob's: the cofactor multiples of the first points
+  // with x = 1+k*i, k = 1, 2, ..., of order l^e whose multiples of order l differ. The k's are written to hint[0..1],
+  // or read from there if use_hint != 0, in which case the orders are not checked.
+  // Returns 1 if no basis is found for k < 256, or if a hinted point is not on E_A
+    point_proj_t S[2], T[2];
+    f2elm_t one, x, f, A24plus, A24minus, C24, xR[2], zR[2], t0, t1;
+    unsigned int i, k = 0, n = 0;
+
+    fp2_one(one);
+    fp2add(one, one, C24);
+    fp2add(A, C24, A24plus);                    // A24plus = A+2, A24minus = A-2, C24 = 4
+    fp2sub(A, C24, A24minus);
+    fp2add(C24, C24, C24);
+
+    while (n < 2) {
+        if (use_hint) {
+            k = hint[n];
+        } else if (++k > 255) {
+            return 1;
+        }
+        fp2copy(one, x);
+        for (i = 0; i < k; i++) {
+            fpadd(x[1], one[0], x[1]);
+        }
+        if (!use_hint) {
+            curve_rhs(A, x, f);
+            if (!fp2_is_square(f)) {
+                continue;
+            }
+        }
+
+        fp2copy(x, S[n]->X);
+        fp2copy(one, S[n]->Z);
+        if (AliceOrBob == ALICE) {
+            xTPLe(S[n], S[n], A24minus, A24plus, OBOB_EXPON);
+        } else {
+            xDBLe(S[n], S[n], A24plus, C24, OALICE_BITS);
+        }
+        if (!use_hint) {
+            if (AliceOrBob == ALICE) {
+                xDBLe(S[n], T[n], A24plus, C24, OALICE_BITS-1);
+            } else {
+                xTPLe(S[n], T[n], A24minus, A24plus, OBOB_EXPON-1);
+            }
+            if (fp2_is_zero(T[n]->Z)) {
+                continue;
+            }
+            if (n == 1) {
+                fp2mul_mont(T[0]->X, T[1]->Z, t0);
+                fp2mul_mont(T[1]->X, T[0]->Z, t1);
+                if (fp2_is_equal(t0, t1)) {
+                    continue;
+                }
+            }
+        }
+        hint[n++] = (unsigned char)k;
+    }
+
+    proj_to_affine(S, 2, xR, zR);
+    for (n = 0; n < 2; n++) {
+        fp2copy(xR[n], R[n].x);
+        curve_rhs(A, R[n].x, f);
+        if (fp2_sqrt(f, R[n].y) != 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+/************ Compression and decompression *************/
+
+static void encode_order(const digit_t* a, unsigned char* enc, const unsigned int nbytes)
+{ // Encoding of an integer modulo oA or oB in nbytes bytes, little endian
+    unsigned int i;
+
+    for (i = 0; i < nbytes; i++) {
+        enc[i] = ((const unsigned char*)a)[i];
+    }
+}
+
+
+static int compress(const unsigned int AliceOrBob, point_proj_t* phi, unsigned char* out)
+{ // Compression of the images phi[0..2] = (P, Q, P-Q) of the basis of Alice's torsion (AliceOrBob = ALICE) or Bob's.
+  // With the basis R0, R1 of torsion_basis, P = a0*R0+b0*R1 and Q = a1*R0+b1*R1. As the Tate pairing t of order l^e is
+  // alternating, t(R0,P) = g^b0 and t(R1,P) = g^-a0 with g = t(R0,R1), and so on for Q. The output holds A, the three
+  // coefficients other than a0 divided by a0 (flag 0), or those other than b0 divided by b0 (flag 1), the flag and the
+  // hints of the basis. Returns 1 if no basis is found
+    point_affine R[2], PQ[3];
+    f2elm_t xphi[3], zphi[3], A, f, num[5], den[5], h[COMPRESS_NLOGS];
+    digit_t x[COMPRESS_NLOGS][NWORDS_ORDER], c[3][NWORDS_ORDER], inv[NWORDS_ORDER];
+    unsigned int j, flag, nbytes = (AliceOrBob == ALICE) ? NBITS_TO_NBYTES(OALICE_BITS) : NBITS_TO_NBYTES(OBOB_BITS);
+    unsigned char* hint = out + FP2_ENCODED_BYTES + 3*nbytes + 1;
+    order_t o;
+
+    proj_to_affine(phi, 3, xphi, zphi);
+    get_A(xphi[0], xphi[1], xphi[2], A);
+    fp2_encode(A, out);
+
+    // Affine P and Q, with the sign of yP set by fp2_sqrt
+    fp2copy(xphi[0], PQ[1].x);
+    curve_rhs(A, PQ[1].x, f);
+    fp2_sqrt(f, PQ[1].y);
+    recover_y(A, &PQ[1], xphi[1], xphi[2], &PQ[2]);
+
+    if (torsion_basis(AliceOrBob, A, R, hint, 0) != 0) {
+        return 1;
+    }
+    PQ[0] = R[1];
+
+    // t(R0,R1), t(R0,P), t(R0,Q), t(R1,P), t(R1,Q)
+    if (AliceOrBob == ALICE) {
+        miller_2(A, &R[0], PQ, 3, num, den);
+        miller_2(A, &R[1], &PQ[1], 2, &num[3], &den[3]);
+    } else {
+        miller_3(A, &R[0], PQ, 3, num, den);
+        miller_3(A, &R[1], &PQ[1], 2, &num[3], &den[3]);
+    }
+    final_exp(AliceOrBob, num, den, 5);
+
+    // Logarithms b0, a0, b1, a1 of t(R0,P), t(R1,P)^-1, t(R0,Q), t(R1,Q)^-1
+    fp2copy(num[1], h[0]);
+    fp2copy(num[3], h[1]);
+    fpneg(h[1][1]);
+    fp2copy(num[2], h[2]);
+    fp2copy(num[4], h[3]);
+    fpneg(h[3][1]);
+    dlog(AliceOrBob, h, num[0], (AliceOrBob == ALICE) ? OALICE_BITS : OBOB_EXPON, x);
+
+    // Normalization
+    order_init(&o, AliceOrBob);
+    flag = 1 ^ order_is_unit(&o, x[1]);
+    order_inv(&o, x[flag ^ 1], inv);
+    order_mul(&o, x[flag], inv, c[0]);
+    order_mul(&o, x[3], inv, c[1]);
+    order_mul(&o, x[2], inv, c[2]);
+    for (j = 0; j < 3; j++) {
+        encode_order(c[j], out + FP2_ENCODED_BYTES + j*nbytes, nbytes);
+    }
+    out[FP2_ENCODED_BYTES + 3*nbytes] = (unsigned char)flag;
+
+    return 0;
+}
+
+
+static int decompress(const unsigned int AliceOrBob, const unsigned char* in, const digit_t* s, point_proj_t R, f2elm_t A)
+{ // Kernel point R = (a0+s*a1)*R0+(b0+s*b1)*R1 of the compressed public key in and the secret key s, up to a unit, and the
+  // coefficient A of its curve. With u = a0+s*a1 and v = b0+s*b1, R = R0+(v/u)*R1 if u is a unit and R = (u/v)*R0+R1
+  // otherwise, which is computed by one ladder. Constant time in s. Returns 1 if the basis cannot be rebuilt
+    point_affine Rb[2];
+    f2elm_t xRR, xP, xQ, A24plus = {0}, C24 = {0}, t0, t1;
+    digit_t c[3][NWORDS_ORDER], one[NWORDS_ORDER] = {1}, u[NWORDS_ORDER], v[NWORDS_ORDER], t[NWORDS_ORDER], mask;
+    unsigned int j, nbytes = (AliceOrBob == ALICE) ? NBITS_TO_NBYTES(OALICE_BITS) : NBITS_TO_NBYTES(OBOB_BITS);
+    unsigned char hint[2];
+    order_t o;
+
+    fp2_decode(in, A);
+    hint[0] = in[FP2_ENCODED_BYTES + 3*nbytes + 1];
+    hint[1] = in[FP2_ENCODED_BYTES + 3*nbytes + 2];
+    if (torsion_basis(AliceOrBob, A, Rb, hint, 1) != 0) {
+        return 1;
+    }
+
+    // x(R0-R1) = ((y0+y1)/(x0-x1))^2-A-x0-x1
+    fp2sub(Rb[0].x, Rb[1].x, t0);
+    fp2inv_mont(t0);
+    fp2add(Rb[0].y, Rb[1].y, t1);
+    fp2mul_mont(t0, t1, t0);
+    fp2sqr_mont(t0, t0);
+    fp2sub(t0, A, t0);
+    fp2sub(t0, Rb[0].x, t0);
+    fp2sub(t0, Rb[1].x, xRR);
+
+    // u = a0+s*a1, v = b0+s*b1, one of a0 and b0 being 1
+    order_init(&o, AliceOrBob);
+    for (j = 0; j < 3; j++) {
+        decode_to_digits(in + FP2_ENCODED_BYTES + j*nbytes, c[j], nbytes, NWORDS_ORDER);
+        if (o.alice) {
+            order_reduce_A(c[j]);
+        }
+    }
+    mask = 0 - (digit_t)(in[FP2_ENCODED_BYTES + 3*nbytes] & 1);
+    ct_select(c[0], one, t, mask, NWORDS_ORDER);            // a0
+    ct_select(one, c[0], v, mask, NWORDS_ORDER);            // b0
+    order_mul(&o, s, c[1], u);
+    order_add(&o, t, u, u);
+    order_mul(&o, s, c[2], t);
+    order_add(&o, v, t, v);
+
+    // t = v/u and R = R0+t*R1, or t = u/v and R = t*R0+R1
+    mask = 0 - (digit_t)order_is_unit(&o, u);
+    ct_select(u, v, c[0], mask, NWORDS_ORDER);
+    ct_select(v, u, c[1], mask, NWORDS_ORDER);
+    order_inv(&o, c[0], c[2]);
+    order_mul(&o, c[1], c[2], t);
+    ct_select((digit_t*)Rb[0].x, (digit_t*)Rb[1].x, (digit_t*)xP, mask, 2*NWORDS_FIELD);
+    ct_select((digit_t*)Rb[1].x, (digit_t*)Rb[0].x, (digit_t*)xQ, mask, 2*NWORDS_FIELD);
+
+    fpcopy((digit_t*)&Montgomery_one, C24[0]);
+    fp2add(C24, C24, C24);
+    fp2add(A, C24, A24plus);                    // A24plus = A+2, C24 = 4
+    fp2add(C24, C24, C24);
+    LADDER3PT(xP, xQ, xRR, t, (AliceOrBob == ALICE) ? ALICE : BOB_FULL, R, A24plus, C24[0]);
+
+    clear_words((void*)c, 3*NWORDS_ORDER);
+    clear_words((void*)u, NWORDS_ORDER);
+    clear_words((void*)v, NWORDS_ORDER);
+    clear_words((void*)t, NWORDS_ORDER);
+    return 0;
+}
+
+
+static int compressed_check(const unsigned int AliceOrBob, point_proj_t* phi, const unsigned char* in)
+{ // Checks that in is the compression of phi[0..2] = (P, Q, P-Q), as output by compress, at a cost that only depends on in.
+  // The basis R0, R1 is rebuilt from the curve of in, with the hints of torsion_basis. The coefficients of in are then
+  // checked on the pairings of compress, without logarithms: with g = t(R0,R1), t(R0,P) = g^b0, t(R1,P)^-1 = g^a0, and so
+  // on for Q, flag 0 holds c0 = b0/a0, c1 = a1/a0 and c2 = b1/a0 if and only if g^b0 = u^c0, g^a1 = u^c1 and g^b1 = u^c2
+  // with u = g^a0, and flag 1 the same with a0 and b0 swapped. P and Q being a basis, a0 is then a unit for flag 0, and it
+  // is not one for flag 1 if c0 is not. The root of yP may differ from that of compress, which only negates P and Q.
+  // Returns 0 if in matches, 1 otherwise
+    point_affine R[2], PQ[2];
+    f2elm_t xphi[3], zphi[3], A, f, num[4], den[4], u, v[3], t;
+    digit_t c[3][NWORDS_ORDER], d[NWORDS_ORDER], mask;
+    unsigned int j, flag, nbytes = (AliceOrBob == ALICE) ? NBITS_TO_NBYTES(OALICE_BITS) : NBITS_TO_NBYTES(OBOB_BITS);
+    unsigned char hint[2], enc[FP2_ENCODED_BYTES];
+    order_t o;
+
+    // Public part: canonical coefficients and flag, basis of the curve of in
+    flag = in[FP2_ENCODED_BYTES + 3*nbytes];
+    if (flag > 1) {
+        return 1;
+    }
+    order_init(&o, AliceOrBob);
+    for (j = 0; j < 3; j++) {
+        decode_to_digits(in + FP2_ENCODED_BYTES + j*nbytes, c[j], nbytes, NWORDS_ORDER);
+        copy_words(c[j], d, NWORDS_ORDER);
+        if (o.alice) {
+            order_reduce_A(d);
+            if (memcmp(c[j], d, sizeof(d)) != 0) {
+                return 1;
+            }
+        } else if (mp_sub(c[j], (const digit_t*)Bob_order, d, NWORDS_ORDER) == 0) {
+            return 1;
+        }
+    }
+    if (flag == 1 && order_is_unit(&o, c[0]) != 0) {
+        return 1;
+    }
+    fp2_decode(in, A);
+    if (torsion_basis(AliceOrBob, A, R, hint, 0) != 0 || memcmp(hint, in + FP2_ENCODED_BYTES + 3*nbytes + 1, 2) != 0) {
+        return 1;
+    }
+
+    // Secret part, in constant time: curve of phi, affine P and Q, pairings
+    proj_to_affine(phi, 3, xphi, zphi);
+    get_A(xphi[0], xphi[1], xphi[2], f);
+    fp2_encode(f, enc);
+    mask = 0 - (digit_t)(ct_compare(enc, in, FP2_ENCODED_BYTES) & 1);
+
+    fp2copy(xphi[0], PQ[0].x);
+    curve_rhs(A, PQ[0].x, f);
+    fp2_sqrt_ct(f, PQ[0].y);
+    recover_y(A, &PQ[0], xphi[1], xphi[2], &PQ[1]);
+
+    // t(R0,P), t(R0,Q), t(R1,P), t(R1,Q)
+    if (AliceOrBob == ALICE) {
+        miller_2(A, &R[0], PQ, 2, num, den);
+        miller_2(A, &R[1], PQ, 2, &num[2], &den[2]);
+    } else {
+        miller_3(A, &R[0], PQ, 2, num, den);
+        miller_3(A, &R[1], PQ, 2, &num[2], &den[2]);
+    }
+    final_exp(AliceOrBob, num, den, 4);
+
+    // u = g^a0 and v = (g^b0, g^a1, g^b1) for flag 0, u = g^b0 and v = (g^a0, g^a1, g^b1) for flag 1
+    fpneg(num[2][1]);
+    fpneg(num[3][1]);
+    fp2copy((flag == 0) ? num[2] : num[0], u);
+    fp2copy((flag == 0) ? num[0] : num[2], v[0]);
+    fp2copy(num[3], v[1]);
+    fp2copy(num[1], v[2]);
+    for (j = 0; j < 3; j++) {
+        cyc_exp(u, c[j], t);
+        fp2sub(t, v[j], t);
+        mask |= ~fp2_zero_mask(t);
+    }
+    return (int)(mask & 1);
+}
+
+
+/************ SIDH with compressed public keys *************/
+
+int EphemeralKeyGeneration_A_compressed(const unsigned char* PrivateKeyA, unsigned char* PublicKeyA)
+{ // Alice's ephemeral public key generation with compression
+  // Input:  a private key PrivateKeyA in the range [0, 2^eA - 1].
+  // Output: the public key PublicKeyA of COMPRESSED_PKA_BYTES bytes. Returns 1 if no torsion basis is found
+    point_proj_t phi[3];
+    int ret;
+
+    if (KeyGeneration_A(PrivateKeyA, phi, NULL) != 0) {
+        return 1;
+    }
+    OP_COUNT_PHASE(OP_PHASE_NORMALIZE);
+    TRACE_BEGIN("compress");
+    ret = compress(BOB, phi, PublicKeyA);
+    TRACE_END("compress");
+    OP_COUNT_PHASE(OP_PHASE_OTHER);
+
+    return ret;
+}
+
+
+int EphemeralKeyGeneration_B_compressed(const unsigned char* PrivateKeyB, unsigned char* PublicKeyB)
+{ // Bob's ephemeral public key generation with compression
+  // Input:  a private key PrivateKeyB in the range [0, 2^Floor(Log(2,oB)) - 1].
+  // Output: the public key PublicKeyB of COMPRESSED_PKB_BYTES bytes. Returns 1 if no torsion basis is found
+    point_proj_t phi[3];
+    int ret;
+
+    if (KeyGeneration_B(PrivateKeyB, phi, NULL) != 0) {
+        return 1;
+    }
+    OP_COUNT_PHASE(OP_PHASE_NORMALIZE);
+    TRACE_BEGIN("compress");
+    ret = compress(ALICE, phi, PublicKeyB);
+    TRACE_END("compress");
+    OP_COUNT_PHASE(OP_PHASE_OTHER);
+
+    return ret;
+}
+
+
+int EphemeralKeyVerify_A_compressed(const unsigned char* PrivateKeyA, const unsigned char* PublicKeyA)
+{ // Checks that PublicKeyA is the compressed public key of PrivateKeyA. Returns 0 if it is, 1 otherwise.
+  // In decapsulation PrivateKeyA derives from a secret if the ciphertext is invalid: the images of the basis are not
+  // compressed again but checked against PublicKeyA by compressed_check, whose cost only depends on PublicKeyA
+    point_proj_t phi[3];
+    int ret;
+
+    if (KeyGeneration_A(PrivateKeyA, phi, NULL) != 0) {
+        return 1;
+    }
+    OP_COUNT_PHASE(OP_PHASE_NORMALIZE);
+    TRACE_BEGIN("compressed_check");
+    ret = compressed_check(BOB, phi, PublicKeyA);
+    TRACE_END("compressed_check");
+    OP_COUNT_PHASE(OP_PHASE_OTHER);
+
+    return ret;
+}
+
+
+int EphemeralSecretAgreement_A_compressed(const unsigned char* PrivateKeyA, const unsigned char* PublicKeyB, unsigned char* SharedSecretA)
+{ // Alice's ephemeral shared secret computation on Bob's compressed public key PublicKeyB
+  // Output: a shared secret SharedSecretA that consists of one element in GF(p^2). Returns 1 if PublicKeyB is invalid
+    point_proj_t R;
+    f2elm_t A, A24plus = {0}, C24 = {0}, jA, jC, jinv;
+    digit_t SecretKeyA[NWORDS_ORDER];
+    int ret;
+
+    OP_COUNT_PHASE(OP_PHASE_LADDER);
+    TRACE_BEGIN("decompress");
+    decode_to_digits(PrivateKeyA, SecretKeyA, SECRETKEY_A_BYTES, NWORDS_ORDER);
+    ret = decompress(ALICE, PublicKeyB, SecretKeyA, R, A);
+    clear_words((void*)SecretKeyA, NWORDS_ORDER);
+    TRACE_END("decompress");
+    if (ret != 0) {
+        OP_COUNT_PHASE(OP_PHASE_OTHER);
+        return 1;
+    }
+
+    // A24plus = A+2C, C24 = 4C, where C = 1
+    fpcopy((digit_t*)&Montgomery_one, C24[0]);
+    fp2add(C24, C24, C24);
+    fp2add(A, C24, A24plus);
+    fp2add(C24, C24, C24);
+    SecretIsogeny_A(R, A24plus, C24, strategies[STRATEGY_AGREEMENT_A], jA, jC);
+
+    OP_COUNT_PHASE(OP_PHASE_NORMALIZE);
+    TRACE_BEGIN("normalize");
+    j_inv(jA, jC, jinv);
+    TRACE_END("normalize");
+    TRACE_BEGIN("encode");
+    fp2_encode(jinv, SharedSecretA);
+    TRACE_END("encode");
+    OP_COUNT_PHASE(OP_PHASE_OTHER);
+
+    return 0;
+}
+
+
+int EphemeralSecretAgreement_B_compressed(const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, unsigned char* SharedSecretB)
+{ // Bob's ephemeral shared secret computation on Alice's compressed public key PublicKeyA
+  // Output: a shared secret SharedSecretB that consists of one element in GF(p^2). Returns 1 if PublicKeyA is invalid
+    point_proj_t R;
+    f2elm_t A, A24plus = {0}, A24minus = {0}, jA, jC, jinv;
+    digit_t SecretKeyB[NWORDS_ORDER];
+    int ret;
+
+    OP_COUNT_PHASE(OP_PHASE_LADDER);
+    TRACE_BEGIN("decompress");
+    decode_to_digits(PrivateKeyB, SecretKeyB, SECRETKEY_B_BYTES, NWORDS_ORDER);
+    ret = decompress(BOB, PublicKeyA, SecretKeyB, R, A);
+    clear_words((void*)SecretKeyB, NWORDS_ORDER);
+    TRACE_END("decompress");
+    if (ret != 0) {
+        OP_COUNT_PHASE(OP_PHASE_OTHER);
+        return 1;
+    }
+
+    // A24plus = A+2C, A24minus = A-2C, where C = 1
+    fpcopy((digit_t*)&Montgomery_one, A24minus[0]);
+    fp2add(A24minus, A24minus, A24minus);
+    fp2add(A, A24minus, A24plus);
+    fp2sub(A, A24minus, A24minus);
+    SecretIsogeny_B(R, A24minus, A24plus, strategies[STRATEGY_AGREEMENT_B], jA, jC);
+
+    OP_COUNT_PHASE(OP_PHASE_NORMALIZE);
+    TRACE_BEGIN("normalize");
+    j_inv(jA, jC, jinv);
+    TRACE_END("normalize");
+    TRACE_BEGIN("encode");
+    fp2_encode(jinv, SharedSecretB);
+    TRACE_END("encode");
+    OP_COUNT_PHASE(OP_PHASE_OTHER);
+
+    return 0;
+}
+
+#endif
@@ -22,6 +22,7 @@ __inline void fpadd610(const digit_t* a, const digit_t* b, digit_t* c)
 asm(
 			
 			"push  {r4-r11,lr}			\n\t"
+			OP_COUNT_ASM(OP_FPADD)
 
 			"MOVW  R14,#0xFFFF	\n\t"
 			"MOVT  R14,#0xFFFF	\n\t"
@@ -275,6 +276,7 @@ __inline void fpsub610(const digit_t* a, const digit_t* b, digit_t* c)
     asm(
 			
 			"push  {r4-r11,lr}			\n\t"
+			OP_COUNT_ASM(OP_FPSUB)
 
 			"ldmia r0!, {r4-r7} 			\n\t"	
 			"ldmia r1!, {r8-r11} 			\n\t"	
@@ -464,6 +466,7 @@ void fpcorrection610(digit_t* a)
     unsigned int i, borrow = 0;
     digit_t mask;
 
+    OP_COUNT_INC(OP_FPCORRECTION);
     for (i = 0; i < NWORDS_FIELD; i++) {
         SUBC(borrow, a[i], ((digit_t*)p610)[i], borrow, a[i]); 
     }
@@ -0,0 +1,344 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: host job service for encapsulation and decapsulation, with per-core work-stealing deques
+*********************************************************************************************/
+
+#include <string.h>
+#include "P610_internal.h"
+
+#if defined(KEMSVC)
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <time.h>
+#include <unistd.h>
+
+// Jobs take milliseconds, so the deques are rings under a mutex: the owner pops the oldest jobs at head, a thief
+// the newest one at head + count - 1. Every queued job posts one token to work, a worker sleeps on it once it
+// finds nothing to run. pending counts the jobs submitted and not complete yet, for kemsvc_drain. accepting is
+// cleared by kemsvc_stop before it drains: a submitter raises pending before it reads accepting again under the
+// deque lock, and kemsvc_stop reads pending after clearing accepting, so that a job is either drained or run by
+// its submitter. nworkers keeps the number of workers until they have stopped, so that they go on stealing
+typedef struct {
+    pthread_mutex_t lock;
+    kemsvc_job_t* job[KEMSVC_QUEUE];
+    uint32_t head, count;
+} kemsvc_deque_t;
+
+static struct {
+    kemsvc_deque_t deque[KEMSVC_MAX_WORKERS];
+    pthread_t thread[KEMSVC_MAX_WORKERS];
+    pthread_mutex_t lock, idle;
+    pthread_cond_t drained;
+    sem_t work;
+    uint32_t nworkers, max_batch, stop, pending, created, accepting;
+    kemsvc_stats_t stats;
+} kemsvc = { .lock = PTHREAD_MUTEX_INITIALIZER, .idle = PTHREAD_MUTEX_INITIALIZER, .drained = PTHREAD_COND_INITIALIZER };
+
+
+static uint64_t kemsvc_now(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec*1000000000 + (uint64_t)t.tv_nsec;
+}
+
+
+static void kemsvc_account(const kemsvc_job_t* job)
+{
+    const uint64_t latency = job->completed - job->submitted;
+    uint64_t us = latency/1000, max = __atomic_load_n(&kemsvc.stats.max_ns, __ATOMIC_RELAXED);
+    unsigned int i = 0;
+
+    while (us > 1 && i < KEMSVC_HISTOGRAM - 1) {
+        us >>= 1;
+        i++;
+    }
+    __atomic_add_fetch(&kemsvc.stats.histogram[i], 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&kemsvc.stats.jobs, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&kemsvc.stats.wait_ns, job->started - job->submitted, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&kemsvc.stats.run_ns, job->completed - job->started, __ATOMIC_RELAXED);
+    if (job->batch > 1) {
+        __atomic_add_fetch(&kemsvc.stats.batched, 1, __ATOMIC_RELAXED);
+    }
+    while (latency > max && !__atomic_compare_exchange_n(&kemsvc.stats.max_ns, &max, latency, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+
+static void kemsvc_run(kemsvc_job_t** job, const unsigned int n)
+{ // Runs n jobs of the same kind, together if n > 1. The jobs belong to their callers again once done is called.
+  // The copies of secrets are held in whole words, which clear_words zeroizes
+    unsigned char ct[SIDH_BATCH][CRYPTO_CIPHERTEXTBYTES];
+    digit_t ss_words[NBYTES_TO_NWORDS(SIDH_BATCH*CRYPTO_BYTES)];
+    unsigned char (*ss)[CRYPTO_BYTES] = (unsigned char (*)[CRYPTO_BYTES])ss_words;
+    unsigned int k;
+    uint64_t t = kemsvc_now();
+    int status;
+
+    for (k = 0; k < n; k++) {
+        job[k]->started = t;
+        job[k]->batch = n;
+    }
+
+    if (n == 1) {
+        if (job[0]->op == KEMSVC_ENC) {
+            job[0]->status = crypto_kem_enc(job[0]->ct, job[0]->ss, job[0]->pk);
+        } else {
+            job[0]->status = crypto_kem_dec(job[0]->ss, job[0]->ct, job[0]->sk);
+        }
+    } else if (job[0]->op == KEMSVC_ENC) {
+        unsigned char pk[SIDH_BATCH][CRYPTO_PUBLICKEYBYTES];
+        for (k = 0; k < n; k++) {
+            memcpy(pk[k], job[k]->pk, CRYPTO_PUBLICKEYBYTES);
+        }
+        status = crypto_kem_enc_batch(ct[0], ss[0], pk[0], n);
+        for (k = 0; k < n; k++) {
+            memcpy(job[k]->ct, ct[k], CRYPTO_CIPHERTEXTBYTES);
+            memcpy(job[k]->ss, ss[k], CRYPTO_BYTES);
+            job[k]->status = status;
+        }
+    } else {
+        digit_t sk_words[NBYTES_TO_NWORDS(SIDH_BATCH*CRYPTO_SECRETKEYBYTES)];
+        unsigned char (*sk)[CRYPTO_SECRETKEYBYTES] = (unsigned char (*)[CRYPTO_SECRETKEYBYTES])sk_words;
+        for (k = 0; k < n; k++) {
+            memcpy(ct[k], job[k]->ct, CRYPTO_CIPHERTEXTBYTES);
+            memcpy(sk[k], job[k]->sk, CRYPTO_SECRETKEYBYTES);
+        }
+        status = crypto_kem_dec_batch(ss[0], ct[0], sk[0], n);
+        for (k = 0; k < n; k++) {
+            memcpy(job[k]->ss, ss[k], CRYPTO_BYTES);
+            job[k]->status = status;
+        }
+        clear_words((void*)sk_words, NBYTES_TO_NWORDS(SIDH_BATCH*CRYPTO_SECRETKEYBYTES));
+    }
+    clear_words((void*)ss_words, NBYTES_TO_NWORDS(SIDH_BATCH*CRYPTO_BYTES));
+
+    t = kemsvc_now();
+    for (k = 0; k < n; k++) {
+        job[k]->completed = t;
+        kemsvc_account(job[k]);
+        if (job[k]->done != NULL) {
+            job[k]->done(job[k]);
+        }
+    }
+}
+
+
+static unsigned int kemsvc_pop(kemsvc_deque_t* q, kemsvc_job_t** job, const unsigned int max)
+{ // Oldest job of q, followed by the next ones of the same kind up to max jobs
+    unsigned int n = 0;
+
+    pthread_mutex_lock(&q->lock);
+    while (q->count != 0 && n < max && (n == 0 || q->job[q->head]->op == job[0]->op)) {
+        job[n++] = q->job[q->head];
+        q->head = (q->head + 1) % KEMSVC_QUEUE;
+        q->count--;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return n;
+}
+
+
+static unsigned int kemsvc_steal(const unsigned int t, kemsvc_job_t** job)
+{ // Newest job of the first non-empty deque after the one of worker t
+    const unsigned int n = __atomic_load_n(&kemsvc.nworkers, __ATOMIC_ACQUIRE);
+    unsigned int k;
+
+    for (k = 1; k < n; k++) {
+        kemsvc_deque_t* q = &kemsvc.deque[(t + k) % n];
+        if (__atomic_load_n(&q->count, __ATOMIC_RELAXED) == 0) {
+            continue;
+        }
+        pthread_mutex_lock(&q->lock);
+        if (q->count != 0) {
+            q->count--;
+            job[0] = q->job[(q->head + q->count) % KEMSVC_QUEUE];
+            pthread_mutex_unlock(&q->lock);
+            __atomic_add_fetch(&kemsvc.stats.stolen, 1, __ATOMIC_RELAXED);
+            return 1;
+        }
+        pthread_mutex_unlock(&q->lock);
+    }
+    return 0;
+}
+
+
+static void kemsvc_complete(const unsigned int n)
+{
+    if (__atomic_sub_fetch(&kemsvc.pending, n, __ATOMIC_ACQ_REL) == 0) {
+        pthread_mutex_lock(&kemsvc.idle);
+        pthread_cond_broadcast(&kemsvc.drained);
+        pthread_mutex_unlock(&kemsvc.idle);
+    }
+}
+
+
+static void* kemsvc_worker(void* arg)
+{
+    const unsigned int t = (unsigned int)(uintptr_t)arg;
+    kemsvc_job_t* job[SIDH_BATCH];
+    unsigned int n;
+
+#if defined(THREADS)
+    pool_background = 1;                        // The service has a core per worker already
+#endif
+
+    for (;;) {
+        n = kemsvc_pop(&kemsvc.deque[t], job, kemsvc.max_batch);
+        if (n == 0) {
+            n = kemsvc_steal(t, job);
+        }
+        if (n != 0) {
+            kemsvc_run(job, n);
+            kemsvc_complete(n);
+            continue;
+        }
+        if (__atomic_load_n(&kemsvc.stop, __ATOMIC_ACQUIRE) != 0) {
+            break;
+        }
+        while (sem_wait(&kemsvc.work) != 0 && errno == EINTR);
+    }
+    return NULL;
+}
+
+
+unsigned int kemsvc_start(unsigned int nworkers, unsigned int max_batch)
+{ // Worker t is pinned to core t modulo the number of cores. The trace ring is not shared between threads,
+  // traced builds run the jobs on the caller
+    long ncores = sysconf(_SC_NPROCESSORS_ONLN);
+    cpu_set_t cores;
+    unsigned int t;
+
+    kemsvc_stop();
+    if (ncores < 1) {
+        ncores = 1;
+    }
+    if (nworkers == 0) {
+        nworkers = (unsigned int)ncores;
+    }
+    if (nworkers > KEMSVC_MAX_WORKERS) {
+        nworkers = KEMSVC_MAX_WORKERS;
+    }
+#if defined(TRACE)
+    nworkers = 0;
+#endif
+    if (max_batch == 0 || max_batch > SIDH_BATCH) {
+        max_batch = SIDH_BATCH;
+    }
+
+    pthread_mutex_lock(&kemsvc.lock);
+    if (kemsvc.created == 0 && nworkers != 0) {
+        for (t = 0; t < KEMSVC_MAX_WORKERS; t++) {
+            pthread_mutex_init(&kemsvc.deque[t].lock, NULL);
+        }
+        if (sem_init(&kemsvc.work, 0, 0) != 0) {
+            nworkers = 0;
+        } else {
+            kemsvc.created = 1;
+        }
+    }
+    kemsvc.max_batch = max_batch;
+    __atomic_store_n(&kemsvc.stop, 0, __ATOMIC_RELEASE);
+    for (t = 0; t < nworkers; t++) {
+        if (pthread_create(&kemsvc.thread[t], NULL, kemsvc_worker, (void*)(uintptr_t)t) != 0) {
+            break;
+        }
+        CPU_ZERO(&cores);
+        CPU_SET(t % ncores, &cores);
+        pthread_setaffinity_np(kemsvc.thread[t], sizeof(cores), &cores);
+    }
+    __atomic_store_n(&kemsvc.nworkers, t, __ATOMIC_RELEASE);
+    __atomic_store_n(&kemsvc.accepting, (t != 0) ? 1 : 0, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&kemsvc.lock);
+    return t;
+}
+
+
+void kemsvc_stop(void)
+{ // Jobs submitted from here on run on their callers, the queued ones are drained by the workers first
+    unsigned int t, n;
+
+    pthread_mutex_lock(&kemsvc.lock);
+    n = kemsvc.nworkers;
+    if (n != 0) {
+        __atomic_store_n(&kemsvc.accepting, 0, __ATOMIC_SEQ_CST);
+        kemsvc_drain();
+        __atomic_store_n(&kemsvc.stop, 1, __ATOMIC_RELEASE);
+        for (t = 0; t < n; t++) {
+            sem_post(&kemsvc.work);
+        }
+        for (t = 0; t < n; t++) {
+            pthread_join(kemsvc.thread[t], NULL);
+        }
+        __atomic_store_n(&kemsvc.nworkers, 0, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&kemsvc.lock);
+}
+
+
+int kemsvc_submit(kemsvc_job_t* job)
+{ // Starts at the deque of the current core and moves on to the next ones while they are full. The job runs on the
+  // caller if the service no longer accepts jobs once the deque is locked
+    const unsigned int n = __atomic_load_n(&kemsvc.nworkers, __ATOMIC_ACQUIRE);
+    unsigned int t, k;
+    int cpu;
+
+    job->submitted = kemsvc_now();
+    if (n == 0 || __atomic_load_n(&kemsvc.accepting, __ATOMIC_ACQUIRE) == 0) {
+        kemsvc_run(&job, 1);
+        return 0;
+    }
+
+    cpu = sched_getcpu();
+    t = (cpu < 0) ? 0 : (unsigned int)cpu % n;
+    __atomic_add_fetch(&kemsvc.pending, 1, __ATOMIC_SEQ_CST);
+    for (k = 0; k < n; k++, t = (t + 1) % n) {
+        kemsvc_deque_t* q = &kemsvc.deque[t];
+        pthread_mutex_lock(&q->lock);
+        if (__atomic_load_n(&kemsvc.accepting, __ATOMIC_SEQ_CST) == 0 || t >= __atomic_load_n(&kemsvc.nworkers, __ATOMIC_ACQUIRE)) {
+            pthread_mutex_unlock(&q->lock);     // Stopped, or restarted with fewer workers, since n was read
+            kemsvc_complete(1);
+            kemsvc_run(&job, 1);
+            return 0;
+        }
+        if (q->count < KEMSVC_QUEUE) {
+            q->job[(q->head + q->count) % KEMSVC_QUEUE] = job;
+            q->count++;
+            pthread_mutex_unlock(&q->lock);
+            sem_post(&kemsvc.work);
+            return 0;
+        }
+        pthread_mutex_unlock(&q->lock);
+    }
+    kemsvc_complete(1);
+    __atomic_add_fetch(&kemsvc.stats.rejected, 1, __ATOMIC_RELAXED);
+    return -1;
+}
+
+
+void kemsvc_drain(void)
+{
+    pthread_mutex_lock(&kemsvc.idle);
+    while (__atomic_load_n(&kemsvc.pending, __ATOMIC_SEQ_CST) != 0) {
+        pthread_cond_wait(&kemsvc.drained, &kemsvc.idle);
+    }
+    pthread_mutex_unlock(&kemsvc.idle);
+}
+
+
+void kemsvc_stats(kemsvc_stats_t* stats, const unsigned int reset)
+{ // The counters are read one by one, jobs completing meanwhile may be counted in some of them only
+    uint64_t* src = (uint64_t*)&kemsvc.stats;
+    uint64_t* dst = (uint64_t*)stats;
+    unsigned int i;
+
+    for (i = 0; i < sizeof(kemsvc_stats_t)/sizeof(uint64_t); i++) {
+        dst[i] = (reset != 0) ? __atomic_exchange_n(&src[i], 0, __ATOMIC_RELAXED) : __atomic_load_n(&src[i], __ATOMIC_RELAXED);
+    }
+}
+
+#endif
@@ -0,0 +1,301 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: LRU cache of the tables of Alice's right-to-left three-point ladder on Bob's public keys
+*********************************************************************************************/
+
+#include <string.h>
+#include "P610_internal.h"
+
+#if defined(LADDER_CACHE)
+
+#if (TARGET != TARGET_ARM)
+    #include <pthread.h>
+#endif
+
+#define LADDER_CACHE_FREE       0
+#define LADDER_CACHE_BUILDING   1           // Claimed by a thread building its table, invisible to lookups
+#define LADDER_CACHE_READY      2
+
+#define LADDER_CACHE_BLOCK      16          // Doublings recomputed together by ladder_cache_build
+
+typedef struct {
+    f2elm_t table[OALICE_BITS];             // Affine x([2^i]Q), i = 0..OALICE_BITS-1, Q of x-coordinate PKB[1]. First member
+    f2elm_t PKB[3];                         // Key of the entry
+    uint64_t hash, stamp;                   // Hash of PKB, time of the last use
+    uint32_t state, users;                  // users counts the ladders reading the table, which cannot be evicted then
+} ladder_cache_entry_t;
+
+#define LADDER_CACHE_ENTRIES    ((LADDER_CACHE_BYTES/sizeof(ladder_cache_entry_t) > 0) ? LADDER_CACHE_BYTES/sizeof(ladder_cache_entry_t) : 1)
+
+// Entries 0..capacity-1 are in use. A table is built for a key on its second miss among the last
+// LADDER_CACHE_GHOSTS ones, whose hashes are kept in ghost, so that keys used once do not evict hot ones
+static struct {
+    ladder_cache_entry_t entry[LADDER_CACHE_ENTRIES];
+    uint64_t ghost[LADDER_CACHE_GHOSTS];
+    uint64_t clock;
+    uint32_t capacity, next_ghost;
+    ladder_cache_stats_t stats;
+#if (TARGET != TARGET_ARM)
+    pthread_mutex_t lock;
+#endif
+} ladder_cache = {
+    .capacity = LADDER_CACHE_ENTRIES,
+#if (TARGET != TARGET_ARM)
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+#endif
+};
+
+#if (TARGET != TARGET_ARM)
+    #define LADDER_CACHE_LOCK()     pthread_mutex_lock(&ladder_cache.lock)
+    #define LADDER_CACHE_UNLOCK()   pthread_mutex_unlock(&ladder_cache.lock)
+#else
+    #define LADDER_CACHE_LOCK()
+    #define LADDER_CACHE_UNLOCK()
+#endif
+
+
+static uint64_t ladder_cache_hash(const f2elm_t* PKB)
+{ // FNV-1a hash of the images of Bob's basis. Collisions only cost a comparison, the entries keep PKB
+    const unsigned char* b = (const unsigned char*)PKB;
+    uint64_t h = 0xCBF29CE484222325;
+    size_t i;
+
+    for (i = 0; i < 3*sizeof(f2elm_t); i++) {
+        h = (h ^ b[i])*0x100000001B3;
+    }
+    return h;
+}
+
+
+static unsigned int fp2_is_zero_vartime(const f2elm_t a)
+{ // Non constant-time test of a = 0, on public values
+    f2elm_t t;
+    digit_t r = 0;
+    unsigned int i;
+
+    fp2copy(a, t);
+    fp2correction(t);
+    for (i = 0; i < NWORDS_FIELD; i++) {
+        r |= t[0][i] | t[1][i];
+    }
+    return (r == 0);
+}
+
+
+static int ladder_cache_build(ladder_cache_entry_t* e, const pk_expanded_B_t* PublicKeyBx)
+{ // Table of the affine x([2^i]Q) with a single inversion. The prefix products Z_0*...*Z_i of the doublings are stored
+  // in the table, then the doublings are recomputed by blocks from checkpoints, last block first, to invert the Z_i and
+  // overwrite the products with the x-coordinates. Returns 1 if some [2^i]Q is the point at infinity, i.e., Q does not
+  // have order 2^eA, in which case the table is left unused
+    point_proj_t S, chk[(OALICE_BITS + LADDER_CACHE_BLOCK - 1)/LADDER_CACHE_BLOCK], blk[LADDER_CACHE_BLOCK];
+    f2elm_t t, z;
+    int i, j, k, first, last;
+
+    fp2copy(PublicKeyBx->PKB[1], S->X);
+    fp2zero(S->Z);
+    fpcopy((digit_t*)&Montgomery_one, S->Z[0]);
+    for (i = 0; i < OALICE_BITS; i++) {
+        if (i % LADDER_CACHE_BLOCK == 0) {
+            fp2copy(S->X, chk[i/LADDER_CACHE_BLOCK]->X);
+            fp2copy(S->Z, chk[i/LADDER_CACHE_BLOCK]->Z);
+        }
+        if (i == 0) {
+            fp2copy(S->Z, e->table[0]);
+        } else {
+            fp2mul_mont(e->table[i-1], S->Z, e->table[i]);
+        }
+        xDBL(S, S, PublicKeyBx->A24plus, PublicKeyBx->C24);
+    }
+    if (fp2_is_zero_vartime(e->table[OALICE_BITS-1])) {
+        return 1;
+    }
+
+    fp2copy(e->table[OALICE_BITS-1], t);
+    fp2inv_mont(t);                                         // t = 1/(Z_0*...*Z_{n-1})
+    for (j = (OALICE_BITS - 1)/LADDER_CACHE_BLOCK; j >= 0; j--) {
+        first = j*LADDER_CACHE_BLOCK;
+        last = (first + LADDER_CACHE_BLOCK < OALICE_BITS) ? first + LADDER_CACHE_BLOCK - 1 : OALICE_BITS - 1;
+        fp2copy(chk[j]->X, blk[0]->X);
+        fp2copy(chk[j]->Z, blk[0]->Z);
+        for (k = 1; k <= last - first; k++) {
+            xDBL(blk[k-1], blk[k], PublicKeyBx->A24plus, PublicKeyBx->C24);
+        }
+        for (i = last; i >= first; i--) {
+            k = i - first;
+            if (i > 0) {
+                fp2mul_mont(e->table[i-1], t, z);           // z = 1/Z_i
+                fp2mul_mont(t, blk[k]->Z, t);               // t = 1/(Z_0*...*Z_{i-1})
+            } else {
+                fp2copy(t, z);
+            }
+            fp2mul_mont(blk[k]->X, z, e->table[i]);
+        }
+    }
+    return 0;
+}
+
+
+static ladder_cache_entry_t* ladder_cache_claim(void)
+{ // A free entry, or the least recently used ready one that no ladder reads, which is evicted. NULL if there is none.
+  // Called with the lock held
+    ladder_cache_entry_t* victim = NULL;
+    uint32_t i;
+
+    for (i = 0; i < ladder_cache.capacity; i++) {
+        ladder_cache_entry_t* e = &ladder_cache.entry[i];
+        if (e->state == LADDER_CACHE_FREE) {
+            return e;
+        }
+        if (e->state == LADDER_CACHE_READY && e->users == 0 && (victim == NULL || e->stamp < victim->stamp)) {
+            victim = e;
+        }
+    }
+    if (victim != NULL) {
+        victim->state = LADDER_CACHE_FREE;
+        ladder_cache.stats.evictions++;
+        ladder_cache.stats.entries--;
+    }
+    return victim;
+}
+
+
+const f2elm_t* ladder_cache_acquire(const pk_expanded_B_t* PublicKeyBx)
+{ // Table of Alice's ladder on the key PublicKeyBx, to be passed back to ladder_cache_release. NULL on a miss, which
+  // builds the table if the key missed recently. The work depends only on the public key
+    uint64_t hash = ladder_cache_hash(PublicKeyBx->PKB);
+    ladder_cache_entry_t* e = NULL;
+    uint32_t i, seen = 0;
+
+    LADDER_CACHE_LOCK();
+    for (i = 0; i < ladder_cache.capacity; i++) {
+        ladder_cache_entry_t* c = &ladder_cache.entry[i];
+        if (c->state == LADDER_CACHE_READY && c->hash == hash && memcmp(c->PKB, PublicKeyBx->PKB, sizeof(c->PKB)) == 0) {
+            c->users++;
+            c->stamp = ++ladder_cache.clock;
+            ladder_cache.stats.hits++;
+            LADDER_CACHE_UNLOCK();
+            return (const f2elm_t*)c->table;
+        }
+    }
+    ladder_cache.stats.misses++;
+    for (i = 0; i < LADDER_CACHE_GHOSTS; i++) {
+        if (ladder_cache.ghost[i] == hash) {
+            ladder_cache.ghost[i] = 0;
+            seen = 1;
+        }
+    }
+    if (seen == 0) {
+        ladder_cache.ghost[ladder_cache.next_ghost] = hash;
+        ladder_cache.next_ghost = (ladder_cache.next_ghost + 1) % LADDER_CACHE_GHOSTS;
+    } else {
+        e = ladder_cache_claim();
+        if (e != NULL) {
+            e->state = LADDER_CACHE_BUILDING;
+        }
+    }
+    LADDER_CACHE_UNLOCK();
+    if (e == NULL) {
+        return NULL;
+    }
+
+    // The table is built without the lock, for the next lookups. Two threads missing on the same key may both build
+    // it, the second table is then dropped
+    TRACE_BEGIN("ladder_cache_build");
+    if (ladder_cache_build(e, PublicKeyBx) != 0) {
+        TRACE_END("ladder_cache_build");
+        LADDER_CACHE_LOCK();
+        e->state = LADDER_CACHE_FREE;
+        LADDER_CACHE_UNLOCK();
+        return NULL;
+    }
+    TRACE_END("ladder_cache_build");
+    memcpy(e->PKB, PublicKeyBx->PKB, sizeof(e->PKB));
+    e->hash = hash;
+
+    LADDER_CACHE_LOCK();
+    for (i = 0; i < ladder_cache.capacity; i++) {
+        ladder_cache_entry_t* c = &ladder_cache.entry[i];
+        if (c->state == LADDER_CACHE_READY && c->hash == hash && memcmp(c->PKB, e->PKB, sizeof(c->PKB)) == 0) {
+            break;
+        }
+    }
+    if (i < ladder_cache.capacity || (uint32_t)(e - ladder_cache.entry) >= ladder_cache.capacity) {
+        e->state = LADDER_CACHE_FREE;                       // Built meanwhile, or beyond a capacity lowered meanwhile
+    } else {
+        e->state = LADDER_CACHE_READY;
+        e->users = 0;
+        e->stamp = ++ladder_cache.clock;
+        ladder_cache.stats.builds++;
+        ladder_cache.stats.entries++;
+    }
+    LADDER_CACHE_UNLOCK();
+    return NULL;
+}
+
+
+void ladder_cache_release(const f2elm_t* table)
+{ // End of the ladder reading table
+    ladder_cache_entry_t* e = (ladder_cache_entry_t*)table;
+
+    LADDER_CACHE_LOCK();
+    e->users--;
+    LADDER_CACHE_UNLOCK();
+}
+
+
+size_t ladder_cache_config(const size_t bytes)
+{ // Tables beyond the new capacity are evicted once no ladder reads them, at the latest by the next
+  // ladder_cache_config or ladder_cache_flush
+    uint32_t i, capacity;
+
+    capacity = (uint32_t)((bytes/sizeof(ladder_cache_entry_t) < LADDER_CACHE_ENTRIES) ? bytes/sizeof(ladder_cache_entry_t) : LADDER_CACHE_ENTRIES);
+    LADDER_CACHE_LOCK();
+    ladder_cache.capacity = capacity;
+    for (i = capacity; i < LADDER_CACHE_ENTRIES; i++) {
+        ladder_cache_entry_t* e = &ladder_cache.entry[i];
+        if (e->state == LADDER_CACHE_READY && e->users == 0) {
+            e->state = LADDER_CACHE_FREE;
+            ladder_cache.stats.evictions++;
+            ladder_cache.stats.entries--;
+        }
+    }
+    LADDER_CACHE_UNLOCK();
+    return (size_t)capacity*sizeof(ladder_cache_entry_t);
+}
+
+
+void ladder_cache_flush(void)
+{ // Evicts the tables that no ladder reads and forgets the recent misses
+    uint32_t i;
+
+    LADDER_CACHE_LOCK();
+    for (i = 0; i < LADDER_CACHE_ENTRIES; i++) {
+        ladder_cache_entry_t* e = &ladder_cache.entry[i];
+        if (e->state == LADDER_CACHE_READY && e->users == 0) {
+            e->state = LADDER_CACHE_FREE;
+            ladder_cache.stats.evictions++;
+            ladder_cache.stats.entries--;
+        }
+    }
+    memset(ladder_cache.ghost, 0, sizeof(ladder_cache.ghost));
+    LADDER_CACHE_UNLOCK();
+}
+
+
+void ladder_cache_stats(ladder_cache_stats_t* stats, const unsigned int reset)
+{ // Consistent snapshot, taken with the lock held
+    LADDER_CACHE_LOCK();
+    *stats = ladder_cache.stats;
+    stats->bytes = (uint64_t)ladder_cache.stats.entries*sizeof(ladder_cache_entry_t);
+    stats->budget = (uint64_t)ladder_cache.capacity*sizeof(ladder_cache_entry_t);
+    if (reset != 0) {
+        ladder_cache.stats.hits = 0;
+        ladder_cache.stats.misses = 0;
+        ladder_cache.stats.builds = 0;
+        ladder_cache.stats.evictions = 0;
+    }
+    LADDER_CACHE_UNLOCK();
+}
+
+#endif
@@ -9,27 +9,67 @@
 #include "fips202.h"
 
 
+#if defined(THREADS) && !defined(TRACE)
+
+typedef struct { const unsigned char* ephemeralsk; unsigned char* ct; } keygen_job_t;
+
+static void keygen_A_job(void* arg)
+{ // Ciphertext part c0 of encapsulation, run on a worker
+    keygen_job_t* job = (keygen_job_t*)arg;
+
+    EphemeralKeyGeneration_A(job->ephemeralsk, job->ct);
+}
+
+#endif
+
+
 int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
 { // SIKE's key generation
   // Outputs: secret key sk (CRYPTO_SECRETKEYBYTES = MSG_BYTES + SECRETKEY_B_BYTES + CRYPTO_PUBLICKEYBYTES bytes)
   //          public key pk (CRYPTO_PUBLICKEYBYTES bytes) 
 
+    TRACE_BEGIN("crypto_kem_keypair");
+
+#if defined(KEYPOOL)
+    // Pop a precomputed key pair, the pool refills in the background
+    if (keypool_take(pk, sk) == 0) {
+        TRACE_END("crypto_kem_keypair");
+        return 0;
+    }
+#endif
+
     // Generate lower portion of secret key sk <- s||SK
     randombytes(sk, MSG_BYTES);
     random_mod_order_B(sk + MSG_BYTES);
 
     // Generate public key pk
+    TRACE_BEGIN("EphemeralKeyGeneration_B");
     EphemeralKeyGeneration_B(sk + MSG_BYTES, pk);
+    TRACE_END("EphemeralKeyGeneration_B");
 
     // Append public key pk to secret key sk
     memcpy(&sk[MSG_BYTES + SECRETKEY_B_BYTES], pk, CRYPTO_PUBLICKEYBYTES);
 
+    TRACE_END("crypto_kem_keypair");
     return 0;
 }
 
 
-int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk)
-{ // SIKE's encapsulation
+// The expanded public key of api.h holds a pk_expanded_B_t
+typedef char pk_expanded_size_check[(sizeof(((crypto_kem_pk_expanded_t*)0)->expanded) == sizeof(pk_expanded_B_t)) ? 1 : -1];
+
+static void secret_agreement_A(const unsigned char* ephemeralsk, const unsigned char* pk, const crypto_kem_pk_expanded_t* epk, unsigned char* jinvariant)
+{ // Shared secret of encapsulation, on the expanded public key epk if it is not NULL
+    if (epk != NULL) {
+        EphemeralSecretAgreement_A_expanded(ephemeralsk, (const pk_expanded_B_t*)epk->expanded, jinvariant);
+    } else {
+        EphemeralSecretAgreement_A(ephemeralsk, pk, jinvariant);
+    }
+}
+
+
+static int kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk, const crypto_kem_pk_expanded_t* epk)
+{ // SIKE's encapsulation, with the expanded form epk of pk or NULL
   // Input:   public key pk         (CRYPTO_PUBLICKEYBYTES bytes)
   // Outputs: shared secret ss      (CRYPTO_BYTES bytes)
   //          ciphertext message ct (CRYPTO_CIPHERTEXTBYTES = CRYPTO_PUBLICKEYBYTES + MSG_BYTES bytes)
@@ -42,26 +82,76 @@ int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk
     unsigned char temp[CRYPTO_CIPHERTEXTBYTES+MSG_BYTES];
 	int i;
 
+    TRACE_BEGIN("crypto_kem_enc");
+
     // Generate ephemeralsk <- G(m||pk) mod oA 
     randombytes(temp, MSG_BYTES);
     memcpy(&temp[MSG_BYTES], pk, CRYPTO_PUBLICKEYBYTES);
+    TRACE_BEGIN("cshake256");
     cshake256_simple(ephemeralsk, SECRETKEY_A_BYTES, G, temp, CRYPTO_PUBLICKEYBYTES+MSG_BYTES);
+    TRACE_END("cshake256");
     ephemeralsk[SECRETKEY_A_BYTES - 1] &= MASK_ALICE;
 
-    // Encrypt
+    // Encrypt. Both operations depend only on ephemeralsk and pk, with workers they run on two threads.
+    // The trace ring is not shared between threads, traced builds stay sequential
+#if defined(THREADS) && !defined(TRACE)
+    if (pool_begin() != 0) {
+        keygen_job_t job = { ephemeralsk, ct };
+        pool_call(keygen_A_job, &job);
+        secret_agreement_A(ephemeralsk, pk, epk, jinvariant);
+        pool_end();
+    } else {
+#endif
+    TRACE_BEGIN("EphemeralKeyGeneration_A");
     EphemeralKeyGeneration_A(ephemeralsk, ct);
-    EphemeralSecretAgreement_A(ephemeralsk, pk, jinvariant);
+    TRACE_END("EphemeralKeyGeneration_A");
+    TRACE_BEGIN("EphemeralSecretAgreement_A");
+    secret_agreement_A(ephemeralsk, pk, epk, jinvariant);
+    TRACE_END("EphemeralSecretAgreement_A");
+#if defined(THREADS) && !defined(TRACE)
+    }
+#endif
+    TRACE_BEGIN("cshake256");
     cshake256_simple(h, MSG_BYTES, P, jinvariant, FP2_ENCODED_BYTES);
+    TRACE_END("cshake256");
     for ( i = 0; i < MSG_BYTES; i++) ct[i + CRYPTO_PUBLICKEYBYTES] = temp[i] ^ h[i];
 
     // Generate shared secret ss <- H(m||ct)
     memcpy(&temp[MSG_BYTES], ct, CRYPTO_CIPHERTEXTBYTES);
+    TRACE_BEGIN("cshake256");
     cshake256_simple(ss, CRYPTO_BYTES, H, temp, CRYPTO_CIPHERTEXTBYTES+MSG_BYTES);
+    TRACE_END("cshake256");
 
+    TRACE_END("crypto_kem_enc");
     return 0;
 }
 
 
+int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk)
+{ // SIKE's encapsulation
+  // Input:   public key pk         (CRYPTO_PUBLICKEYBYTES bytes)
+  // Outputs: shared secret ss      (CRYPTO_BYTES bytes)
+  //          ciphertext message ct (CRYPTO_CIPHERTEXTBYTES = CRYPTO_PUBLICKEYBYTES + MSG_BYTES bytes)
+    return kem_enc(ct, ss, pk, NULL);
+}
+
+
+int crypto_kem_pk_expand(crypto_kem_pk_expanded_t *epk, const unsigned char *pk)
+{ // Expansion of a public key pk (CRYPTO_PUBLICKEYBYTES bytes) for crypto_kem_enc_expanded
+    TRACE_BEGIN("crypto_kem_pk_expand");
+    memcpy(epk->pk, pk, CRYPTO_PUBLICKEYBYTES);
+    PublicKeyExpand_B(pk, (pk_expanded_B_t*)epk->expanded);
+    TRACE_END("crypto_kem_pk_expand");
+    return 0;
+}
+
+
+int crypto_kem_enc_expanded(unsigned char *ct, unsigned char *ss, const crypto_kem_pk_expanded_t *epk)
+{ // SIKE's encapsulation to an expanded public key, same output as crypto_kem_enc on epk->pk
+    return kem_enc(ct, ss, epk->pk, epk);
+}
+
+
 int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned char *sk)
 { // SIKE's decapsulation
   // Input:   secret key sk         (CRYPTO_SECRETKEYBYTES = MSG_BYTES + SECRETKEY_B_BYTES + CRYPTO_PUBLICKEYBYTES bytes)
@@ -78,23 +168,307 @@ int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned ch
 	int i;
 	
 
+    TRACE_BEGIN("crypto_kem_dec");
+
     // Decrypt
+    TRACE_BEGIN("EphemeralSecretAgreement_B");
     EphemeralSecretAgreement_B(sk + MSG_BYTES, ct, jinvariant_);
+    TRACE_END("EphemeralSecretAgreement_B");
+    TRACE_BEGIN("cshake256");
     cshake256_simple(h_, MSG_BYTES, P, jinvariant_, FP2_ENCODED_BYTES);
+    TRACE_END("cshake256");
     for ( i = 0; i < MSG_BYTES; i++) temp[i] = ct[i + CRYPTO_PUBLICKEYBYTES] ^ h_[i];
 
     // Generate ephemeralsk_ <- G(m||pk) mod oA
     memcpy(&temp[MSG_BYTES], &sk[MSG_BYTES + SECRETKEY_B_BYTES], CRYPTO_PUBLICKEYBYTES);
+    TRACE_BEGIN("cshake256");
     cshake256_simple(ephemeralsk_, SECRETKEY_A_BYTES, G, temp, CRYPTO_PUBLICKEYBYTES+MSG_BYTES);
+    TRACE_END("cshake256");
     ephemeralsk_[SECRETKEY_A_BYTES - 1] &= MASK_ALICE;
     
     // Generate shared secret ss <- H(m||ct) or output ss <- H(s||ct)
+    TRACE_BEGIN("EphemeralKeyGeneration_A");
     EphemeralKeyGeneration_A(ephemeralsk_, c0_);
-    if (memcmp(c0_, ct, CRYPTO_PUBLICKEYBYTES) != 0) {
-        memcpy(temp, sk, MSG_BYTES);
-    }
+    TRACE_END("EphemeralKeyGeneration_A");
+    ct_cmov(temp, sk, MSG_BYTES, ct_compare(c0_, ct, CRYPTO_PUBLICKEYBYTES));
     memcpy(&temp[MSG_BYTES], ct, CRYPTO_CIPHERTEXTBYTES);
+    TRACE_BEGIN("cshake256");
     cshake256_simple(ss, CRYPTO_BYTES, H, temp, CRYPTO_CIPHERTEXTBYTES+MSG_BYTES);
+    TRACE_END("cshake256");
+
+    TRACE_END("crypto_kem_dec");
+    return 0;
+}
+
+
+int crypto_kem_keypair_batch(unsigned char *pk, unsigned char *sk, const unsigned int n)
+{ // SIKE's key generation of n key pairs, same output as n calls of crypto_kem_keypair
+  // Outputs: n secret keys sk and n public keys pk, stored one after the other
+    const unsigned char* skB[SIDH_BATCH];
+    unsigned char* pkB[SIDH_BATCH];
+    unsigned int i, k, nb;
+
+    TRACE_BEGIN("crypto_kem_keypair_batch");
+
+    for (i = 0; i < n; i += nb) {
+        nb = (n - i < SIDH_BATCH) ? n - i : SIDH_BATCH;
+
+        // Generate lower portions of secret keys sk <- s||SK
+        for (k = 0; k < nb; k++) {
+            unsigned char* skk = sk + (i + k)*CRYPTO_SECRETKEYBYTES;
+            randombytes(skk, MSG_BYTES);
+            random_mod_order_B(skk + MSG_BYTES);
+            skB[k] = skk + MSG_BYTES;
+            pkB[k] = pk + (i + k)*CRYPTO_PUBLICKEYBYTES;
+        }
+
+        // Generate public keys pk
+        TRACE_BEGIN("EphemeralKeyGeneration_B_batch");
+        EphemeralKeyGeneration_B_batch(skB, pkB, nb);
+        TRACE_END("EphemeralKeyGeneration_B_batch");
+
+        // Append public keys pk to secret keys sk
+        for (k = 0; k < nb; k++) {
+            memcpy(sk + (i + k)*CRYPTO_SECRETKEYBYTES + MSG_BYTES + SECRETKEY_B_BYTES, pkB[k], CRYPTO_PUBLICKEYBYTES);
+        }
+    }
+
+    TRACE_END("crypto_kem_keypair_batch");
+    return 0;
+}
+
+
+int crypto_kem_enc_batch(unsigned char *ct, unsigned char *ss, const unsigned char *pk, const unsigned int n)
+{ // SIKE's encapsulation of n public keys, same output as n calls of crypto_kem_enc
+  // Input:   n public keys pk        (CRYPTO_PUBLICKEYBYTES bytes each)
+  // Outputs: n shared secrets ss     (CRYPTO_BYTES bytes each)
+  //          n ciphertext messages ct (CRYPTO_CIPHERTEXTBYTES bytes each)
+    const uint16_t G = 0;
+    const uint16_t H = 1;
+    const uint16_t P = 2;
+    unsigned char ephemeralsk[SIDH_BATCH][SECRETKEY_A_BYTES];
+    unsigned char jinvariant[SIDH_BATCH][FP2_ENCODED_BYTES];
+    unsigned char m[SIDH_BATCH][MSG_BYTES];
+    unsigned char h[MSG_BYTES];
+    unsigned char temp[CRYPTO_CIPHERTEXTBYTES+MSG_BYTES];
+    const unsigned char *skA[SIDH_BATCH], *pkB[SIDH_BATCH];
+    unsigned char *ctA[SIDH_BATCH], *jA[SIDH_BATCH];
+    unsigned int i, k, nb;
+    int j;
+
+    TRACE_BEGIN("crypto_kem_enc_batch");
+
+    for (i = 0; i < n; i += nb) {
+        nb = (n - i < SIDH_BATCH) ? n - i : SIDH_BATCH;
+
+        // Generate ephemeralsk <- G(m||pk) mod oA
+        for (k = 0; k < nb; k++) {
+            pkB[k] = pk + (i + k)*CRYPTO_PUBLICKEYBYTES;
+            ctA[k] = ct + (i + k)*CRYPTO_CIPHERTEXTBYTES;
+            skA[k] = ephemeralsk[k];
+            jA[k] = jinvariant[k];
+            randombytes(m[k], MSG_BYTES);
+            memcpy(temp, m[k], MSG_BYTES);
+            memcpy(&temp[MSG_BYTES], pkB[k], CRYPTO_PUBLICKEYBYTES);
+            cshake256_simple(ephemeralsk[k], SECRETKEY_A_BYTES, G, temp, CRYPTO_PUBLICKEYBYTES+MSG_BYTES);
+            ephemeralsk[k][SECRETKEY_A_BYTES - 1] &= MASK_ALICE;
+        }
+
+        // Encrypt
+        TRACE_BEGIN("EphemeralKeyGeneration_A_batch");
+        EphemeralKeyGeneration_A_batch(skA, ctA, nb);
+        TRACE_END("EphemeralKeyGeneration_A_batch");
+        TRACE_BEGIN("EphemeralSecretAgreement_A_batch");
+        EphemeralSecretAgreement_A_batch(skA, pkB, jA, nb);
+        TRACE_END("EphemeralSecretAgreement_A_batch");
+
+        for (k = 0; k < nb; k++) {
+            cshake256_simple(h, MSG_BYTES, P, jinvariant[k], FP2_ENCODED_BYTES);
+            for (j = 0; j < MSG_BYTES; j++) ctA[k][j + CRYPTO_PUBLICKEYBYTES] = m[k][j] ^ h[j];
+
+            // Generate shared secret ss <- H(m||ct)
+            memcpy(temp, m[k], MSG_BYTES);
+            memcpy(&temp[MSG_BYTES], ctA[k], CRYPTO_CIPHERTEXTBYTES);
+            cshake256_simple(ss + (i + k)*CRYPTO_BYTES, CRYPTO_BYTES, H, temp, CRYPTO_CIPHERTEXTBYTES+MSG_BYTES);
+        }
+    }
+
+    TRACE_END("crypto_kem_enc_batch");
+    return 0;
+}
+
 
+int crypto_kem_dec_batch(unsigned char *ss, const unsigned char *ct, const unsigned char *sk, const unsigned int n)
+{ // SIKE's decapsulation of n ciphertexts, each one with its own secret key, same output as n calls of crypto_kem_dec
+  // Input:   n secret keys sk         (CRYPTO_SECRETKEYBYTES bytes each)
+  //          n ciphertext messages ct (CRYPTO_CIPHERTEXTBYTES bytes each)
+  // Outputs: n shared secrets ss      (CRYPTO_BYTES bytes each)
+    const uint16_t G = 0;
+    const uint16_t H = 1;
+    const uint16_t P = 2;
+    unsigned char ephemeralsk_[SIDH_BATCH][SECRETKEY_A_BYTES];
+    unsigned char jinvariant_[SIDH_BATCH][FP2_ENCODED_BYTES];
+    unsigned char m_[SIDH_BATCH][MSG_BYTES];
+    unsigned char c0_[SIDH_BATCH][CRYPTO_PUBLICKEYBYTES];
+    unsigned char h_[MSG_BYTES];
+    unsigned char temp[CRYPTO_CIPHERTEXTBYTES+MSG_BYTES];
+    const unsigned char *skB[SIDH_BATCH], *ctB[SIDH_BATCH], *skA[SIDH_BATCH];
+    unsigned char *jB[SIDH_BATCH], *c0A[SIDH_BATCH];
+    unsigned int i, k, nb;
+    int j;
+
+    TRACE_BEGIN("crypto_kem_dec_batch");
+
+    for (i = 0; i < n; i += nb) {
+        nb = (n - i < SIDH_BATCH) ? n - i : SIDH_BATCH;
+
+        // Decrypt
+        for (k = 0; k < nb; k++) {
+            skB[k] = sk + (i + k)*CRYPTO_SECRETKEYBYTES + MSG_BYTES;
+            ctB[k] = ct + (i + k)*CRYPTO_CIPHERTEXTBYTES;
+            jB[k] = jinvariant_[k];
+            skA[k] = ephemeralsk_[k];
+            c0A[k] = c0_[k];
+        }
+        TRACE_BEGIN("EphemeralSecretAgreement_B_batch");
+        EphemeralSecretAgreement_B_batch(skB, ctB, jB, nb);
+        TRACE_END("EphemeralSecretAgreement_B_batch");
+
+        for (k = 0; k < nb; k++) {
+            cshake256_simple(h_, MSG_BYTES, P, jinvariant_[k], FP2_ENCODED_BYTES);
+            for (j = 0; j < MSG_BYTES; j++) m_[k][j] = ctB[k][j + CRYPTO_PUBLICKEYBYTES] ^ h_[j];
+
+            // Generate ephemeralsk_ <- G(m||pk) mod oA
+            memcpy(temp, m_[k], MSG_BYTES);
+            memcpy(&temp[MSG_BYTES], skB[k] + SECRETKEY_B_BYTES, CRYPTO_PUBLICKEYBYTES);
+            cshake256_simple(ephemeralsk_[k], SECRETKEY_A_BYTES, G, temp, CRYPTO_PUBLICKEYBYTES+MSG_BYTES);
+            ephemeralsk_[k][SECRETKEY_A_BYTES - 1] &= MASK_ALICE;
+        }
+
+        // Generate shared secrets ss <- H(m||ct) or output ss <- H(s||ct)
+        TRACE_BEGIN("EphemeralKeyGeneration_A_batch");
+        EphemeralKeyGeneration_A_batch(skA, c0A, nb);
+        TRACE_END("EphemeralKeyGeneration_A_batch");
+        for (k = 0; k < nb; k++) {
+            memcpy(temp, m_[k], MSG_BYTES);
+            ct_cmov(temp, skB[k] - MSG_BYTES, MSG_BYTES, ct_compare(c0_[k], ctB[k], CRYPTO_PUBLICKEYBYTES));
+            memcpy(&temp[MSG_BYTES], ctB[k], CRYPTO_CIPHERTEXTBYTES);
+            cshake256_simple(ss + (i + k)*CRYPTO_BYTES, CRYPTO_BYTES, H, temp, CRYPTO_CIPHERTEXTBYTES+MSG_BYTES);
+        }
+    }
+
+    TRACE_END("crypto_kem_dec_batch");
     return 0;
 }
+
+
+#if defined(COMPRESS)
+
+int crypto_kem_keypair_compressed(unsigned char *pk, unsigned char *sk)
+{ // SIKE's key generation with a compressed public key
+  // Outputs: secret key sk (CRYPTO_SECRETKEYBYTES_COMPRESSED = MSG_BYTES + SECRETKEY_B_BYTES + CRYPTO_PUBLICKEYBYTES_COMPRESSED bytes)
+  //          public key pk (CRYPTO_PUBLICKEYBYTES_COMPRESSED bytes)
+    int ret;
+
+    TRACE_BEGIN("crypto_kem_keypair_compressed");
+
+    // Generate lower portion of secret key sk <- s||SK
+    randombytes(sk, MSG_BYTES);
+    random_mod_order_B(sk + MSG_BYTES);
+
+    // Generate public key pk
+    TRACE_BEGIN("EphemeralKeyGeneration_B_compressed");
+    ret = EphemeralKeyGeneration_B_compressed(sk + MSG_BYTES, pk);
+    TRACE_END("EphemeralKeyGeneration_B_compressed");
+
+    // Append public key pk to secret key sk
+    memcpy(&sk[MSG_BYTES + SECRETKEY_B_BYTES], pk, CRYPTO_PUBLICKEYBYTES_COMPRESSED);
+
+    TRACE_END("crypto_kem_keypair_compressed");
+    return ret;
+}
+
+
+int crypto_kem_enc_compressed(unsigned char *ct, unsigned char *ss, const unsigned char *pk)
+{ // SIKE's encapsulation with a compressed public key and ciphertext
+  // Input:   public key pk         (CRYPTO_PUBLICKEYBYTES_COMPRESSED bytes)
+  // Outputs: shared secret ss      (CRYPTO_BYTES bytes)
+  //          ciphertext message ct (CRYPTO_CIPHERTEXTBYTES_COMPRESSED = COMPRESSED_PKA_BYTES + MSG_BYTES bytes)
+    const uint16_t G = 0;
+    const uint16_t H = 1;
+    const uint16_t P = 2;
+    unsigned char ephemeralsk[SECRETKEY_A_BYTES];
+    unsigned char jinvariant[FP2_ENCODED_BYTES];
+    unsigned char h[MSG_BYTES];
+    unsigned char temp[CRYPTO_CIPHERTEXTBYTES_COMPRESSED+MSG_BYTES];
+    int i, ret;
+
+    TRACE_BEGIN("crypto_kem_enc_compressed");
+
+    // Generate ephemeralsk <- G(m||pk) mod oA
+    randombytes(temp, MSG_BYTES);
+    memcpy(&temp[MSG_BYTES], pk, CRYPTO_PUBLICKEYBYTES_COMPRESSED);
+    cshake256_simple(ephemeralsk, SECRETKEY_A_BYTES, G, temp, CRYPTO_PUBLICKEYBYTES_COMPRESSED+MSG_BYTES);
+    ephemeralsk[SECRETKEY_A_BYTES - 1] &= MASK_ALICE;
+
+    // Encrypt
+    TRACE_BEGIN("EphemeralKeyGeneration_A_compressed");
+    ret = EphemeralKeyGeneration_A_compressed(ephemeralsk, ct);
+    TRACE_END("EphemeralKeyGeneration_A_compressed");
+    TRACE_BEGIN("EphemeralSecretAgreement_A_compressed");
+    ret |= EphemeralSecretAgreement_A_compressed(ephemeralsk, pk, jinvariant);
+    TRACE_END("EphemeralSecretAgreement_A_compressed");
+    cshake256_simple(h, MSG_BYTES, P, jinvariant, FP2_ENCODED_BYTES);
+    for (i = 0; i < MSG_BYTES; i++) ct[i + COMPRESSED_PKA_BYTES] = temp[i] ^ h[i];
+
+    // Generate shared secret ss <- H(m||ct)
+    memcpy(&temp[MSG_BYTES], ct, CRYPTO_CIPHERTEXTBYTES_COMPRESSED);
+    cshake256_simple(ss, CRYPTO_BYTES, H, temp, CRYPTO_CIPHERTEXTBYTES_COMPRESSED+MSG_BYTES);
+
+    TRACE_END("crypto_kem_enc_compressed");
+    return ret;
+}
+
+
+int crypto_kem_dec_compressed(unsigned char *ss, const unsigned char *ct, const unsigned char *sk)
+{ // SIKE's decapsulation with a compressed public key and ciphertext
+  // Input:   secret key sk         (CRYPTO_SECRETKEYBYTES_COMPRESSED bytes)
+  //          ciphertext message ct (CRYPTO_CIPHERTEXTBYTES_COMPRESSED bytes)
+  // Outputs: shared secret ss      (CRYPTO_BYTES bytes)
+    const uint16_t G = 0;
+    const uint16_t H = 1;
+    const uint16_t P = 2;
+    unsigned char ephemeralsk_[SECRETKEY_A_BYTES];
+    unsigned char jinvariant_[FP2_ENCODED_BYTES];
+    unsigned char h_[MSG_BYTES];
+    unsigned char temp[CRYPTO_CIPHERTEXTBYTES_COMPRESSED+MSG_BYTES];
+    int i;
+
+    TRACE_BEGIN("crypto_kem_dec_compressed");
+
+    // Decrypt. A ciphertext whose basis cannot be rebuilt is not a valid one, it fails the check below
+    TRACE_BEGIN("EphemeralSecretAgreement_B_compressed");
+    if (EphemeralSecretAgreement_B_compressed(sk + MSG_BYTES, ct, jinvariant_) != 0) {
+        memset(jinvariant_, 0, FP2_ENCODED_BYTES);
+    }
+    TRACE_END("EphemeralSecretAgreement_B_compressed");
+    cshake256_simple(h_, MSG_BYTES, P, jinvariant_, FP2_ENCODED_BYTES);
+    for (i = 0; i < MSG_BYTES; i++) temp[i] = ct[i + COMPRESSED_PKA_BYTES] ^ h_[i];
+
+    // Generate ephemeralsk_ <- G(m||pk) mod oA
+    memcpy(&temp[MSG_BYTES], &sk[MSG_BYTES + SECRETKEY_B_BYTES], CRYPTO_PUBLICKEYBYTES_COMPRESSED);
+    cshake256_simple(ephemeralsk_, SECRETKEY_A_BYTES, G, temp, CRYPTO_PUBLICKEYBYTES_COMPRESSED+MSG_BYTES);
+    ephemeralsk_[SECRETKEY_A_BYTES - 1] &= MASK_ALICE;
+
+    // Generate shared secret ss <- H(m||ct) or output ss <- H(s||ct)
+    TRACE_BEGIN("EphemeralKeyVerify_A_compressed");
+    ct_cmov(temp, sk, MSG_BYTES, (int8_t)-EphemeralKeyVerify_A_compressed(ephemeralsk_, ct));
+    TRACE_END("EphemeralKeyVerify_A_compressed");
+    memcpy(&temp[MSG_BYTES], ct, CRYPTO_CIPHERTEXTBYTES_COMPRESSED);
+    cshake256_simple(ss, CRYPTO_BYTES, H, temp, CRYPTO_CIPHERTEXTBYTES_COMPRESSED+MSG_BYTES);
+
+    TRACE_END("crypto_kem_dec_compressed");
+    return 0;
+}
+
+#endif
@@ -0,0 +1,131 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: fixed-base ladder tables read from memory-mapped table files
+*********************************************************************************************/
+
+#include <string.h>
+#include "P610_internal.h"
+
+#if defined(TABLE_FILE)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const fixed_base_tables_t table_file_compiled = {
+#if (FIXED_BASE_BITS_ALICE > 0)
+    A_gen_table,
+#else
+    NULL,
+#endif
+#if (FIXED_BASE_BITS_BOB > 0)
+    B_gen_table,
+#else
+    NULL,
+#endif
+    FIXED_BASE_BITS_ALICE, FIXED_BASE_BITS_BOB
+};
+
+// The tables in use are switched by a single pointer store, so that a ladder running during table_file_load reads
+// either the compiled tables or the mapped ones, never a mix of both
+static fixed_base_tables_t table_file_mapped;
+static const fixed_base_tables_t* table_file_current = &table_file_compiled;
+static int table_file_busy = 0;
+
+
+const fixed_base_tables_t* fixed_base_tables(void)
+{ // Tables of the key generation ladders
+    return __atomic_load_n(&table_file_current, __ATOMIC_ACQUIRE);
+}
+
+
+static uint64_t table_file_hash(uint64_t h, const unsigned char* b, size_t n)
+{ // FNV-1a, continued from h, as computed by tools/gen_ladder_tables.py. The initial h is 0xCBF29CE484222325
+    while (n-- > 0) {
+        h = (h ^ *b++)*0x100000001B3;
+    }
+    return h;
+}
+
+
+static int table_file_check(const table_file_header_t* hdr, const unsigned char* data, const size_t size)
+{ // Checks the header of a mapped file of size bytes against this parameter set, then the checksum of the tables
+    uint64_t params;
+    size_t words;
+
+    if (memcmp(hdr->magic, TABLE_FILE_MAGIC, sizeof(hdr->magic)) != 0 || hdr->version != TABLE_FILE_VERSION) {
+        return TABLE_FILE_ERR_FORMAT;
+    }
+    words = (2*(size_t)hdr->bits_alice + (size_t)hdr->bits_bob)*(size_t)hdr->nwords64;
+    if (size != sizeof(table_file_header_t) + 8*words) {
+        return TABLE_FILE_ERR_FORMAT;
+    }
+    params = table_file_hash(0xCBF29CE484222325, (const unsigned char*)A_gen, sizeof(A_gen));
+    params = table_file_hash(params, (const unsigned char*)B_gen, sizeof(B_gen));
+    if (hdr->prime != 610 || hdr->nwords64 != NWORDS64_FIELD || hdr->params != params || hdr->reserved != 0 ||
+        hdr->bits_alice > OALICE_BITS || hdr->bits_bob > OBOB_BITS - 1) {
+        return TABLE_FILE_ERR_PARAMS;
+    }
+    if (table_file_hash(0xCBF29CE484222325, data, 8*words) != hdr->checksum) {
+        return TABLE_FILE_ERR_CHECKSUM;
+    }
+    return TABLE_FILE_OK;
+}
+
+
+static int table_file_map(const char* path)
+{ // Maps the file and checks it, then switches the ladders to its tables
+    table_file_header_t hdr;
+    const unsigned char* map;
+    struct stat st;
+    size_t size;
+    int fd, result;
+
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return TABLE_FILE_ERR_IO;
+    }
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(table_file_header_t)) {
+        close(fd);
+        return TABLE_FILE_ERR_IO;
+    }
+    size = (size_t)st.st_size;
+    map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);                                              // The mapping holds its own reference to the file
+    if (map == MAP_FAILED) {
+        return TABLE_FILE_ERR_IO;
+    }
+
+    memcpy(&hdr, map, sizeof(hdr));
+    result = table_file_check(&hdr, map + sizeof(hdr), size);
+    if (result != TABLE_FILE_OK) {
+        munmap((void*)map, size);
+        return result;
+    }
+    table_file_mapped.A = (hdr.bits_alice > 0) ? (const uint64_t*)(map + sizeof(hdr)) : NULL;
+    table_file_mapped.B = (hdr.bits_bob > 0) ? (const uint64_t*)(map + sizeof(hdr)) + 2*hdr.bits_alice*NWORDS64_FIELD : NULL;
+    table_file_mapped.bits_alice = hdr.bits_alice;
+    table_file_mapped.bits_bob = hdr.bits_bob;
+    __atomic_store_n(&table_file_current, &table_file_mapped, __ATOMIC_RELEASE);
+    return TABLE_FILE_OK;
+}
+
+
+int table_file_load(const char* path)
+{ // The file is mapped shared and read-only, so that its pages are those of the page cache, common to all the
+  // processes mapping it. Verifying the checksum reads them all once, before any ladder uses them
+    int result;
+
+    if (__atomic_exchange_n(&table_file_busy, 1, __ATOMIC_ACQ_REL) != 0) {
+        return TABLE_FILE_ERR_LOADED;
+    }
+    result = table_file_map(path);
+    if (result != TABLE_FILE_OK) {
+        __atomic_store_n(&table_file_busy, 0, __ATOMIC_RELEASE);
+    }
+    return result;
+}
+
+#endif
@@ -0,0 +1,155 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: phase tracing, ring buffer of begin/end events and Chrome trace-event export
+*********************************************************************************************/
+
+#include "P610_internal.h"
+
+#if defined(TRACE)
+
+#if (TARGET == TARGET_ARM)
+    #ifndef TRACE_CLOCK_MHZ
+        #define TRACE_CLOCK_MHZ     24          // Core clock used by the pqm4 benchmarks
+    #endif
+    #define TRACE_DEFAULT_CLOCK     trace_clock_dwt
+    #define TRACE_DEFAULT_RATE      TRACE_CLOCK_MHZ
+#else
+    #include <time.h>
+    #include <x86intrin.h>
+    #define TRACE_DEFAULT_CLOCK     trace_clock_gettime
+    #define TRACE_DEFAULT_RATE      1000
+#endif
+
+static trace_event_t trace_events[TRACE_EVENTS];
+static uint32_t trace_count = 0;                // Events recorded since the last reset, the ring keeps the last TRACE_EVENTS
+static trace_clock_t trace_clock = TRACE_DEFAULT_CLOCK;
+static uint32_t trace_rate = TRACE_DEFAULT_RATE;   // Ticks per microsecond
+
+
+#if (TARGET == TARGET_ARM)
+
+#define TRACE_DEMCR                (*(volatile uint32_t*)0xE000EDFC)
+#define TRACE_DWT_CTRL             (*(volatile uint32_t*)0xE0001000)
+#define TRACE_DWT_CYCCNT           (*(volatile uint32_t*)0xE0001004)
+
+uint64_t trace_clock_dwt(void)
+{ // DWT cycle counter, extended to 64 bits in software. It has to be read at least once every 2^32 cycles
+    static uint32_t enabled = 0, last = 0, high = 0;
+    uint32_t now;
+
+    if (enabled == 0) {
+        TRACE_DEMCR |= (1 << 24);                     // TRCENA
+        TRACE_DWT_CTRL |= 1;                          // CYCCNTENA
+        enabled = 1;
+    }
+    now = TRACE_DWT_CYCCNT;
+    if (now < last) {
+        high++;
+    }
+    last = now;
+    return ((uint64_t)high << 32) | now;
+}
+
+#else
+
+uint64_t trace_clock_rdtsc(void)
+{ // Time-stamp counter
+    return __rdtsc();
+}
+
+
+uint64_t trace_clock_gettime(void)
+{ // Monotonic clock in nanoseconds
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec*1000000000 + (uint64_t)t.tv_nsec;
+}
+
+#endif
+
+
+void trace_set_clock(trace_clock_t clock, const uint32_t ticks_per_us)
+{ // Selects the timestamp source, clock = NULL restores the default of the target
+    if (clock == NULL) {
+        trace_clock = TRACE_DEFAULT_CLOCK;
+        trace_rate = TRACE_DEFAULT_RATE;
+    } else {
+        trace_clock = clock;
+        trace_rate = (ticks_per_us == 0) ? 1 : ticks_per_us;
+    }
+}
+
+
+void trace_record(const char* name, const unsigned int begin)
+{ // Appends an event, overwriting the oldest one when the ring is full
+    trace_event_t* e = &trace_events[trace_count % TRACE_EVENTS];
+
+    e->ts = trace_clock();
+    e->name = name;
+    e->begin = begin;
+    trace_count++;
+}
+
+
+void trace_reset(void)
+{ // Discards all events
+    trace_count = 0;
+}
+
+
+static size_t trace_put(char* out, size_t pos, const size_t outlen, const char* s)
+{ // Appends s at out[pos], pos is set past outlen on overflow so that later calls are no-ops
+    while (*s != 0 && pos < outlen) {
+        out[pos++] = *s++;
+    }
+    return (*s == 0) ? pos : outlen + 1;
+}
+
+
+static size_t trace_put_u64(char* out, size_t pos, const size_t outlen, uint64_t x, unsigned int digits)
+{ // Appends x in decimal, zero-padded to at least digits digits
+    char buf[21];
+    unsigned int i = 20;
+
+    buf[20] = 0;
+    do {
+        buf[--i] = (char)('0' + x % 10);
+        x /= 10;
+    } while ((x != 0 || 20 - i < digits) && i > 0);
+    return trace_put(out, pos, outlen, &buf[i]);
+}
+
+
+size_t trace_export_json(char* out, const size_t outlen)
+{ // Events are exported from the oldest one still in the ring, with timestamps relative to it.
+  // Overwritten events are reported as "dropped" in otherData, end events left without their begin event are ignored by the viewers
+    uint32_t i, first = (trace_count > TRACE_EVENTS) ? trace_count - TRACE_EVENTS : 0;
+    uint64_t t0 = trace_events[first % TRACE_EVENTS].ts, t;
+    size_t pos = 0;
+
+    pos = trace_put(out, pos, outlen, "{\"traceEvents\":[");
+    for (i = first; i < trace_count; i++) {
+        const trace_event_t* e = &trace_events[i % TRACE_EVENTS];
+        t = e->ts - t0;
+        pos = trace_put(out, pos, outlen, (i == first) ? "\n{\"name\":\"" : ",\n{\"name\":\"");
+        pos = trace_put(out, pos, outlen, e->name);
+        pos = trace_put(out, pos, outlen, e->begin ? "\",\"ph\":\"B\",\"pid\":1,\"tid\":1,\"ts\":" : "\",\"ph\":\"E\",\"pid\":1,\"tid\":1,\"ts\":");
+        pos = trace_put_u64(out, pos, outlen, t / trace_rate, 1);
+        pos = trace_put(out, pos, outlen, ".");
+        pos = trace_put_u64(out, pos, outlen, (t % trace_rate) * 1000 / trace_rate, 3);
+        pos = trace_put(out, pos, outlen, "}");
+    }
+    pos = trace_put(out, pos, outlen, "\n],\"otherData\":{\"algorithm\":\"" CRYPTO_ALGNAME "\",\"dropped\":");
+    pos = trace_put_u64(out, pos, outlen, first, 1);
+    pos = trace_put(out, pos, outlen, "}}\n");
+
+    if (pos >= outlen) {                        // No room for the terminating NUL
+        return 0;
+    }
+    out[pos] = 0;
+    return pos;
+}
+
+#endif
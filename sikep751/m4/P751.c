@@ -63,6 +63,10 @@ const uint64_t Montgomery_one[NWORDS64_FIELD]    = { 0x00000000000249ad, 0x00000
                                                      0x5527b1e4375c6c66, 0x697797bf3f4f24d0, 0xc89db7b2ac5c4e2e, 0x4ca4b439d2076956, 0x10f7926c7512c7e9, 0x00002d5b24bce5e2 };
 
 
+// Precomputed multiples of the generators QA and QB for the fixed-base ladders
+#include "P751_tables.h"
+
+
 // Fixed parameters for isogeny tree computation
 const unsigned int strat_Alice[MAX_Alice-1] = { 
 80, 48, 27, 15, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 7, 4, 2, 1, 1, 2, 1, 
@@ -84,6 +88,11 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 1, 1, 1, 21, 12, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 5, 3, 2, 1, 1, 1, 1, 
 2, 1, 1, 1, 9, 5, 3, 2, 1, 1, 1, 1, 2, 1, 1, 1, 4, 2, 1, 1, 1, 2, 1, 1 };
 
+#if defined(THREADS)
+// Strategies of the overlapped traversal of the host thread pool
+#include "P751_strategies.h"
+#endif
+
 // Setting up macro defines and including GF(p), GF(p^2), curve, isogeny and kex functions
 #define fpcopy                        fpcopy751
 #define fpzero                        fpzero751
@@ -108,6 +117,52 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define fp2sqr_mont                   fp2sqr751_mont
 #define fp2inv_mont                   fp2inv751_mont
 #define fp2inv_mont_bingcd            fp2inv751_mont_bingcd
+#define op_count                      op_count751
+#define op_count_phase                op_count_phase751
+#define op_count_snapshot             op_count_snapshot751
+#define op_count_reset                op_count_reset751
+#define strategy_check                strategy_check751
+#define strategy_set                  strategy_set751
+#define strategy_get                  strategy_get751
+#define pool_start                    pool_start751
+#define pool_stop                     pool_stop751
+#define pool_begin                    pool_begin751
+#define pool_submit                   pool_submit751
+#define pool_join                     pool_join751
+#define pool_call                     pool_call751
+#define pool_end                      pool_end751
+#define ifma_available                ifma_available751
+#define KeyGeneration_ifma            KeyGeneration_ifma751
+#define SecretAgreement_ifma          SecretAgreement_ifma751
+#define avx2_available                avx2_available751
+#define KeyGeneration_avx2            KeyGeneration_avx2751
+#define SecretAgreement_avx2          SecretAgreement_avx2751
+#define keypool_config                keypool_config751
+#define keypool_take                  keypool_take751
+#define keypool_refill                keypool_refill751
+#define keypool_size                  keypool_size751
+#define keypool_flush                 keypool_flush751
+#define keypool_start                 keypool_start751
+#define keypool_stop                  keypool_stop751
+#define kemsvc_start                  kemsvc_start751
+#define kemsvc_stop                   kemsvc_stop751
+#define kemsvc_submit                 kemsvc_submit751
+#define kemsvc_drain                  kemsvc_drain751
+#define kemsvc_stats                  kemsvc_stats751
+#define ladder_cache_config           ladder_cache_config751
+#define ladder_cache_flush            ladder_cache_flush751
+#define ladder_cache_stats            ladder_cache_stats751
+#define ladder_cache_acquire          ladder_cache_acquire751
+#define ladder_cache_release          ladder_cache_release751
+#define fixed_base_tables             fixed_base_tables751
+#define table_file_load               table_file_load751
+#define trace_set_clock               trace_set_clock751
+#define trace_record                  trace_record751
+#define trace_reset                   trace_reset751
+#define trace_export_json             trace_export_json751
+#define trace_clock_dwt               trace_clock_dwt751
+#define trace_clock_rdtsc             trace_clock_rdtsc751
+#define trace_clock_gettime           trace_clock_gettime751
 #define fpequal_non_constant_time     fpequal751_non_constant_time
 #define mp_add_asm                    mp_add751_asm
 #define mp_subx2_asm                  mp_sub751x2_asm
@@ -116,4 +171,15 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #include "fpx.c"
 #include "ec_isogeny.c"
 #include "sidh.c"
-#include "sike.c"
\ No newline at end of file
+#include "sike.c"
+#include "trace.c"
+#include "pool.c"
+#include "keypool.c"
+#include "kemsvc.c"
+#include "compression.c"
+#include "laddercache.c"
+#include "tablefile.c"
+#include "AMD64/fp_ifma.c"
+#include "AMD64/sidh_ifma.c"
+#include "AMD64/fp_avx2.c"
+#include "AMD64/sidh_avx2.c"
\ No newline at end of file
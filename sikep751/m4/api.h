@@ -38,6 +38,42 @@ int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk
 // Outputs: shared secret ss      (CRYPTO_BYTES = 24 bytes)
 int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned char *sk);
 
+// Batch versions of the three functions above, for n independent operations. The keys, ciphertexts and shared
+// secrets of the operations are stored one after the other, e.g. pk holds n*CRYPTO_PUBLICKEYBYTES bytes.
+// The outputs are identical to n calls of the single functions, the final inversions being shared (see SIDH_BATCH)
+int crypto_kem_keypair_batch(unsigned char *pk, unsigned char *sk, const unsigned int n);
+int crypto_kem_enc_batch(unsigned char *ct, unsigned char *ss, const unsigned char *pk, const unsigned int n);
+int crypto_kem_dec_batch(unsigned char *ss, const unsigned char *ct, const unsigned char *sk, const unsigned int n);
+
+
+// Expanded public key for repeated encapsulations to the same pk: pk with the decoded images of the basis and the
+// curve constants, which crypto_kem_enc otherwise computes on each call. Filled by crypto_kem_pk_expand, its content is internal
+typedef struct {
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES];
+    digit_t expanded[5*2*NBYTES_TO_NWORDS(96)];         // 5 GF(p751^2) elements
+} crypto_kem_pk_expanded_t;
+
+int crypto_kem_pk_expand(crypto_kem_pk_expanded_t *epk, const unsigned char *pk);
+
+// SIKE's encapsulation to an expanded public key, same output as crypto_kem_enc on its pk
+int crypto_kem_enc_expanded(unsigned char *ct, unsigned char *ss, const crypto_kem_pk_expanded_t *epk);
+
+
+#if defined(COMPRESS)
+
+// Variants of the three functions above with compressed public keys and ciphertexts (-D _COMPRESS_), of
+// CRYPTO_PUBLICKEYBYTES_COMPRESSED = 332 and CRYPTO_CIPHERTEXTBYTES_COMPRESSED = 367 bytes instead of 564 and 596.
+// They are not interoperable with the uncompressed functions. crypto_kem_keypair_compressed returns 1 with a negligible
+// probability, crypto_kem_enc_compressed returns 1 if pk is invalid
+#define CRYPTO_SECRETKEYBYTES_COMPRESSED     412    // MSG_BYTES + SECRETKEY_B_BYTES + CRYPTO_PUBLICKEYBYTES_COMPRESSED bytes
+#define CRYPTO_PUBLICKEYBYTES_COMPRESSED     332
+#define CRYPTO_CIPHERTEXTBYTES_COMPRESSED    367    // 335-byte compressed ephemeral public key + MSG_BYTES bytes
+
+int crypto_kem_keypair_compressed(unsigned char *pk, unsigned char *sk);
+int crypto_kem_enc_compressed(unsigned char *ct, unsigned char *ss, const unsigned char *pk);
+int crypto_kem_dec_compressed(unsigned char *ss, const unsigned char *ct, const unsigned char *sk);
+
+#endif
 
 // Encoding of keys for KEM-based isogeny system "SIKEp751" (wire format):
 // ----------------------------------------------------------------------
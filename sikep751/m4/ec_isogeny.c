@@ -26,6 +26,110 @@ void xDBL(const point_proj_t P, point_proj_t Q, const f2elm_t A24plus, const f2e
 }
 
 
+#if (TARGET == TARGET_ARM)
+
+void __attribute__ ((noinline, naked)) xDBLe(const point_proj_t P, point_proj_t Q, const f2elm_t A24plus, const f2elm_t C24, const int e)
+{ // Computes [2^e](X:Z) on Montgomery curve with projective constant via e repeated doublings.
+  // Input: projective Montgomery x-coordinates P = (XP:ZP), such that xP=XP/ZP and Montgomery curve constants A+2C and 4C.
+  // Output: projective Montgomery x-coordinates Q <- (2^e)*P.
+  // The doublings are chained through the kernels of fpx.c in a single frame: A24plus and C24 with the sums of their
+  // halves, loaded once, at [SP] and [SP+4*72], then t0 and t1 at [SP+4*144] and [SP+4*192]. Q and the remaining count
+  // are kept in S0 and S1.
+asm volatile(\
+"PUSH {R4-R11, R14} \n\t"
+"LDR R4, [SP, #4 * 9] \n\t"
+"VMOV S0, R1 \n\t"
+"VMOV S1, R4 \n\t"
+"VMOV S2, R3 \n\t"
+"SUB SP, #4*240 \n\t"
+
+//Q = P
+"MOV R12, #24 \n\t"
+"1: \n\t"
+"LDMIA R0!, {R4-R7} \n\t"
+"STMIA R1!, {R4-R7} \n\t"
+"SUBS R12, R12, #1 \n\t"
+"BNE 1b \n\t"
+
+//A24plus and C24, loaded once
+"MOV R0, R2 \n\t"
+"MOV R1, SP \n\t"
+"BL fp2pre_chain \n\t"
+"VMOV R0, S2 \n\t"
+"ADD R1, SP, #4*72 \n\t"
+"BL fp2pre_chain \n\t"
+
+"VMOV R0, S1 \n\t"
+"CMP R0, #0 \n\t"
+"BLE 3f \n\t"
+"2: \n\t"
+//t0 = X-Z
+"VMOV R0, S0 \n\t"
+"ADD R1, R0, #4*48 \n\t"
+"ADD R2, SP, #4*144 \n\t"
+"BL fp2sub_chain \n\t"
+//t1 = X+Z
+"VMOV R0, S0 \n\t"
+"ADD R1, R0, #4*48 \n\t"
+"ADD R2, SP, #4*192 \n\t"
+"BL fp2add_chain \n\t"
+//t0 = (X-Z)^2
+"ADD R0, SP, #4*144 \n\t"
+"MOV R1, R0 \n\t"
+"BL fp2sqr_chain \n\t"
+//t1 = (X+Z)^2
+"ADD R0, SP, #4*192 \n\t"
+"MOV R1, R0 \n\t"
+"BL fp2sqr_chain \n\t"
+//Z = C24*t0
+"ADD R0, SP, #4*144 \n\t"
+"ADD R1, SP, #4*72 \n\t"
+"VMOV R2, S0 \n\t"
+"ADD R2, R2, #4*48 \n\t"
+"BL fp2mulk_chain \n\t"
+//X = t1*Z
+"ADD R0, SP, #4*192 \n\t"
+"VMOV R2, S0 \n\t"
+"ADD R1, R2, #4*48 \n\t"
+"BL fp2mul_chain \n\t"
+//t1 = t1-t0
+"ADD R0, SP, #4*192 \n\t"
+"ADD R1, SP, #4*144 \n\t"
+"MOV R2, R0 \n\t"
+"BL fp2sub_chain \n\t"
+//t0 = A24plus*t1
+"ADD R0, SP, #4*192 \n\t"
+"MOV R1, SP \n\t"
+"ADD R2, SP, #4*144 \n\t"
+"BL fp2mulk_chain \n\t"
+//Z = Z+t0
+"VMOV R0, S0 \n\t"
+"ADD R0, R0, #4*48 \n\t"
+"ADD R1, SP, #4*144 \n\t"
+"MOV R2, R0 \n\t"
+"BL fp2add_chain \n\t"
+//Z = Z*t1
+"VMOV R0, S0 \n\t"
+"ADD R0, R0, #4*48 \n\t"
+"ADD R1, SP, #4*192 \n\t"
+"MOV R2, R0 \n\t"
+"BL fp2mul_chain \n\t"
+
+"VMOV R0, S1 \n\t"
+"SUBS R0, R0, #1 \n\t"
+"VMOV S1, R0 \n\t"
+"BNE 2b \n\t"
+"3: \n\t"
+"ADD SP, #4*240 \n\t"
+"POP {R4-R11, PC} \n\t"
+  :
+  :
+  : "cc", "memory"
+);
+}
+
+#else
+
 void xDBLe(const point_proj_t P, point_proj_t Q, const f2elm_t A24plus, const f2elm_t C24, const int e)
 { // Computes [2^e](X:Z) on Montgomery curve with projective constant via e repeated doublings.
   // Input: projective Montgomery x-coordinates P = (XP:ZP), such that xP=XP/ZP and Montgomery curve constants A+2C and 4C.
@@ -39,6 +143,8 @@ void xDBLe(const point_proj_t P, point_proj_t Q, const f2elm_t A24plus, const f2
     }
 }
 
+#endif
+
 #if (OALICE_BITS % 2 == 1)
 
 void get_2_isog(const point_proj_t P, f2elm_t A, f2elm_t C)
@@ -145,6 +251,164 @@ void xTPL(const point_proj_t P, point_proj_t Q, const f2elm_t A24minus, const f2
 }
 
 
+#if (TARGET == TARGET_ARM)
+
+void __attribute__ ((noinline, naked)) xTPLe(const point_proj_t P, point_proj_t Q, const f2elm_t A24minus, const f2elm_t A24plus, const int e)
+{ // Computes [3^e](X:Z) on Montgomery curve with projective constant via e repeated triplings.
+  // Input: projective Montgomery x-coordinates P = (XP:ZP), such that xP=XP/ZP and Montgomery curve constants A24plus = A+2C and A24minus = A-2C.
+  // Output: projective Montgomery x-coordinates Q <- (3^e)*P.
+  // The triplings are chained as the doublings of xDBLe: A24minus and A24plus with the sums of their halves at [SP]
+  // and [SP+4*72], then t0 to t6 from [SP+4*144] on. Q and the remaining count are kept in S0 and S1.
+asm volatile(\
+"PUSH {R4-R11, R14} \n\t"
+"LDR R4, [SP, #4 * 9] \n\t"
+"VMOV S0, R1 \n\t"
+"VMOV S1, R4 \n\t"
+"VMOV S2, R3 \n\t"
+"SUB SP, #4*480 \n\t"
+
+//Q = P
+"MOV R12, #24 \n\t"
+"1: \n\t"
+"LDMIA R0!, {R4-R7} \n\t"
+"STMIA R1!, {R4-R7} \n\t"
+"SUBS R12, R12, #1 \n\t"
+"BNE 1b \n\t"
+
+//A24minus and A24plus, loaded once
+"MOV R0, R2 \n\t"
+"MOV R1, SP \n\t"
+"BL fp2pre_chain \n\t"
+"VMOV R0, S2 \n\t"
+"ADD R1, SP, #4*72 \n\t"
+"BL fp2pre_chain \n\t"
+
+"VMOV R0, S1 \n\t"
+"CMP R0, #0 \n\t"
+"BLE 3f \n\t"
+"2: \n\t"
+//t0 = X-Z
+"VMOV R0, S0 \n\t"
+"ADD R1, R0, #4*48 \n\t"
+"ADD R2, SP, #4*144 \n\t"
+"BL fp2sub_chain \n\t"
+//t2 = (X-Z)^2
+"ADD R0, SP, #4*144 \n\t"
+"ADD R1, SP, #4*240 \n\t"
+"BL fp2sqr_chain \n\t"
+//t1 = X+Z
+"VMOV R0, S0 \n\t"
+"ADD R1, R0, #4*48 \n\t"
+"ADD R2, SP, #4*192 \n\t"
+"BL fp2add_chain \n\t"
+//t3 = (X+Z)^2
+"ADD R0, SP, #4*192 \n\t"
+"ADD R1, SP, #4*288 \n\t"
+"BL fp2sqr_chain \n\t"
+//t4 = 2*X
+"ADD R0, SP, #4*144 \n\t"
+"ADD R1, SP, #4*192 \n\t"
+"ADD R2, SP, #4*336 \n\t"
+"BL fp2add_chain \n\t"
+//t0 = 2*Z
+"ADD R0, SP, #4*192 \n\t"
+"ADD R1, SP, #4*144 \n\t"
+"MOV R2, R1 \n\t"
+"BL fp2sub_chain \n\t"
+//t1 = 4*X^2
+"ADD R0, SP, #4*336 \n\t"
+"ADD R1, SP, #4*192 \n\t"
+"BL fp2sqr_chain \n\t"
+//t1 = 4*X^2 - (X+Z)^2
+"ADD R0, SP, #4*192 \n\t"
+"ADD R1, SP, #4*288 \n\t"
+"MOV R2, R0 \n\t"
+"BL fp2sub_chain \n\t"
+//t1 = 4*X^2 - (X+Z)^2 - (X-Z)^2
+"ADD R0, SP, #4*192 \n\t"
+"ADD R1, SP, #4*240 \n\t"
+"MOV R2, R0 \n\t"
+"BL fp2sub_chain \n\t"
+//t5 = A24plus*(X+Z)^2
+"ADD R0, SP, #4*288 \n\t"
+"ADD R1, SP, #4*72 \n\t"
+"ADD R2, SP, #4*384 \n\t"
+"BL fp2mulk_chain \n\t"
+//t3 = A24plus*(X+Z)^3
+"ADD R0, SP, #4*288 \n\t"
+"ADD R1, SP, #4*384 \n\t"
+"MOV R2, R0 \n\t"
+"BL fp2mul_chain \n\t"
+//t6 = A24minus*(X-Z)^2
+"ADD R0, SP, #4*240 \n\t"
+"MOV R1, SP \n\t"
+"ADD R2, SP, #4*432 \n\t"
+"BL fp2mulk_chain \n\t"
+//t2 = A24minus*(X-Z)^3
+"ADD R0, SP, #4*240 \n\t"
+"ADD R1, SP, #4*432 \n\t"
+"MOV R2, R0 \n\t"
+"BL fp2mul_chain \n\t"
+//t3 = A24minus*(X-Z)^3 - A24plus*(X+Z)^3
+"ADD R0, SP, #4*240 \n\t"
+"ADD R1, SP, #4*288 \n\t"
+"MOV R2, R1 \n\t"
+"BL fp2sub_chain \n\t"
+//t2 = A24plus*(X+Z)^2 - A24minus*(X-Z)^2
+"ADD R0, SP, #4*384 \n\t"
+"ADD R1, SP, #4*432 \n\t"
+"ADD R2, SP, #4*240 \n\t"
+"BL fp2sub_chain \n\t"
+//t1 = [4*X^2 - (X+Z)^2 - (X-Z)^2]*[A24plus*(X+Z)^2 - A24minus*(X-Z)^2]
+"ADD R0, SP, #4*192 \n\t"
+"ADD R1, SP, #4*240 \n\t"
+"MOV R2, R0 \n\t"
+"BL fp2mul_chain \n\t"
+//t2 = t1 + A24minus*(X-Z)^3 - A24plus*(X+Z)^3
+"ADD R0, SP, #4*288 \n\t"
+"ADD R1, SP, #4*192 \n\t"
+"ADD R2, SP, #4*240 \n\t"
+"BL fp2add_chain \n\t"
+//t2 = t2^2
+"ADD R0, SP, #4*240 \n\t"
+"MOV R1, R0 \n\t"
+"BL fp2sqr_chain \n\t"
+//X3 = 2*X*t2
+"ADD R0, SP, #4*336 \n\t"
+"ADD R1, SP, #4*240 \n\t"
+"VMOV R2, S0 \n\t"
+"BL fp2mul_chain \n\t"
+//t1 = A24minus*(X-Z)^3 - A24plus*(X+Z)^3 - t1
+"ADD R0, SP, #4*288 \n\t"
+"ADD R1, SP, #4*192 \n\t"
+"MOV R2, R1 \n\t"
+"BL fp2sub_chain \n\t"
+//t1 = t1^2
+"ADD R0, SP, #4*192 \n\t"
+"MOV R1, R0 \n\t"
+"BL fp2sqr_chain \n\t"
+//Z3 = 2*Z*t1
+"ADD R0, SP, #4*144 \n\t"
+"ADD R1, SP, #4*192 \n\t"
+"VMOV R2, S0 \n\t"
+"ADD R2, R2, #4*48 \n\t"
+"BL fp2mul_chain \n\t"
+
+"VMOV R0, S1 \n\t"
+"SUBS R0, R0, #1 \n\t"
+"VMOV S1, R0 \n\t"
+"BNE 2b \n\t"
+"3: \n\t"
+"ADD SP, #4*480 \n\t"
+"POP {R4-R11, PC} \n\t"
+  :
+  :
+  : "cc", "memory"
+);
+}
+
+#else
+
 void xTPLe(const point_proj_t P, point_proj_t Q, const f2elm_t A24minus, const f2elm_t A24plus, const int e)
 { // Computes [3^e](X:Z) on Montgomery curve with projective constant via e repeated triplings.
   // Input: projective Montgomery x-coordinates P = (XP:ZP), such that xP=XP/ZP and Montgomery curve constants A24plus = A+2C and A24minus = A-2C.
@@ -158,6 +422,8 @@ void xTPLe(const point_proj_t P, point_proj_t Q, const f2elm_t A24minus, const f
     }
 }
 
+#endif
+
 
 void get_3_isog(const point_proj_t P, f2elm_t A24minus, f2elm_t A24plus, f2elm_t* coeff)
 { // Computes the corresponding 3-isogeny of a projective Montgomery point (X3:Z3) of order 3.
@@ -223,6 +489,22 @@ void inv_3_way(f2elm_t z1, f2elm_t z2, f2elm_t z3)
 }
 
 
+void proj_to_affine(point_proj_t* P, const int n, f2elm_t* x, f2elm_t* z)
+{ // Simultaneous conversion of n points to affine x-coordinates using a single inversion
+  // Input:  projective points P[0..n-1] with nonzero Z, scratch z with room for n elements
+  // Output: x[i] = X_i/Z_i.
+    int i;
+
+    for (i = 0; i < n; i++) {
+        fp2copy(P[i]->Z, z[i]);
+    }
+    mont_n_way_inv((const f2elm_t*)z, n, x);      // x[i] = 1/Z_i
+    for (i = 0; i < n; i++) {
+        fp2mul_mont(P[i]->X, x[i], x[i]);         // x[i] = X_i/Z_i
+    }
+}
+
+
 void get_A(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xR, f2elm_t A)
 { // Given the x-coordinates of P, Q, and R, returns the value A corresponding to the Montgomery curve E_A: y^2=x^3+A*x^2+x such that R=Q-P on E_A.
   // Input:  the x-coordinates xP, xQ, and xR of the points P, Q and R.
@@ -246,34 +528,74 @@ void get_A(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xR, f2elm_t A)
 }
 
 
-void j_inv(const f2elm_t A, const f2elm_t C, f2elm_t jinv)
-{ // Computes the j-invariant of a Montgomery curve with projective constant.
+void get_A_proj(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xR, f2elm_t A, f2elm_t C)
+{ // Given the x-coordinates of P, Q, and R, returns the projective coefficients (A:C) of the Montgomery curve E_(A/C) such that R=Q-P on E_(A/C).
+  // Input:  the x-coordinates xP, xQ, and xR of the points P, Q and R.
+  // Output: the coefficients A and C, with C in GF(p), such that A/C is the output of get_A. Avoids the inversion of get_A.
+    f2elm_t t0, t1, one = {0};
+    felm_t t2;
+    
+    fpcopy((digit_t*)&Montgomery_one, one[0]);
+    fp2add(xP, xQ, t1);                           // t1 = xP+xQ
+    fp2mul_mont(xP, xQ, t0);                      // t0 = xP*xQ
+    fp2mul_mont(xR, t1, A);                       // A = xR*t1
+    fp2add(t0, A, A);                             // A = A+t0
+    fp2mul_mont(t0, xR, t0);                      // t0 = t0*xR
+    fp2sub(A, one, A);                            // A = A-1
+    fp2add(t0, t0, t0);                           // t0 = t0+t0
+    fp2add(t1, xR, t1);                           // t1 = t1+xR
+    fp2add(t0, t0, t0);                           // t0 = t0+t0
+    fp2sqr_mont(A, A);                            // A = A^2
+    fpsqr_mont(t0[0], C[0]);                      // C = t0_0^2
+    fpsqr_mont(t0[1], t2);                        // t2 = t0_1^2
+    fpadd(C[0], t2, C[0]);                        // C = t0_0^2+t0_1^2 = t0*conj(t0)
+    fpzero(C[1]);
+    fpneg(t0[1]);                                 // t0 = conj(t0)
+    fp2mul_mont(A, t0, A);                        // A = A*conj(t0)
+    fpmul_mont(t1[0], C[0], t1[0]);
+    fpmul_mont(t1[1], C[0], t1[1]);               // t1 = t1*C
+    fp2sub(A, t1, A);                             // Afinal = A-t1
+}
+
+
+void j_inv_proj(const f2elm_t A, const f2elm_t C, f2elm_t num, f2elm_t den)
+{ // Computes the j-invariant of a Montgomery curve with projective constant as a fraction.
   // Input: A,C in GF(p^2).
-  // Output: j=256*(A^2-3*C^2)^3/(C^4*(A^2-4*C^2)), which is the j-invariant of the Montgomery curve B*y^2=x^3+(A/C)*x^2+x or (equivalently) j-invariant of B'*y^2=C*x^3+A*x^2+C*x.
-    f2elm_t t0, t1;
+  // Output: num = 256*(A^2-3*C^2)^3 and den = C^4*(A^2-4*C^2), j = num/den. Avoids the inversion of j_inv.
+    f2elm_t t1;
     
-    fp2sqr_mont(A, jinv);                           // jinv = A^2        
+    fp2sqr_mont(A, den);                            // den = A^2        
     fp2sqr_mont(C, t1);                             // t1 = C^2
-    fp2add(t1, t1, t0);                             // t0 = t1+t1
-    fp2sub(jinv, t0, t0);                           // t0 = jinv-t0
-    fp2sub(t0, t1, t0);                             // t0 = t0-t1
-    fp2sub(t0, t1, jinv);                           // jinv = t0-t1
+    fp2add(t1, t1, num);                            // num = t1+t1
+    fp2sub(den, num, num);                          // num = den-num
+    fp2sub(num, t1, num);                           // num = num-t1
+    fp2sub(num, t1, den);                           // den = num-t1
     fp2sqr_mont(t1, t1);                            // t1 = t1^2
-    fp2mul_mont(jinv, t1, jinv);                    // jinv = jinv*t1
-    fp2add(t0, t0, t0);                             // t0 = t0+t0
-    fp2add(t0, t0, t0);                             // t0 = t0+t0
-    fp2sqr_mont(t0, t1);                            // t1 = t0^2
-    fp2mul_mont(t0, t1, t0);                        // t0 = t0*t1
-    fp2add(t0, t0, t0);                             // t0 = t0+t0
-    fp2add(t0, t0, t0);                             // t0 = t0+t0
+    fp2mul_mont(den, t1, den);                      // den = den*t1
+    fp2add(num, num, num);                          // num = num+num
+    fp2add(num, num, num);                          // num = num+num
+    fp2sqr_mont(num, t1);                           // t1 = num^2
+    fp2mul_mont(num, t1, num);                      // num = num*t1
+    fp2add(num, num, num);                          // num = num+num
+    fp2add(num, num, num);                          // num = num+num
+}
+
+
+void j_inv(const f2elm_t A, const f2elm_t C, f2elm_t jinv)
+{ // Computes the j-invariant of a Montgomery curve with projective constant.
+  // Input: A,C in GF(p^2).
+  // Output: j=256*(A^2-3*C^2)^3/(C^4*(A^2-4*C^2)), which is the j-invariant of the Montgomery curve B*y^2=x^3+(A/C)*x^2+x or (equivalently) j-invariant of B'*y^2=C*x^3+A*x^2+C*x.
+    f2elm_t t0;
+
+    j_inv_proj(A, C, t0, jinv);                     // j = t0/jinv
     fp2inv_mont(jinv);                              // jinv = 1/jinv 
     fp2mul_mont(jinv, t0, jinv);                    // jinv = t0*jinv
 }
 
 
-void xDBLADD(point_proj_t P, point_proj_t Q, const f2elm_t xPQ, const f2elm_t A24)
+void xDBLADD(point_proj_t P, point_proj_t Q, const f2elm_t xPQ, const f2elm_t A24plus, const felm_t C24)
 { // Simultaneous doubling and differential addition.
-  // Input: projective Montgomery points P=(XP:ZP) and Q=(XQ:ZQ) such that xP=XP/ZP and xQ=XQ/ZQ, affine difference xPQ=x(P-Q) and Montgomery curve constant A24=(A+2)/4.
+  // Input: projective Montgomery points P=(XP:ZP) and Q=(XQ:ZQ) such that xP=XP/ZP and xQ=XQ/ZQ, affine difference xPQ=x(P-Q) and Montgomery curve constants A+2C and 4C, with C in GF(p).
   // Output: projective Montgomery points P <- 2*P = (X2P:Z2P) such that x(2P)=X2P/Z2P, and Q <- P+Q = (XQP:ZQP) such that = x(Q+P)=XQP/ZQP. 
     f2elm_t t0, t1, t2;
 
@@ -287,12 +609,14 @@ void xDBLADD(point_proj_t P, point_proj_t Q, const f2elm_t xPQ, const f2elm_t A2
     fp2sqr_mont(t1, P->Z);                          // ZP = (XP-ZP)^2
     fp2mul_mont(t1, Q->X, t1);                      // t1 = (XP-ZP)*(XQ+ZQ)
     fp2sub(P->X, P->Z, t2);                         // t2 = (XP+ZP)^2-(XP-ZP)^2
-    fp2mul_mont(P->X, P->Z, P->X);                  // XP = (XP+ZP)^2*(XP-ZP)^2
-    fp2mul_mont(t2, A24, Q->X);                     // XQ = A24*[(XP+ZP)^2-(XP-ZP)^2]
+    fpmul_mont(P->Z[0], C24, P->Z[0]);
+    fpmul_mont(P->Z[1], C24, P->Z[1]);              // ZP = C24*(XP-ZP)^2
+    fp2mul_mont(P->X, P->Z, P->X);                  // XP = C24*(XP+ZP)^2*(XP-ZP)^2
+    fp2mul_mont(t2, A24plus, Q->X);                 // XQ = A24plus*[(XP+ZP)^2-(XP-ZP)^2]
     fp2sub(t0, t1, Q->Z);                           // ZQ = (XP+ZP)*(XQ-ZQ)-(XP-ZP)*(XQ+ZQ)
-    fp2add(Q->X, P->Z, P->Z);                       // ZP = A24*[(XP+ZP)^2-(XP-ZP)^2]+(XP-ZP)^2
+    fp2add(Q->X, P->Z, P->Z);                       // ZP = A24plus*[(XP+ZP)^2-(XP-ZP)^2]+C24*(XP-ZP)^2
     fp2add(t0, t1, Q->X);                           // XQ = (XP+ZP)*(XQ-ZQ)+(XP-ZP)*(XQ+ZQ)
-    fp2mul_mont(P->Z, t2, P->Z);                    // ZP = [A24*[(XP+ZP)^2-(XP-ZP)^2]+(XP-ZP)^2]*[(XP+ZP)^2-(XP-ZP)^2]
+    fp2mul_mont(P->Z, t2, P->Z);                    // ZP = [A24plus*[(XP+ZP)^2-(XP-ZP)^2]+C24*(XP-ZP)^2]*[(XP+ZP)^2-(XP-ZP)^2]
     fp2sqr_mont(Q->Z, Q->Z);                        // ZQ = [(XP+ZP)*(XQ-ZQ)-(XP-ZP)*(XQ+ZQ)]^2
     fp2sqr_mont(Q->X, Q->X);                        // XQ = [(XP+ZP)*(XQ-ZQ)+(XP-ZP)*(XQ+ZQ)]^2
     fp2mul_mont(Q->Z, xPQ, Q->Z);                   // ZQ = xPQ*[(XP+ZP)*(XQ-ZQ)-(XP-ZP)*(XQ+ZQ)]^2
@@ -305,6 +629,7 @@ static void swap_points(point_proj_t P, point_proj_t Q, const digit_t option)
     digit_t temp;
     unsigned int i;
 
+    OP_COUNT_INC(OP_SWAP_POINTS);
     for (i = 0; i < NWORDS_FIELD; i++) {
         temp = option & (P->X[0][i] ^ Q->X[0][i]);
         P->X[0][i] = temp ^ P->X[0][i]; 
@@ -322,26 +647,20 @@ static void swap_points(point_proj_t P, point_proj_t Q, const digit_t option)
 }
 
 
-static void LADDER3PT(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, const digit_t* m, const unsigned int AliceOrBob, point_proj_t R, const f2elm_t A)
-{
+static void LADDER3PT(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, const digit_t* m, const unsigned int AliceOrBob, point_proj_t R, const f2elm_t A24plus, const felm_t C24)
+{ // Three-point ladder computing R = x(P+[m]Q) on the curve with projective constants A24plus = A+2C and C24 = 4C, where C is in GF(p).
     point_proj_t R0 = {0}, R2 = {0};
-    f2elm_t A24 = {0};
     digit_t mask;
     int i, nbits, bit, swap, prevbit = 0;
 
     if (AliceOrBob == ALICE) {
         nbits = OALICE_BITS;
-    } else {
+    } else if (AliceOrBob == BOB) {
         nbits = OBOB_BITS - 1;
+    } else {
+        nbits = OBOB_BITS;
     }
 
-    // Initializing constant
-    fpcopy((digit_t*)&Montgomery_one, A24[0]);
-    fp2add(A24, A24, A24);
-    fp2add(A, A24, A24);
-    fp2div2(A24, A24);  
-    fp2div2(A24, A24);  // A24 = (A+2)/4
-
     // Initializing points
     fp2copy(xQ, R0->X);
     fpcopy((digit_t*)&Montgomery_one, (digit_t*)R0->Z);
@@ -359,10 +678,178 @@ static void LADDER3PT(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, con
         mask = 0 - (digit_t)swap;
 
         swap_points(R, R2, mask);
-        xDBLADD(R0, R2, R->X, A24);
+        xDBLADD(R0, R2, R->X, A24plus, C24);
         fp2mul_mont(R2->X, R->Z, R2->X);
     }
     swap = 0 ^ prevbit;
     mask = 0 - (digit_t)swap;
     swap_points(R, R2, mask);
+}
+
+#if (FIXED_BASE_BITS_ALICE > 0) || defined(LADDER_CACHE) || defined(TABLE_FILE)
+
+static void xADDproj(point_proj_t P, const point_proj_t Q, const point_proj_t PQ)
+{ // Differential addition with a projective difference.
+  // Input: projective Montgomery points P=(XP:ZP) and Q=(XQ:ZQ), and their difference PQ=(XPQ:ZPQ) such that x(P-Q)=XPQ/ZPQ.
+  // Output: projective Montgomery point P <- P+Q = (XQP:ZQP) such that x(Q+P)=XQP/ZQP.
+    f2elm_t t0, t1, t2;
+
+    fp2add(P->X, P->Z, t0);                         // t0 = XP+ZP
+    fp2sub(P->X, P->Z, t1);                         // t1 = XP-ZP
+    fp2sub(Q->X, Q->Z, t2);                         // t2 = XQ-ZQ
+    fp2mul_mont(t0, t2, t0);                        // t0 = (XP+ZP)*(XQ-ZQ)
+    fp2add(Q->X, Q->Z, t2);                         // t2 = XQ+ZQ
+    fp2mul_mont(t1, t2, t1);                        // t1 = (XP-ZP)*(XQ+ZQ)
+    fp2sub(t0, t1, P->Z);                           // ZP = (XP+ZP)*(XQ-ZQ)-(XP-ZP)*(XQ+ZQ)
+    fp2add(t0, t1, P->X);                           // XP = (XP+ZP)*(XQ-ZQ)+(XP-ZP)*(XQ+ZQ)
+    fp2sqr_mont(P->Z, P->Z);                        // ZP = [(XP+ZP)*(XQ-ZQ)-(XP-ZP)*(XQ+ZQ)]^2
+    fp2sqr_mont(P->X, P->X);                        // XP = [(XP+ZP)*(XQ-ZQ)+(XP-ZP)*(XQ+ZQ)]^2
+    fp2mul_mont(P->Z, PQ->X, P->Z);                 // ZP = XPQ*[(XP+ZP)*(XQ-ZQ)-(XP-ZP)*(XQ+ZQ)]^2
+    fp2mul_mont(P->X, PQ->Z, P->X);                 // XP = ZPQ*[(XP+ZP)*(XQ-ZQ)+(XP-ZP)*(XQ+ZQ)]^2
+}
+
+
+static void LADDER3PT_FB(const f2elm_t xP, const f2elm_t xPQ, const uint64_t* table, const int ntable, const digit_t* m, const unsigned int AliceOrBob, point_proj_t R)
+{ // Right-to-left three-point ladder for the generators of the starting curve E_6, computing R = x(P+[m]Q).
+  // The affine x-coordinates of [2^i]Q, i = 0..ntable-1, are read from a precomputed table (see tools/gen_ladder_tables.py), 
+  // so that each bit costs one differential addition. Beyond ntable, [2^i]Q is obtained by doubling. Requires ntable > 0.
+  // With a table of all the bits, as built by the ladder cache, no doubling is done and the curve may be any one.
+    point_proj_t R0 = {0}, R2 = {0};
+    f2elm_t A24plus = {0}, C24 = {0};
+    digit_t mask;
+    int i, nbits, bit, swap, prevbit = 0;
+
+    if (AliceOrBob == ALICE) {
+        nbits = OALICE_BITS;
+    } else {
+        nbits = OBOB_BITS - 1;
+    }
+
+    // Initializing constants: A24plus = A+2C, C24 = 4C, where A=6, C=1
+    fpcopy((digit_t*)&Montgomery_one, A24plus[0]);
+    fp2add(A24plus, A24plus, A24plus);
+    fp2add(A24plus, A24plus, C24);
+    fp2add(C24, C24, A24plus);
+
+    // Initializing points: R0 = [2^i]Q, R = P+[m mod 2^i]Q and R2 = R0-R
+    fpcopy((digit_t*)&Montgomery_one, (digit_t*)R0->Z);
+    fp2copy(xPQ, R2->X);
+    fpcopy((digit_t*)&Montgomery_one, (digit_t*)R2->Z);
+    fp2copy(xP, R->X);
+    fpcopy((digit_t*)&Montgomery_one, (digit_t*)R->Z);
+    fpzero((digit_t*)(R->Z)[1]);
+
+    // Main loop: R0 is added to R if the bit is set and to R2 otherwise, the swaps keep the updated point in R2
+    for (i = 0; i < nbits; i++) {
+        if (i < ntable) {
+            fpcopy((digit_t*)table + 2*i*NWORDS_FIELD, R0->X[0]);
+            fpcopy((digit_t*)table + (2*i+1)*NWORDS_FIELD, R0->X[1]);
+        } else {
+            xDBL(R0, R0, A24plus, C24);
+        }
+        bit = (m[i >> LOG2RADIX] >> (i & (RADIX-1))) & 1;
+        swap = bit ^ prevbit;
+        prevbit = bit;
+        mask = 0 - (digit_t)swap;
+
+        swap_points(R, R2, mask);
+        xADDproj(R2, R0, R);
+    }
+    swap = 0 ^ prevbit;
+    mask = 0 - (digit_t)swap;
+    swap_points(R, R2, mask);
+}
+
+#endif
+
+static void xDBL_fp(felm_t X, felm_t Z)
+{ // Doubling of a GF(p)-rational x-coordinate on the starting curve E_6 in projective coordinates (X:Z).
+  // Input: projective Montgomery x-coordinates P = (X:Z) in GF(p). With A24plus = 8 and C24 = 4, the common factor 4 is dropped.
+  // Output: projective Montgomery x-coordinates (X:Z) <- 2*P.
+    felm_t t0, t1;
+
+    fpsub(X, Z, t0);                                // t0 = X-Z
+    fpadd(X, Z, t1);                                // t1 = X+Z
+    fpsqr_mont(t0, t0);                             // t0 = (X-Z)^2
+    fpsqr_mont(t1, t1);                             // t1 = (X+Z)^2
+    fpmul_mont(t0, t1, X);                          // X = (X-Z)^2*(X+Z)^2
+    fpsub(t1, t0, t1);                              // t1 = (X+Z)^2-(X-Z)^2 = 4XZ
+    fpadd(t0, t1, t0);
+    fpadd(t0, t1, t0);                              // t0 = (X-Z)^2+2*4XZ
+    fpmul_mont(t0, t1, Z);                          // Z = [(X-Z)^2+2*4XZ]*4XZ
+}
+
+
+static void xADD_fp(point_proj_t P, const felm_t XQ, const felm_t ZQ, const point_proj_t PQ)
+{ // Differential addition of a GF(p)-rational x-coordinate, with a projective difference.
+  // Input: projective Montgomery points P=(XP:ZP) and Q=(XQ:ZQ) with XQ, ZQ in GF(p), and their difference PQ=(XPQ:ZPQ) such that x(P-Q)=XPQ/ZPQ.
+  // Output: projective Montgomery point P <- P+Q = (XQP:ZQP) such that x(Q+P)=XQP/ZQP.
+    f2elm_t t0, t1;
+    felm_t t2;
+
+    fp2add(P->X, P->Z, t0);                         // t0 = XP+ZP
+    fp2sub(P->X, P->Z, t1);                         // t1 = XP-ZP
+    fpsub(XQ, ZQ, t2);                              // t2 = XQ-ZQ
+    fpmul_mont(t0[0], t2, t0[0]);
+    fpmul_mont(t0[1], t2, t0[1]);                   // t0 = (XP+ZP)*(XQ-ZQ)
+    fpadd(XQ, ZQ, t2);                              // t2 = XQ+ZQ
+    fpmul_mont(t1[0], t2, t1[0]);
+    fpmul_mont(t1[1], t2, t1[1]);                   // t1 = (XP-ZP)*(XQ+ZQ)
+    fp2sub(t0, t1, P->Z);                           // ZP = (XP+ZP)*(XQ-ZQ)-(XP-ZP)*(XQ+ZQ)
+    fp2add(t0, t1, P->X);                           // XP = (XP+ZP)*(XQ-ZQ)+(XP-ZP)*(XQ+ZQ)
+    fp2sqr_mont(P->Z, P->Z);                        // ZP = [(XP+ZP)*(XQ-ZQ)-(XP-ZP)*(XQ+ZQ)]^2
+    fp2sqr_mont(P->X, P->X);                        // XP = [(XP+ZP)*(XQ-ZQ)+(XP-ZP)*(XQ+ZQ)]^2
+    fp2mul_mont(P->Z, PQ->X, P->Z);                 // ZP = XPQ*[(XP+ZP)*(XQ-ZQ)-(XP-ZP)*(XQ+ZQ)]^2
+    fp2mul_mont(P->X, PQ->Z, P->X);                 // XP = ZPQ*[(XP+ZP)*(XQ-ZQ)+(XP-ZP)*(XQ+ZQ)]^2
+}
+
+
+static void LADDER3PT_fp(const felm_t xP, const felm_t xQ, const f2elm_t xPQ, const digit_t* m, point_proj_t R)
+{ // Right-to-left three-point ladder for Bob's generators of the starting curve E_6, computing R = x(P+[m]Q).
+  // xP and xQ are in GF(p), so the multiples [2^i]Q are kept in GF(p) and only the accumulators R and R2 = [2^i]Q-R, 
+  // which start from P and x(P-Q), live in GF(p^2). [2^i]Q is read from B_gen_table for i < FIXED_BASE_BITS_BOB,
+  // or from the table of the loaded table file.
+    point_proj_t R2 = {0};
+    felm_t X0 = {0}, Z0 = {0};
+    digit_t mask;
+    int i, nbits = OBOB_BITS - 1, bit, swap, prevbit = 0;
+#if defined(TABLE_FILE)
+    const fixed_base_tables_t* tables = fixed_base_tables();
+#endif
+
+    // Initializing points: (X0:Z0) = [2^i]Q, R = P+[m mod 2^i]Q and R2 = (X0:Z0)-R
+    fpcopy(xQ, X0);
+    fpcopy((digit_t*)&Montgomery_one, Z0);
+    fp2copy(xPQ, R2->X);
+    fpcopy((digit_t*)&Montgomery_one, (digit_t*)R2->Z);
+    fpcopy(xP, R->X[0]);
+    fpzero(R->X[1]);
+    fpcopy((digit_t*)&Montgomery_one, (digit_t*)R->Z);
+    fpzero((digit_t*)(R->Z)[1]);
+
+    // Main loop: (X0:Z0) is added to R if the bit is set and to R2 otherwise, the swaps keep the updated point in R2
+    for (i = 0; i < nbits; i++) {
+#if defined(TABLE_FILE)
+        if (i < (int)tables->bits_bob) {
+            fpcopy((digit_t*)tables->B + i*NWORDS_FIELD, X0);
+        } else
+#elif (FIXED_BASE_BITS_BOB > 0)
+        if (i < FIXED_BASE_BITS_BOB) {
+            fpcopy((digit_t*)B_gen_table + i*NWORDS_FIELD, X0);
+        } else
+#endif
+        if (i > 0) {
+            xDBL_fp(X0, Z0);
+        }
+        bit = (m[i >> LOG2RADIX] >> (i & (RADIX-1))) & 1;
+        swap = bit ^ prevbit;
+        prevbit = bit;
+        mask = 0 - (digit_t)swap;
+
+        swap_points(R, R2, mask);
+        xADD_fp(R2, X0, Z0, R);
+    }
+    swap = 0 ^ prevbit;
+    mask = 0 - (digit_t)swap;
+    swap_points(R, R2, mask);
 }
\ No newline at end of file
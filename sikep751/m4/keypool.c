@@ -0,0 +1,320 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: background pool of precomputed key pairs for crypto_kem_keypair
+*********************************************************************************************/
+
+#include <string.h>
+#include "P751_internal.h"
+
+#if defined(KEYPOOL)
+
+#if (TARGET != TARGET_ARM)
+    #include <errno.h>
+    #include <pthread.h>
+    #include <sched.h>
+    #include <semaphore.h>
+    #include <unistd.h>
+#endif
+
+#ifndef KEYPOOL_BATCH
+    #if (TARGET == TARGET_ARM)
+        #define KEYPOOL_BATCH   1           // Short refill steps and a small idle-task stack
+    #else
+        #define KEYPOOL_BATCH   SIDH_BATCH  // Key pairs of a worker share their final inversion
+    #endif
+#endif
+
+#define KEYPOOL_EMPTY           0
+#define KEYPOOL_BUSY            1           // Being generated, read or zeroized
+#define KEYPOOL_FULL            2
+
+#define KEYPOOL_SLOT_WORDS      NBYTES_TO_NWORDS(CRYPTO_PUBLICKEYBYTES + CRYPTO_SECRETKEYBYTES)
+
+// A slot is rounded up to whole words, which clear_words zeroizes
+typedef union {
+    struct {
+        unsigned char pk[CRYPTO_PUBLICKEYBYTES];
+        unsigned char sk[CRYPTO_SECRETKEYBYTES];
+    };
+    digit_t words[KEYPOOL_SLOT_WORDS];
+} keypool_slot_t;
+
+// Slot i holds a key pair when state[i] = KEYPOOL_FULL. The producers claim empty slots and the consumer full
+// ones with a compare-and-swap, so neither of them waits for the other. ready counts the full slots, refill is set
+// when ready drops below threshold and cleared when no slot up to capacity is left empty. next is the slot where
+// the consumer resumes its scan
+static struct {
+    keypool_slot_t slot[KEYPOOL_CAPACITY];
+    uint32_t state[KEYPOOL_CAPACITY];
+    uint32_t ready, refill, next;
+    uint32_t capacity, threshold;
+} keypool = { .refill = 1, .capacity = KEYPOOL_CAPACITY, .threshold = KEYPOOL_THRESHOLD };
+
+#if (TARGET != TARGET_ARM)
+
+// Refill threads, each one woken by a token of wake. The semaphore is created by the first keypool_start and
+// never destroyed, so that a take racing with keypool_stop can still post to it
+static struct {
+    pthread_t thread[KEYPOOL_MAX_WORKERS];
+    pthread_mutex_t lock;
+    sem_t wake;
+    uint32_t nworkers, stop, created;
+} keypool_workers = { .lock = PTHREAD_MUTEX_INITIALIZER };
+
+#endif
+
+
+static void keypool_wake(void)
+{ // Starts a refill unless one is under way
+    uint32_t idle = 0;
+
+    if (__atomic_compare_exchange_n(&keypool.refill, &idle, 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+#if (TARGET != TARGET_ARM)
+        uint32_t t, n = __atomic_load_n(&keypool_workers.nworkers, __ATOMIC_ACQUIRE);
+        for (t = 0; t < n; t++) {
+            sem_post(&keypool_workers.wake);
+        }
+#endif
+    }
+}
+
+
+static void keypool_evict(const uint32_t i)
+{ // Discards the key pair of slot i, if it holds one
+    uint32_t full = KEYPOOL_FULL;
+
+    if (__atomic_compare_exchange_n(&keypool.state[i], &full, KEYPOOL_BUSY, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        clear_words((void*)keypool.slot[i].words, KEYPOOL_SLOT_WORDS);
+        __atomic_store_n(&keypool.state[i], KEYPOOL_EMPTY, __ATOMIC_SEQ_CST);
+        __atomic_sub_fetch(&keypool.ready, 1, __ATOMIC_SEQ_CST);
+    }
+}
+
+
+static void keypool_generate(const uint32_t* index, const unsigned int nb)
+{ // Same key generation as crypto_kem_keypair_batch, written to the claimed slots
+    const unsigned char* skB[KEYPOOL_BATCH];
+    unsigned char* pkB[KEYPOOL_BATCH];
+    unsigned int k;
+
+    for (k = 0; k < nb; k++) {
+        keypool_slot_t* s = &keypool.slot[index[k]];
+        randombytes(s->sk, MSG_BYTES);
+        random_mod_order_B(s->sk + MSG_BYTES);
+        skB[k] = s->sk + MSG_BYTES;
+        pkB[k] = s->pk;
+    }
+    if (nb == 1) {
+        EphemeralKeyGeneration_B(skB[0], pkB[0]);
+    } else {
+        EphemeralKeyGeneration_B_batch(skB, pkB, nb);
+    }
+    for (k = 0; k < nb; k++) {
+        keypool_slot_t* s = &keypool.slot[index[k]];
+        memcpy(&s->sk[MSG_BYTES + SECRETKEY_B_BYTES], s->pk, CRYPTO_PUBLICKEYBYTES);
+    }
+}
+
+
+void keypool_config(unsigned int capacity, unsigned int threshold)
+{
+    uint32_t i;
+
+    if (capacity < 1 || capacity > KEYPOOL_CAPACITY) {
+        capacity = (capacity < 1) ? 1 : KEYPOOL_CAPACITY;
+    }
+    if (threshold < 1 || threshold > capacity) {
+        threshold = (threshold < 1) ? 1 : capacity;
+    }
+    __atomic_store_n(&keypool.capacity, capacity, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&keypool.threshold, threshold, __ATOMIC_SEQ_CST);
+    for (i = capacity; i < KEYPOOL_CAPACITY; i++) {
+        keypool_evict(i);
+    }
+    if (__atomic_load_n(&keypool.ready, __ATOMIC_SEQ_CST) < threshold) {
+        keypool_wake();
+    }
+}
+
+
+int keypool_take(unsigned char* pk, unsigned char* sk)
+{ // Scans the slots from the one after the last key pair taken, at most capacity compare-and-swaps
+    const uint32_t capacity = __atomic_load_n(&keypool.capacity, __ATOMIC_ACQUIRE);
+    uint32_t i = keypool.next, k, full;
+    int status = -1;
+
+    if (i >= capacity) {
+        i = 0;
+    }
+    if (__atomic_load_n(&keypool.ready, __ATOMIC_ACQUIRE) != 0) {
+        for (k = 0; k < capacity; k++) {
+            full = KEYPOOL_FULL;
+            if (__atomic_compare_exchange_n(&keypool.state[i], &full, KEYPOOL_BUSY, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                memcpy(pk, keypool.slot[i].pk, CRYPTO_PUBLICKEYBYTES);
+                memcpy(sk, keypool.slot[i].sk, CRYPTO_SECRETKEYBYTES);
+                clear_words((void*)keypool.slot[i].words, KEYPOOL_SLOT_WORDS);
+                __atomic_store_n(&keypool.state[i], KEYPOOL_EMPTY, __ATOMIC_SEQ_CST);
+                __atomic_sub_fetch(&keypool.ready, 1, __ATOMIC_SEQ_CST);
+                keypool.next = i + 1;
+                status = 0;
+                break;
+            }
+            i = (i + 1 == capacity) ? 0 : i + 1;
+        }
+    }
+
+    if (__atomic_load_n(&keypool.ready, __ATOMIC_SEQ_CST) < __atomic_load_n(&keypool.threshold, __ATOMIC_RELAXED)) {
+        keypool_wake();
+    }
+    return status;
+}
+
+
+unsigned int keypool_refill(void)
+{ // Several producers may run at once, each one fills the slots it has claimed
+    uint32_t index[KEYPOOL_BATCH];
+    uint32_t capacity, i, empty;
+    unsigned int k, nb = 0;
+
+    if (__atomic_load_n(&keypool.refill, __ATOMIC_SEQ_CST) == 0) {
+        return 0;
+    }
+    capacity = __atomic_load_n(&keypool.capacity, __ATOMIC_ACQUIRE);
+    for (i = 0; i < capacity && nb < KEYPOOL_BATCH; i++) {
+        empty = KEYPOOL_EMPTY;
+        if (__atomic_compare_exchange_n(&keypool.state[i], &empty, KEYPOOL_BUSY, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            index[nb++] = i;
+        }
+    }
+
+    if (nb == 0) {
+        // Full, or the last slots are being generated by other producers. A take that emptied a slot after the
+        // scan found refill still set and did not wake anyone, it is caught by scanning again
+        __atomic_store_n(&keypool.refill, 0, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&keypool.ready, __ATOMIC_SEQ_CST) < __atomic_load_n(&keypool.threshold, __ATOMIC_RELAXED)) {
+            for (i = 0; i < capacity; i++) {
+                if (__atomic_load_n(&keypool.state[i], __ATOMIC_SEQ_CST) == KEYPOOL_EMPTY) {
+                    keypool_wake();
+                    break;
+                }
+            }
+        }
+        return 0;
+    }
+
+    keypool_generate(index, nb);
+    capacity = __atomic_load_n(&keypool.capacity, __ATOMIC_ACQUIRE);
+    for (k = 0; k < nb; k++) {
+        if (index[k] < capacity) {
+            __atomic_add_fetch(&keypool.ready, 1, __ATOMIC_SEQ_CST);
+            __atomic_store_n(&keypool.state[index[k]], KEYPOOL_FULL, __ATOMIC_RELEASE);
+        } else {                                // Evicted by keypool_config in the meantime
+            clear_words((void*)keypool.slot[index[k]].words, KEYPOOL_SLOT_WORDS);
+            __atomic_store_n(&keypool.state[index[k]], KEYPOOL_EMPTY, __ATOMIC_RELEASE);
+        }
+    }
+    return nb;
+}
+
+
+unsigned int keypool_size(void)
+{
+    return __atomic_load_n(&keypool.ready, __ATOMIC_ACQUIRE);
+}
+
+
+void keypool_flush(void)
+{ // Key pairs being generated at the time of the call are not discarded, and running workers refill the pool
+    uint32_t i;
+
+    for (i = 0; i < KEYPOOL_CAPACITY; i++) {
+        keypool_evict(i);
+    }
+    keypool_wake();
+}
+
+
+#if (TARGET != TARGET_ARM)
+
+static void* keypool_worker(void* arg)
+{ // Refills until the pool is full, then sleeps until the next take wakes it
+#if defined(SCHED_IDLE)
+    struct sched_param param = { 0 };
+
+    pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+#endif
+#if defined(THREADS)
+    pool_background = 1;                        // The thread pool stays with the handshakes
+#endif
+    UNREFERENCED_PARAMETER(arg);
+
+    while (__atomic_load_n(&keypool_workers.stop, __ATOMIC_ACQUIRE) == 0) {
+        if (keypool_refill() == 0) {
+            while (sem_wait(&keypool_workers.wake) != 0 && errno == EINTR);
+        }
+    }
+    return NULL;
+}
+
+
+unsigned int keypool_start(unsigned int nworkers)
+{ // The trace ring is not shared between threads, traced builds refill with keypool_refill only
+    long ncores = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t t;
+
+    keypool_stop();
+#if defined(TRACE)
+    UNREFERENCED_PARAMETER(ncores);
+    nworkers = 0;
+#else
+    if (nworkers == 0) {
+        nworkers = (ncores < 1) ? 1 : (unsigned int)ncores;
+    }
+    if (nworkers > KEYPOOL_MAX_WORKERS) {
+        nworkers = KEYPOOL_MAX_WORKERS;
+    }
+#endif
+
+    pthread_mutex_lock(&keypool_workers.lock);
+    if (keypool_workers.created == 0 && nworkers != 0) {
+        if (sem_init(&keypool_workers.wake, 0, 0) != 0) {
+            nworkers = 0;
+        } else {
+            keypool_workers.created = 1;
+        }
+    }
+    __atomic_store_n(&keypool_workers.stop, 0, __ATOMIC_RELEASE);
+    for (t = 0; t < nworkers; t++) {
+        if (pthread_create(&keypool_workers.thread[t], NULL, keypool_worker, NULL) != 0) {
+            break;
+        }
+    }
+    __atomic_store_n(&keypool_workers.nworkers, t, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&keypool_workers.lock);
+    return t;
+}
+
+
+void keypool_stop(void)
+{
+    uint32_t t, n;
+
+    pthread_mutex_lock(&keypool_workers.lock);
+    n = keypool_workers.nworkers;
+    if (n != 0) {
+        __atomic_store_n(&keypool_workers.nworkers, 0, __ATOMIC_RELEASE);
+        __atomic_store_n(&keypool_workers.stop, 1, __ATOMIC_RELEASE);
+        for (t = 0; t < n; t++) {
+            sem_post(&keypool_workers.wake);
+        }
+        for (t = 0; t < n; t++) {
+            pthread_join(keypool_workers.thread[t], NULL);
+        }
+    }
+    pthread_mutex_unlock(&keypool_workers.lock);
+}
+
+#endif
+
+#endif
@@ -20,6 +20,43 @@ static void clear_words(void* mem, digit_t nwords)
 }
 
 
+static int8_t ct_compare(const unsigned char* a, const unsigned char* b, const unsigned int len)
+{ // Compares len bytes of a and b in constant time. Returns 0 if they are equal, -1 otherwise
+    unsigned char r = 0;
+    unsigned int i;
+
+    for (i = 0; i < len; i++) {
+        r |= a[i] ^ b[i];
+    }
+    return (int8_t)((-(int32_t)r) >> (8*sizeof(int32_t)-1));
+}
+
+
+static void ct_cmov(unsigned char* r, const unsigned char* a, const unsigned int len, const int8_t selector)
+{ // Copies len bytes of a to r in constant time if selector = -1, keeps r if selector = 0
+    unsigned int i;
+
+    for (i = 0; i < len; i++) {
+        r[i] ^= selector & (a[i] ^ r[i]);
+    }
+}
+
+
+static digit_t fp2_zero_mask(const f2elm_t a)
+{ // Returns all ones if a = 0 in GF(p^2), 0 otherwise, in constant time. a is in [0, 2p-1]
+    f2elm_t t;
+    digit_t r = 0;
+    unsigned int i;
+
+    fp2copy(a, t);
+    fp2correction(t);
+    for (i = 0; i < NWORDS_FIELD; i++) {
+        r |= t[0][i] | t[1][i];
+    }
+    return ((r | (0 - r)) >> (RADIX-1)) - 1;
+}
+
+
 static void init_basis(digit_t *gen, f2elm_t XP, f2elm_t XQ, f2elm_t XR)
 { // Initialization of basis points
     
@@ -32,6 +69,18 @@ static void init_basis(digit_t *gen, f2elm_t XP, f2elm_t XQ, f2elm_t XR)
 }
 
 
+static void decode_to_digits(const unsigned char* x, digit_t* dec, unsigned int nbytes, unsigned int ndigits)
+{ // Decoding bytes to digits according to endianness. Unused upper bytes of dec are zeroed, 
+  // so that the ladders never read beyond the nbytes of a secret key with 64-bit digits.
+    unsigned int i;
+
+    clear_words((void*)dec, ndigits);
+    for (i = 0; i < nbytes; i++) {
+        ((unsigned char*)dec)[i] = x[i];
+    }
+}
+
+
 static void fp2_encode(const f2elm_t x, unsigned char *enc)
 { // Conversion of GF(p^2) element from Montgomery to standard representation, and encoding by removing leading 0 bytes
     unsigned int i;
@@ -80,50 +129,222 @@ void random_mod_order_B(unsigned char* random_digits)
 }
 
 
-int EphemeralKeyGeneration_A(const unsigned char* PrivateKeyA, unsigned char* PublicKeyA)
-{ // Alice's ephemeral public key generation
-  // Input:  a private key PrivateKeyA in the range [0, 2^eA - 1]. 
-  // Output: the public key PublicKeyA consisting of 3 elements in GF(p^2) which are encoded by removing leading 0 bytes.
-    point_proj_t R, phiP = {0}, phiQ = {0}, phiR = {0}, pts[MAX_INT_POINTS_ALICE];
-    f2elm_t XPA, XQA, XRA, coeff[3], A24plus = {0}, C24 = {0}, A = {0};
+static const strategy_t strategy_defaults[STRATEGY_OPS] = {
+    { strat_Alice, MAX_Alice },     // STRATEGY_KEYGEN_A
+    { strat_Bob, MAX_Bob },         // STRATEGY_KEYGEN_B
+    { strat_Alice, MAX_Alice },     // STRATEGY_AGREEMENT_A
+    { strat_Bob, MAX_Bob } };       // STRATEGY_AGREEMENT_B
+
+static const strategy_t* strategies[STRATEGY_OPS] = { &strategy_defaults[0], &strategy_defaults[1], &strategy_defaults[2], &strategy_defaults[3] };
+
+
+int strategy_check(const strategy_t* strategy, const unsigned int nisog)
+{ // Replays the tree traversal of the SIDH functions on the walk lengths only: every walk has to stay
+  // within the current row, the table has to be used up exactly and the stored points must fit in pts[]
+    unsigned int row, m, index = 0, npts = 0, ii = 0, maxpts, pts_index[MAX_INT_POINTS_ALICE + MAX_INT_POINTS_BOB];
+
+    if (strategy == NULL || strategy->table == NULL || strategy->nisog != nisog || (nisog != MAX_Alice && nisog != MAX_Bob)) {
+        return 1;
+    }
+    maxpts = (nisog == MAX_Alice) ? MAX_INT_POINTS_ALICE : MAX_INT_POINTS_BOB;
+
+    for (row = 1; row < nisog; row++) {
+        while (index < nisog-row) {
+            if (npts == maxpts || ii == nisog-1) {
+                return 1;
+            }
+            pts_index[npts++] = index;
+            m = strategy->table[ii++];
+            if (m == 0 || m > nisog-row-index) {
+                return 1;
+            }
+            index += m;
+        }
+        if (npts == 0) {
+            return 1;
+        }
+        index = pts_index[--npts];
+    }
+    return (ii == nisog-1) ? 0 : 1;
+}
+
+
+int strategy_set(const unsigned int op, const strategy_t* strategy)
+{ // Registers the strategy of op, checked against the number of isogenies of its party
+    if (op >= STRATEGY_OPS) {
+        return 1;
+    }
+    if (strategy == NULL) {
+        strategies[op] = &strategy_defaults[op];
+        return 0;
+    }
+    if (strategy_check(strategy, strategy_defaults[op].nisog) != 0) {
+        return 1;
+    }
+    strategies[op] = strategy;
+    return 0;
+}
+
+
+const strategy_t* strategy_get(const unsigned int op)
+{
+    return (op < STRATEGY_OPS) ? strategies[op] : NULL;
+}
+
+#if defined(THREADS)
+
+#if (MAX_INT_POINTS_PARALLEL < MAX_INT_POINTS_ALICE) || (MAX_INT_POINTS_PARALLEL < MAX_INT_POINTS_BOB)
+    #error -- "MAX_INT_POINTS_PARALLEL is below the bounds of the sequential strategies"
+#endif
+
+static int traverse_parallel(const unsigned int op, const strategy_t* strategy, point_proj_t R, f2elm_t A, f2elm_t C, point_proj_t* phi, const unsigned int nphi)
+{ // Tree traversal of operation op from the kernel point R, including the last isogeny, on the curve given by
+  // (A, C) = (A24plus, C24) for Alice and (A24minus, A24plus) for Bob. phi[0..nphi-1] are pushed through all isogenies.
+  // The evaluations of a row run on the workers while this thread evaluates the top stored point, walks down to the
+  // next kernel point and computes its isogeny, so the coefficients are double buffered. The default strategy of op
+  // is replaced by the precomputed one for the number of threads. Returns 0 if the pool has no free workers
+    point_proj_t pts[MAX_INT_POINTS_PARALLEL];
+    f2elm_t coeff[2][3];
+    const unsigned int alice = ((op & 1) == 0), nisog = alice ? MAX_Alice : MAX_Bob;
+    unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_PARALLEL], npts = 0, ii = 0, threads;
+    const unsigned int* strat = strategy->table;
+
+    threads = pool_begin();
+    if (threads == 0) {
+        return 0;
+    }
+    if (strategy == &strategy_defaults[op]) {
+        for (i = 0; i < STRATEGY_PARALLEL_COUNT && strategy_parallel_threads[i] <= threads; i++) {
+            strat = strategy_parallel[i][op].table;
+        }
+    }
+
+    for (row = 1; row < nisog; row++) {
+        while (index < nisog-row) {
+            fp2copy(R->X, pts[npts]->X);
+            fp2copy(R->Z, pts[npts]->Z);
+            pts_index[npts++] = index;
+            m = strat[ii++];
+            if (alice) {
+                xDBLe(R, R, A, C, (int)(2*m));
+            } else {
+                xTPLe(R, R, A, C, (int)m);
+            }
+            index += m;
+        }
+        if (alice) {
+            get_4_isog(R, A, C, coeff[row & 1]);
+        } else {
+            get_3_isog(R, A, C, coeff[row & 1]);
+        }
+
+        pool_join();                            // Previous row, its points can be evaluated again
+        npts -= 1;
+        pool_submit(alice ? 4 : 3, pts, npts, phi, nphi, (const f2elm_t*)coeff[row & 1]);
+        if (alice) {
+            eval_4_isog(pts[npts], coeff[row & 1]);
+        } else {
+            eval_3_isog(pts[npts], (const f2elm_t*)coeff[row & 1]);
+        }
+        fp2copy(pts[npts]->X, R->X);
+        fp2copy(pts[npts]->Z, R->Z);
+        index = pts_index[npts];
+    }
+
+    if (alice) {
+        get_4_isog(R, A, C, coeff[row & 1]);
+    } else {
+        get_3_isog(R, A, C, coeff[row & 1]);
+    }
+    pool_join();
+    pool_submit(alice ? 4 : 3, NULL, 0, phi, nphi, (const f2elm_t*)coeff[row & 1]);
+    pool_end();
+    return 1;
+}
+
+#endif
+
+
+static int KeyGeneration_A(const unsigned char* PrivateKeyA, point_proj_t* phi, const strategy_t* strategy)
+{ // Alice's public key generation up to the normalization
+  // Output: the images phi[0..2] of Bob's basis in projective coordinates. Returns 1 if the strategy is invalid
+    point_proj_t R, pts[MAX_INT_POINTS_ALICE];
+    f2elm_t XPA, XQA, XRA, coeff[3], A24plus = {0}, C24 = {0};
     unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_ALICE], npts = 0, ii = 0;
+    digit_t SecretKeyA[NWORDS_ORDER];
+    const unsigned int* strat;
+#if defined(TABLE_FILE)
+    const fixed_base_tables_t* tables;
+#endif
+
+    if (strategy == NULL) {
+        strategy = strategies[STRATEGY_KEYGEN_A];
+    } else if (strategy_check(strategy, MAX_Alice) != 0) {
+        return 1;
+    }
+    strat = strategy->table;
 
     // Initialize basis points
+    TRACE_BEGIN("init");
     init_basis((digit_t*)A_gen, XPA, XQA, XRA);
-    init_basis((digit_t*)B_gen, phiP->X, phiQ->X, phiR->X);
-    fpcopy((digit_t*)&Montgomery_one, (phiP->Z)[0]);
-    fpcopy((digit_t*)&Montgomery_one, (phiQ->Z)[0]);
-    fpcopy((digit_t*)&Montgomery_one, (phiR->Z)[0]);
+    init_basis((digit_t*)B_gen, phi[0]->X, phi[1]->X, phi[2]->X);
+    fpcopy((digit_t*)&Montgomery_one, (phi[0]->Z)[0]);
+    fpzero((phi[0]->Z)[1]);
+    fpcopy((digit_t*)&Montgomery_one, (phi[1]->Z)[0]);
+    fpzero((phi[1]->Z)[1]);
+    fpcopy((digit_t*)&Montgomery_one, (phi[2]->Z)[0]);
+    fpzero((phi[2]->Z)[1]);
 
     // Initialize constants: A24plus = A+2C, C24 = 4C, where A=6, C=1
     fpcopy((digit_t*)&Montgomery_one, A24plus[0]);
     fp2add(A24plus, A24plus, A24plus);
     fp2add(A24plus, A24plus, C24);
-    fp2add(A24plus, C24, A);
     fp2add(C24, C24, A24plus);
+    TRACE_END("init");
 
     // Retrieve kernel point
-    LADDER3PT(XPA, XQA, XRA, (digit_t*)PrivateKeyA, ALICE, R, A);    
+    OP_COUNT_PHASE(OP_PHASE_LADDER);
+    TRACE_BEGIN("ladder");
+    decode_to_digits(PrivateKeyA, SecretKeyA, SECRETKEY_A_BYTES, NWORDS_ORDER);
+#if defined(TABLE_FILE)
+    tables = fixed_base_tables();
+    if (tables->bits_alice > 0) {
+        LADDER3PT_FB(XPA, XRA, tables->A, (int)tables->bits_alice, SecretKeyA, ALICE, R);
+    } else {
+        LADDER3PT(XPA, XQA, XRA, SecretKeyA, ALICE, R, A24plus, C24[0]);
+    }
+#elif (FIXED_BASE_BITS_ALICE > 0)
+    LADDER3PT_FB(XPA, XRA, A_gen_table, FIXED_BASE_BITS_ALICE, SecretKeyA, ALICE, R);
+#else
+    LADDER3PT(XPA, XQA, XRA, SecretKeyA, ALICE, R, A24plus, C24[0]);
+#endif
+    clear_words((void*)SecretKeyA, NWORDS_ORDER);
+    TRACE_END("ladder");
+    OP_COUNT_PHASE(OP_PHASE_TREE);
+    TRACE_BEGIN("tree");
 
 #if (OALICE_BITS % 2 == 1)
     point_proj_t S;
 
     xDBLe(R, S, A24plus, C24, (int)(OALICE_BITS-1));
     get_2_isog(S, A24plus, C24); 
-    eval_2_isog(phiP, S); 
-    eval_2_isog(phiQ, S); 
-    eval_2_isog(phiR, S);
+    eval_2_isog(phi[0], S); 
+    eval_2_isog(phi[1], S); 
+    eval_2_isog(phi[2], S);
     eval_2_isog(R, S);
 #endif
 
     // Traverse tree
+#if defined(THREADS)
+    if (traverse_parallel(STRATEGY_KEYGEN_A, strategy, R, A24plus, C24, phi, 3) == 0) {
+#endif
     index = 0;        
     for (row = 1; row < MAX_Alice; row++) {
         while (index < MAX_Alice-row) {
             fp2copy(R->X, pts[npts]->X);
             fp2copy(R->Z, pts[npts]->Z);
             pts_index[npts++] = index;
-            m = strat_Alice[ii++];
+            m = strat[ii++];
             xDBLe(R, R, A24plus, C24, (int)(2*m));
             index += m;
         }
@@ -132,9 +353,9 @@ int EphemeralKeyGeneration_A(const unsigned char* PrivateKeyA, unsigned char* Pu
         for (i = 0; i < npts; i++) {
             eval_4_isog(pts[i], coeff);
         }
-        eval_4_isog(phiP, coeff);
-        eval_4_isog(phiQ, coeff);
-        eval_4_isog(phiR, coeff);
+        eval_4_isog(phi[0], coeff);
+        eval_4_isog(phi[1], coeff);
+        eval_4_isog(phi[2], coeff);
 
         fp2copy(pts[npts-1]->X, R->X); 
         fp2copy(pts[npts-1]->Z, R->Z);
@@ -143,57 +364,107 @@ int EphemeralKeyGeneration_A(const unsigned char* PrivateKeyA, unsigned char* Pu
     }
 
     get_4_isog(R, A24plus, C24, coeff); 
-    eval_4_isog(phiP, coeff);
-    eval_4_isog(phiQ, coeff);
-    eval_4_isog(phiR, coeff);
-
-    inv_3_way(phiP->Z, phiQ->Z, phiR->Z);
-    fp2mul_mont(phiP->X, phiP->Z, phiP->X);
-    fp2mul_mont(phiQ->X, phiQ->Z, phiQ->X);
-    fp2mul_mont(phiR->X, phiR->Z, phiR->X);
-                
+    eval_4_isog(phi[0], coeff);
+    eval_4_isog(phi[1], coeff);
+    eval_4_isog(phi[2], coeff);
+#if defined(THREADS)
+    }
+#endif
+
+    TRACE_END("tree");
+
+    return 0;
+}
+
+
+int EphemeralKeyGeneration_A_strategy(const unsigned char* PrivateKeyA, unsigned char* PublicKeyA, const strategy_t* strategy)
+{ // Alice's ephemeral public key generation
+  // Input:  a private key PrivateKeyA in the range [0, 2^eA - 1]. 
+  // Output: the public key PublicKeyA consisting of 3 elements in GF(p^2) which are encoded by removing leading 0 bytes.
+    point_proj_t phi[3];
+    f2elm_t xphi[3], zphi[3];
+
+    if (KeyGeneration_A(PrivateKeyA, phi, strategy) != 0) {
+        return 1;
+    }
+    OP_COUNT_PHASE(OP_PHASE_NORMALIZE);
+    TRACE_BEGIN("normalize");
+    proj_to_affine(phi, 3, xphi, zphi);
+    TRACE_END("normalize");
+
     // Format public key                   
-    fp2_encode(phiP->X, PublicKeyA);
-    fp2_encode(phiQ->X, PublicKeyA + FP2_ENCODED_BYTES);
-    fp2_encode(phiR->X, PublicKeyA + 2*FP2_ENCODED_BYTES);
+    TRACE_BEGIN("encode");
+    fp2_encode(xphi[0], PublicKeyA);
+    fp2_encode(xphi[1], PublicKeyA + FP2_ENCODED_BYTES);
+    fp2_encode(xphi[2], PublicKeyA + 2*FP2_ENCODED_BYTES);
+    TRACE_END("encode");
+    OP_COUNT_PHASE(OP_PHASE_OTHER);
 
     return 0;
 }
 
 
-int EphemeralKeyGeneration_B(const unsigned char* PrivateKeyB, unsigned char* PublicKeyB)
-{ // Bob's ephemeral public key generation
-  // Input:  a private key PrivateKeyB in the range [0, 2^Floor(Log(2,oB)) - 1]. 
-  // Output: the public key PublicKeyB consisting of 3 elements in GF(p^2) which are encoded by removing leading 0 bytes.
-    point_proj_t R, phiP = {0}, phiQ = {0}, phiR = {0}, pts[MAX_INT_POINTS_BOB];
-    f2elm_t XPB, XQB, XRB, coeff[3], A24plus = {0}, A24minus = {0}, A = {0};
+int EphemeralKeyGeneration_A(const unsigned char* PrivateKeyA, unsigned char* PublicKeyA)
+{ // Alice's ephemeral public key generation with the strategy registered for STRATEGY_KEYGEN_A
+    return EphemeralKeyGeneration_A_strategy(PrivateKeyA, PublicKeyA, NULL);
+}
+
+
+static int KeyGeneration_B(const unsigned char* PrivateKeyB, point_proj_t* phi, const strategy_t* strategy)
+{ // Bob's public key generation up to the normalization
+  // Output: the images phi[0..2] of Alice's basis in projective coordinates. Returns 1 if the strategy is invalid
+    point_proj_t R, pts[MAX_INT_POINTS_BOB];
+    f2elm_t XPB, XQB, XRB, coeff[3], A24plus = {0}, A24minus = {0};
     unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_BOB], npts = 0, ii = 0;
+    digit_t SecretKeyB[NWORDS_ORDER];
+    const unsigned int* strat;
+
+    if (strategy == NULL) {
+        strategy = strategies[STRATEGY_KEYGEN_B];
+    } else if (strategy_check(strategy, MAX_Bob) != 0) {
+        return 1;
+    }
+    strat = strategy->table;
 
     // Initialize basis points
+    TRACE_BEGIN("init");
     init_basis((digit_t*)B_gen, XPB, XQB, XRB);
-    init_basis((digit_t*)A_gen, phiP->X, phiQ->X, phiR->X);
-    fpcopy((digit_t*)&Montgomery_one, (phiP->Z)[0]);
-    fpcopy((digit_t*)&Montgomery_one, (phiQ->Z)[0]);
-    fpcopy((digit_t*)&Montgomery_one, (phiR->Z)[0]);
+    init_basis((digit_t*)A_gen, phi[0]->X, phi[1]->X, phi[2]->X);
+    fpcopy((digit_t*)&Montgomery_one, (phi[0]->Z)[0]);
+    fpzero((phi[0]->Z)[1]);
+    fpcopy((digit_t*)&Montgomery_one, (phi[1]->Z)[0]);
+    fpzero((phi[1]->Z)[1]);
+    fpcopy((digit_t*)&Montgomery_one, (phi[2]->Z)[0]);
+    fpzero((phi[2]->Z)[1]);
 
     // Initialize constants: A24minus = A-2C, A24plus = A+2C, where A=6, C=1
     fpcopy((digit_t*)&Montgomery_one, A24plus[0]);
     fp2add(A24plus, A24plus, A24plus);
     fp2add(A24plus, A24plus, A24minus);
-    fp2add(A24plus, A24minus, A);
     fp2add(A24minus, A24minus, A24plus);
+    TRACE_END("init");
 
     // Retrieve kernel point
-    LADDER3PT(XPB, XQB, XRB, (digit_t*)PrivateKeyB, BOB, R, A);
+    OP_COUNT_PHASE(OP_PHASE_LADDER);
+    TRACE_BEGIN("ladder");
+    decode_to_digits(PrivateKeyB, SecretKeyB, SECRETKEY_B_BYTES, NWORDS_ORDER);
+    LADDER3PT_fp(XPB[0], XQB[0], XRB, SecretKeyB, R);
+    clear_words((void*)SecretKeyB, NWORDS_ORDER);
+    TRACE_END("ladder");
+    OP_COUNT_PHASE(OP_PHASE_TREE);
+    TRACE_BEGIN("tree");
     
     // Traverse tree
+#if defined(THREADS)
+    if (traverse_parallel(STRATEGY_KEYGEN_B, strategy, R, A24minus, A24plus, phi, 3) == 0) {
+#endif
     index = 0;  
     for (row = 1; row < MAX_Bob; row++) {
         while (index < MAX_Bob-row) {
             fp2copy(R->X, pts[npts]->X);
             fp2copy(R->Z, pts[npts]->Z);
             pts_index[npts++] = index;
-            m = strat_Bob[ii++];
+            m = strat[ii++];
             xTPLe(R, R, A24minus, A24plus, (int)m);
             index += m;
         } 
@@ -202,9 +473,9 @@ int EphemeralKeyGeneration_B(const unsigned char* PrivateKeyB, unsigned char* Pu
         for (i = 0; i < npts; i++) {
             eval_3_isog(pts[i], coeff);
         }     
-        eval_3_isog(phiP, coeff);
-        eval_3_isog(phiQ, coeff);
-        eval_3_isog(phiR, coeff);
+        eval_3_isog(phi[0], coeff);
+        eval_3_isog(phi[1], coeff);
+        eval_3_isog(phi[2], coeff);
 
         fp2copy(pts[npts-1]->X, R->X); 
         fp2copy(pts[npts-1]->Z, R->Z);
@@ -213,48 +484,62 @@ int EphemeralKeyGeneration_B(const unsigned char* PrivateKeyB, unsigned char* Pu
     }
     
     get_3_isog(R, A24minus, A24plus, coeff);
-    eval_3_isog(phiP, coeff);
-    eval_3_isog(phiQ, coeff);
-    eval_3_isog(phiR, coeff);
+    eval_3_isog(phi[0], coeff);
+    eval_3_isog(phi[1], coeff);
+    eval_3_isog(phi[2], coeff);
+#if defined(THREADS)
+    }
+#endif
 
-    inv_3_way(phiP->Z, phiQ->Z, phiR->Z);
-    fp2mul_mont(phiP->X, phiP->Z, phiP->X);
-    fp2mul_mont(phiQ->X, phiQ->Z, phiQ->X);
-    fp2mul_mont(phiR->X, phiR->Z, phiR->X);
+    TRACE_END("tree");
+
+    return 0;
+}
+
+
+int EphemeralKeyGeneration_B_strategy(const unsigned char* PrivateKeyB, unsigned char* PublicKeyB, const strategy_t* strategy)
+{ // Bob's ephemeral public key generation
+  // Input:  a private key PrivateKeyB in the range [0, 2^Floor(Log(2,oB)) - 1]. 
+  // Output: the public key PublicKeyB consisting of 3 elements in GF(p^2) which are encoded by removing leading 0 bytes.
+    point_proj_t phi[3];
+    f2elm_t xphi[3], zphi[3];
+
+    if (KeyGeneration_B(PrivateKeyB, phi, strategy) != 0) {
+        return 1;
+    }
+    OP_COUNT_PHASE(OP_PHASE_NORMALIZE);
+    TRACE_BEGIN("normalize");
+    proj_to_affine(phi, 3, xphi, zphi);
+    TRACE_END("normalize");
 
     // Format public key
-    fp2_encode(phiP->X, PublicKeyB);
-    fp2_encode(phiQ->X, PublicKeyB + FP2_ENCODED_BYTES);
-    fp2_encode(phiR->X, PublicKeyB + 2*FP2_ENCODED_BYTES);
+    TRACE_BEGIN("encode");
+    fp2_encode(xphi[0], PublicKeyB);
+    fp2_encode(xphi[1], PublicKeyB + FP2_ENCODED_BYTES);
+    fp2_encode(xphi[2], PublicKeyB + 2*FP2_ENCODED_BYTES);
+    TRACE_END("encode");
+    OP_COUNT_PHASE(OP_PHASE_OTHER);
 
     return 0;
 }
 
 
-int EphemeralSecretAgreement_A(const unsigned char* PrivateKeyA, const unsigned char* PublicKeyB, unsigned char* SharedSecretA)
-{ // Alice's ephemeral shared secret computation
-  // It produces a shared secret key SharedSecretA using her secret key PrivateKeyA and Bob's public key PublicKeyB
-  // Inputs: Alice's PrivateKeyA is an integer in the range [0, oA-1]. 
-  //         Bob's PublicKeyB consists of 3 elements in GF(p^2) encoded by removing leading 0 bytes.
-  // Output: a shared secret SharedSecretA that consists of one element in GF(p^2) encoded by removing leading 0 bytes.  
-    point_proj_t R, pts[MAX_INT_POINTS_ALICE];
-    f2elm_t coeff[3], PKB[3], jinv;
-    f2elm_t A24plus = {0}, C24 = {0}, A = {0};
-    unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_ALICE], npts = 0, ii = 0;
-      
-    // Initialize images of Bob's basis
-    fp2_decode(PublicKeyB, PKB[0]);
-    fp2_decode(PublicKeyB + FP2_ENCODED_BYTES, PKB[1]);
-    fp2_decode(PublicKeyB + 2*FP2_ENCODED_BYTES, PKB[2]);
+int EphemeralKeyGeneration_B(const unsigned char* PrivateKeyB, unsigned char* PublicKeyB)
+{ // Bob's ephemeral public key generation with the strategy registered for STRATEGY_KEYGEN_B
+    return EphemeralKeyGeneration_B_strategy(PrivateKeyB, PublicKeyB, NULL);
+}
 
-    // Initialize constants: A24plus = A+2C, C24 = 4C, where C=1
-    get_A(PKB[0], PKB[1], PKB[2], A);
-    fpadd((digit_t*)&Montgomery_one, (digit_t*)&Montgomery_one, C24[0]);
-    fp2add(A, C24, A24plus);
-    fpadd(C24[0], C24[0], C24[0]);
 
-    // Retrieve kernel point
-    LADDER3PT(PKB[0], PKB[1], PKB[2], (digit_t*)PrivateKeyA, ALICE, R, A);   
+static void SecretIsogeny_A(point_proj_t R, f2elm_t A24plus, f2elm_t C24, const strategy_t* strategy, f2elm_t jA, f2elm_t jC)
+{ // Alice's isogeny of kernel <R> in the shared secret computation, on the curve with A24plus = A+2C and C24 = 4C
+  // Output: the projective constant (jA:jC) of the curve whose j-invariant is the shared secret
+    point_proj_t pts[MAX_INT_POINTS_ALICE];
+    f2elm_t coeff[3];
+    unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_ALICE], npts = 0, ii = 0;
+    const unsigned int* strat = strategy->table;
+
+    OP_COUNT_PHASE(OP_PHASE_TREE);
+    TRACE_BEGIN("tree");
 
 #if (OALICE_BITS % 2 == 1)
     point_proj_t S;
@@ -265,13 +550,16 @@ int EphemeralSecretAgreement_A(const unsigned char* PrivateKeyA, const unsigned
 #endif
 
     // Traverse tree
+#if defined(THREADS)
+    if (traverse_parallel(STRATEGY_AGREEMENT_A, strategy, R, A24plus, C24, NULL, 0) == 0) {
+#endif
     index = 0;        
     for (row = 1; row < MAX_Alice; row++) {
         while (index < MAX_Alice-row) {
             fp2copy(R->X, pts[npts]->X);
             fp2copy(R->Z, pts[npts]->Z);
             pts_index[npts++] = index;
-            m = strat_Alice[ii++];
+            m = strat[ii++];
             xDBLe(R, R, A24plus, C24, (int)(2*m));
             index += m;
         }
@@ -288,49 +576,159 @@ int EphemeralSecretAgreement_A(const unsigned char* PrivateKeyA, const unsigned
     }
 
     get_4_isog(R, A24plus, C24, coeff); 
+#if defined(THREADS)
+    }
+#endif
     fp2add(A24plus, A24plus, A24plus);                                                
     fp2sub(A24plus, C24, A24plus); 
-    fp2add(A24plus, A24plus, A24plus);                    
-    j_inv(A24plus, C24, jinv);
+    fp2add(A24plus, A24plus, jA);
+    fp2copy(C24, jC);
+    TRACE_END("tree");
+}
+
+
+void PublicKeyExpand_B(const unsigned char* PublicKeyB, pk_expanded_B_t* PublicKeyBx)
+{ // Decoding of Bob's public key and of the constants of its curve, the part of Alice's shared secret computation
+  // that depends only on PublicKeyB
+    f2elm_t A = {0}, C = {0};
+
+    // Initialize images of Bob's basis
+    TRACE_BEGIN("init");
+    fp2_decode(PublicKeyB, PublicKeyBx->PKB[0]);
+    fp2_decode(PublicKeyB + FP2_ENCODED_BYTES, PublicKeyBx->PKB[1]);
+    fp2_decode(PublicKeyB + 2*FP2_ENCODED_BYTES, PublicKeyBx->PKB[2]);
+
+    // Initialize constants: A24plus = A+2C, C24 = 4C, where C is in GF(p)
+    get_A_proj(PublicKeyBx->PKB[0], PublicKeyBx->PKB[1], PublicKeyBx->PKB[2], A, C);
+    fp2add(C, C, PublicKeyBx->C24);
+    fp2add(A, PublicKeyBx->C24, PublicKeyBx->A24plus);
+    fp2add(PublicKeyBx->C24, PublicKeyBx->C24, PublicKeyBx->C24);
+    TRACE_END("init");
+}
+
+
+static void SecretAgreement_A_expanded(const unsigned char* PrivateKeyA, const pk_expanded_B_t* PublicKeyBx, f2elm_t jA, f2elm_t jC, const strategy_t* strategy)
+{ // Alice's shared secret computation up to the normalization, on an expanded public key and a valid strategy
+  // Output: the projective constant (jA:jC) of the curve whose j-invariant is the shared secret
+    point_proj_t R;
+    f2elm_t A24plus, C24;
+    digit_t SecretKeyA[NWORDS_ORDER];
+#if defined(LADDER_CACHE)
+    const f2elm_t* table;
+#endif
+
+    // Retrieve kernel point, with the right-to-left ladder if the key has a table in the ladder cache
+    OP_COUNT_PHASE(OP_PHASE_LADDER);
+    TRACE_BEGIN("ladder");
+    decode_to_digits(PrivateKeyA, SecretKeyA, SECRETKEY_A_BYTES, NWORDS_ORDER);
+#if defined(LADDER_CACHE)
+    table = ladder_cache_acquire(PublicKeyBx);
+    if (table != NULL) {
+        LADDER3PT_FB(PublicKeyBx->PKB[0], PublicKeyBx->PKB[2], (const uint64_t*)table, OALICE_BITS, SecretKeyA, ALICE, R);
+        ladder_cache_release(table);
+    } else {
+#endif
+    LADDER3PT(PublicKeyBx->PKB[0], PublicKeyBx->PKB[1], PublicKeyBx->PKB[2], SecretKeyA, ALICE, R, PublicKeyBx->A24plus, PublicKeyBx->C24[0]);
+#if defined(LADDER_CACHE)
+    }
+#endif
+    clear_words((void*)SecretKeyA, NWORDS_ORDER);
+    TRACE_END("ladder");
+    fp2copy(PublicKeyBx->A24plus, A24plus);             // The isogenies update the curve constants
+    fp2copy(PublicKeyBx->C24, C24);
+    SecretIsogeny_A(R, A24plus, C24, strategy, jA, jC);
+}
+
+
+static int SecretAgreement_A(const unsigned char* PrivateKeyA, const unsigned char* PublicKeyB, f2elm_t jA, f2elm_t jC, const strategy_t* strategy)
+{ // Alice's shared secret computation up to the normalization
+  // Output: the projective constant (jA:jC) of the curve whose j-invariant is the shared secret. Returns 1 if the strategy is invalid
+    pk_expanded_B_t PublicKeyBx;
+
+    if (strategy == NULL) {
+        strategy = strategies[STRATEGY_AGREEMENT_A];
+    } else if (strategy_check(strategy, MAX_Alice) != 0) {
+        return 1;
+    }
+
+    PublicKeyExpand_B(PublicKeyB, &PublicKeyBx);
+    SecretAgreement_A_expanded(PrivateKeyA, &PublicKeyBx, jA, jC, strategy);
+
+    return 0;
+}
+
+
+int EphemeralSecretAgreement_A_strategy(const unsigned char* PrivateKeyA, const unsigned char* PublicKeyB, unsigned char* SharedSecretA, const strategy_t* strategy)
+{ // Alice's ephemeral shared secret computation
+  // It produces a shared secret key SharedSecretA using her secret key PrivateKeyA and Bob's public key PublicKeyB
+  // Inputs: Alice's PrivateKeyA is an integer in the range [0, oA-1]. 
+  //         Bob's PublicKeyB consists of 3 elements in GF(p^2) encoded by removing leading 0 bytes.
+  // Output: a shared secret SharedSecretA that consists of one element in GF(p^2) encoded by removing leading 0 bytes.  
+    f2elm_t jA, jC, jinv;
+
+    if (SecretAgreement_A(PrivateKeyA, PublicKeyB, jA, jC, strategy) != 0) {
+        return 1;
+    }
+    OP_COUNT_PHASE(OP_PHASE_NORMALIZE);
+    TRACE_BEGIN("normalize");
+    j_inv(jA, jC, jinv);
+    TRACE_END("normalize");
+    TRACE_BEGIN("encode");
     fp2_encode(jinv, SharedSecretA);    // Format shared secret
+    TRACE_END("encode");
+    OP_COUNT_PHASE(OP_PHASE_OTHER);
 
     return 0;
 }
 
 
-int EphemeralSecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, unsigned char* SharedSecretB)
-{ // Bob's ephemeral shared secret computation
-  // It produces a shared secret key SharedSecretB using his secret key PrivateKeyB and Alice's public key PublicKeyA
-  // Inputs: Bob's PrivateKeyB is an integer in the range [0, 2^Floor(Log(2,oB)) - 1]. 
-  //         Alice's PublicKeyA consists of 3 elements in GF(p^2) encoded by removing leading 0 bytes.
-  // Output: a shared secret SharedSecretB that consists of one element in GF(p^2) encoded by removing leading 0 bytes.  
-    point_proj_t R, pts[MAX_INT_POINTS_BOB];
-    f2elm_t coeff[3], PKB[3], jinv;
-    f2elm_t A24plus = {0}, A24minus = {0}, A = {0};
-    unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_BOB], npts = 0, ii = 0;
-      
-    // Initialize images of Alice's basis
-    fp2_decode(PublicKeyA, PKB[0]);
-    fp2_decode(PublicKeyA + FP2_ENCODED_BYTES, PKB[1]);
-    fp2_decode(PublicKeyA + 2*FP2_ENCODED_BYTES, PKB[2]);
+int EphemeralSecretAgreement_A(const unsigned char* PrivateKeyA, const unsigned char* PublicKeyB, unsigned char* SharedSecretA)
+{ // Alice's ephemeral shared secret computation with the strategy registered for STRATEGY_AGREEMENT_A
+    return EphemeralSecretAgreement_A_strategy(PrivateKeyA, PublicKeyB, SharedSecretA, NULL);
+}
 
-    // Initialize constants: A24plus = A+2C, A24minus = A-2C, where C=1
-    get_A(PKB[0], PKB[1], PKB[2], A);
-    fpadd((digit_t*)&Montgomery_one, (digit_t*)&Montgomery_one, A24minus[0]);
-    fp2add(A, A24minus, A24plus);
-    fp2sub(A, A24minus, A24minus);
 
-    // Retrieve kernel point
-    LADDER3PT(PKB[0], PKB[1], PKB[2], (digit_t*)PrivateKeyB, BOB, R, A);
+int EphemeralSecretAgreement_A_expanded(const unsigned char* PrivateKeyA, const pk_expanded_B_t* PublicKeyBx, unsigned char* SharedSecretA)
+{ // Alice's ephemeral shared secret computation on Bob's public key expanded by PublicKeyExpand_B, with the strategy
+  // registered for STRATEGY_AGREEMENT_A. Same output as EphemeralSecretAgreement_A on the public key
+    f2elm_t jA, jC, jinv;
+
+    SecretAgreement_A_expanded(PrivateKeyA, PublicKeyBx, jA, jC, strategies[STRATEGY_AGREEMENT_A]);
+    OP_COUNT_PHASE(OP_PHASE_NORMALIZE);
+    TRACE_BEGIN("normalize");
+    j_inv(jA, jC, jinv);
+    TRACE_END("normalize");
+    TRACE_BEGIN("encode");
+    fp2_encode(jinv, SharedSecretA);    // Format shared secret
+    TRACE_END("encode");
+    OP_COUNT_PHASE(OP_PHASE_OTHER);
+
+    return 0;
+}
+
+
+static void SecretIsogeny_B(point_proj_t R, f2elm_t A24minus, f2elm_t A24plus, const strategy_t* strategy, f2elm_t jA, f2elm_t jC)
+{ // Bob's isogeny of kernel <R> in the shared secret computation, on the curve with A24minus = A-2C and A24plus = A+2C
+  // Output: the projective constant (jA:jC) of the curve whose j-invariant is the shared secret
+    point_proj_t pts[MAX_INT_POINTS_BOB];
+    f2elm_t coeff[3], A;
+    unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_BOB], npts = 0, ii = 0;
+    const unsigned int* strat = strategy->table;
+
+    OP_COUNT_PHASE(OP_PHASE_TREE);
+    TRACE_BEGIN("tree");
     
     // Traverse tree
+#if defined(THREADS)
+    if (traverse_parallel(STRATEGY_AGREEMENT_B, strategy, R, A24minus, A24plus, NULL, 0) == 0) {
+#endif
     index = 0;  
     for (row = 1; row < MAX_Bob; row++) {
         while (index < MAX_Bob-row) {
             fp2copy(R->X, pts[npts]->X);
             fp2copy(R->Z, pts[npts]->Z);
             pts_index[npts++] = index;
-            m = strat_Bob[ii++];
+            m = strat[ii++];
             xTPLe(R, R, A24minus, A24plus, (int)m);
             index += m;
         }
@@ -347,15 +745,229 @@ int EphemeralSecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned
     }
      
     get_3_isog(R, A24minus, A24plus, coeff);    
+#if defined(THREADS)
+    }
+#endif
     fp2add(A24plus, A24minus, A);                 
-    fp2add(A, A, A);
-    fp2sub(A24plus, A24minus, A24plus);                   
-    j_inv(A, A24plus, jinv);
+    fp2add(A, A, jA);
+    fp2sub(A24plus, A24minus, jC);
+    TRACE_END("tree");
+}
+
+
+static int SecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, f2elm_t jA, f2elm_t jC, const strategy_t* strategy)
+{ // Bob's shared secret computation up to the normalization
+  // Output: the projective constant (jA:jC) of the curve whose j-invariant is the shared secret. Returns 1 if the strategy is invalid
+    point_proj_t R;
+    f2elm_t PKB[3];
+    f2elm_t A24plus = {0}, A24minus = {0}, A = {0}, C = {0};
+    felm_t C24;
+    digit_t SecretKeyB[NWORDS_ORDER];
+
+    if (strategy == NULL) {
+        strategy = strategies[STRATEGY_AGREEMENT_B];
+    } else if (strategy_check(strategy, MAX_Bob) != 0) {
+        return 1;
+    }
+      
+    // Initialize images of Alice's basis
+    TRACE_BEGIN("init");
+    fp2_decode(PublicKeyA, PKB[0]);
+    fp2_decode(PublicKeyA + FP2_ENCODED_BYTES, PKB[1]);
+    fp2_decode(PublicKeyA + 2*FP2_ENCODED_BYTES, PKB[2]);
+
+    // Initialize constants: A24plus = A+2C, A24minus = A-2C, C24 = 4C, where C is in GF(p)
+    get_A_proj(PKB[0], PKB[1], PKB[2], A, C);
+    fp2add(C, C, A24minus);
+    fp2add(A, A24minus, A24plus);
+    fp2sub(A, A24minus, A24minus);
+    fpadd(C[0], C[0], C24);
+    fpadd(C24, C24, C24);
+    TRACE_END("init");
+
+    // Retrieve kernel point
+    OP_COUNT_PHASE(OP_PHASE_LADDER);
+    TRACE_BEGIN("ladder");
+    decode_to_digits(PrivateKeyB, SecretKeyB, SECRETKEY_B_BYTES, NWORDS_ORDER);
+    LADDER3PT(PKB[0], PKB[1], PKB[2], SecretKeyB, BOB, R, A24plus, C24);
+    clear_words((void*)SecretKeyB, NWORDS_ORDER);
+    TRACE_END("ladder");
+    SecretIsogeny_B(R, A24minus, A24plus, strategy, jA, jC);
+
+    return 0;
+}
+
+
+int EphemeralSecretAgreement_B_strategy(const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, unsigned char* SharedSecretB, const strategy_t* strategy)
+{ // Bob's ephemeral shared secret computation
+  // It produces a shared secret key SharedSecretB using his secret key PrivateKeyB and Alice's public key PublicKeyA
+  // Inputs: Bob's PrivateKeyB is an integer in the range [0, 2^Floor(Log(2,oB)) - 1]. 
+  //         Alice's PublicKeyA consists of 3 elements in GF(p^2) encoded by removing leading 0 bytes.
+  // Output: a shared secret SharedSecretB that consists of one element in GF(p^2) encoded by removing leading 0 bytes.  
+    f2elm_t jA, jC, jinv;
+
+    if (SecretAgreement_B(PrivateKeyB, PublicKeyA, jA, jC, strategy) != 0) {
+        return 1;
+    }
+    OP_COUNT_PHASE(OP_PHASE_NORMALIZE);
+    TRACE_BEGIN("normalize");
+    j_inv(jA, jC, jinv);
+    TRACE_END("normalize");
+    TRACE_BEGIN("encode");
     fp2_encode(jinv, SharedSecretB);    // Format shared secret
+    TRACE_END("encode");
+    OP_COUNT_PHASE(OP_PHASE_OTHER);
 
     return 0;
 }
 
+
+int EphemeralSecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, unsigned char* SharedSecretB)
+{ // Bob's ephemeral shared secret computation with the strategy registered for STRATEGY_AGREEMENT_B
+    return EphemeralSecretAgreement_B_strategy(PrivateKeyB, PublicKeyA, SharedSecretB, NULL);
+}
+
+
+static int KeyGeneration_batch(const unsigned int alice, const unsigned char* const* PrivateKey, unsigned char* const* PublicKey, const unsigned int n)
+{ // Public key generation of n independent private keys of one party. The images of the basis of up to SIDH_BATCH
+  // keys are stored side by side and converted to affine coordinates with a single inversion
+    point_proj_t phi[3*SIDH_BATCH];
+    f2elm_t xphi[3*SIDH_BATCH], zphi[3*SIDH_BATCH];
+    unsigned int i, k, nb;
+
+    for (i = 0; i < n; i += nb) {
+        nb = (n - i < SIDH_BATCH) ? n - i : SIDH_BATCH;
+        k = 0;
+#if defined(IFMA)
+        if (nb > 1 && ifma_available() != 0) {
+            TRACE_BEGIN("ifma");
+            KeyGeneration_ifma(alice, &PrivateKey[i], phi, nb);
+            TRACE_END("ifma");
+            k = nb;
+        }
+#endif
+#if defined(AVX2)
+        if (k == 0 && nb > 1 && avx2_available() != 0) {
+            TRACE_BEGIN("avx2");
+            KeyGeneration_avx2(alice, &PrivateKey[i], phi, nb);
+            TRACE_END("avx2");
+            k = nb;
+        }
+#endif
+        for (; k < nb; k++) {
+            if ((alice ? KeyGeneration_A(PrivateKey[i+k], &phi[3*k], strategies[STRATEGY_KEYGEN_A]) : KeyGeneration_B(PrivateKey[i+k], &phi[3*k], strategies[STRATEGY_KEYGEN_B])) != 0) {
+                return 1;
+            }
+        }
+
+        OP_COUNT_PHASE(OP_PHASE_NORMALIZE);
+        TRACE_BEGIN("normalize");
+        proj_to_affine(phi, (int)(3*nb), xphi, zphi);
+        TRACE_END("normalize");
+
+        // Format public keys
+        TRACE_BEGIN("encode");
+        for (k = 0; k < nb; k++) {
+            fp2_encode(xphi[3*k], PublicKey[i+k]);
+            fp2_encode(xphi[3*k+1], PublicKey[i+k] + FP2_ENCODED_BYTES);
+            fp2_encode(xphi[3*k+2], PublicKey[i+k] + 2*FP2_ENCODED_BYTES);
+        }
+        TRACE_END("encode");
+        OP_COUNT_PHASE(OP_PHASE_OTHER);
+    }
+    return 0;
+}
+
+
+static int SecretAgreement_batch(const unsigned int alice, const unsigned char* const* PrivateKey, const unsigned char* const* PublicKey, unsigned char* const* SharedSecret, const unsigned int n)
+{ // Shared secret computation of n independent key pairs of one party. The j-invariants of up to SIDH_BATCH
+  // curves are kept as fractions num/den and the denominators are inverted together. A zero den, e.g. from a
+  // zero public key, would zero all the inverses of its chunk: it is replaced by 1 and its j-invariant set to 0,
+  // the result of the single functions, without branching on it
+    f2elm_t jA[SIDH_BATCH], jC[SIDH_BATCH], num[SIDH_BATCH], den[SIDH_BATCH], jinv[SIDH_BATCH];
+    digit_t zero[SIDH_BATCH];
+    unsigned int i, k, w, nb;
+
+    for (i = 0; i < n; i += nb) {
+        nb = (n - i < SIDH_BATCH) ? n - i : SIDH_BATCH;
+        k = 0;
+#if defined(IFMA)
+        if (nb > 1 && ifma_available() != 0) {
+            TRACE_BEGIN("ifma");
+            SecretAgreement_ifma(alice, &PrivateKey[i], &PublicKey[i], jA, jC, nb);
+            TRACE_END("ifma");
+            k = nb;
+        }
+#endif
+#if defined(AVX2)
+        if (k == 0 && nb > 1 && avx2_available() != 0) {
+            TRACE_BEGIN("avx2");
+            SecretAgreement_avx2(alice, &PrivateKey[i], &PublicKey[i], jA, jC, nb);
+            TRACE_END("avx2");
+            k = nb;
+        }
+#endif
+        for (; k < nb; k++) {
+            if ((alice ? SecretAgreement_A(PrivateKey[i+k], PublicKey[i+k], jA[k], jC[k], strategies[STRATEGY_AGREEMENT_A]) : SecretAgreement_B(PrivateKey[i+k], PublicKey[i+k], jA[k], jC[k], strategies[STRATEGY_AGREEMENT_B])) != 0) {
+                return 1;
+            }
+        }
+
+        OP_COUNT_PHASE(OP_PHASE_NORMALIZE);
+        TRACE_BEGIN("normalize");
+        for (k = 0; k < nb; k++) {
+            j_inv_proj(jA[k], jC[k], num[k], den[k]);
+            zero[k] = fp2_zero_mask(den[k]);
+            for (w = 0; w < NWORDS_FIELD; w++) {
+                den[k][0][w] = (den[k][0][w] & ~zero[k]) | (((const digit_t*)&Montgomery_one)[w] & zero[k]);
+                den[k][1][w] &= ~zero[k];
+            }
+        }
+        mont_n_way_inv((const f2elm_t*)den, (int)nb, jinv);
+        for (k = 0; k < nb; k++) {
+            fp2mul_mont(jinv[k], num[k], jinv[k]);
+            for (w = 0; w < NWORDS_FIELD; w++) {
+                jinv[k][0][w] &= ~zero[k];
+                jinv[k][1][w] &= ~zero[k];
+            }
+        }
+        TRACE_END("normalize");
+
+        // Format shared secrets
+        TRACE_BEGIN("encode");
+        for (k = 0; k < nb; k++) {
+            fp2_encode(jinv[k], SharedSecret[i+k]);
+        }
+        TRACE_END("encode");
+        OP_COUNT_PHASE(OP_PHASE_OTHER);
+    }
+    return 0;
+}
+
+
+int EphemeralKeyGeneration_A_batch(const unsigned char* const* PrivateKeyA, unsigned char* const* PublicKeyA, const unsigned int n)
+{ // Alice's ephemeral public key generation for n private keys, same output as n calls of EphemeralKeyGeneration_A
+    return KeyGeneration_batch(1, PrivateKeyA, PublicKeyA, n);
+}
+
+
+int EphemeralKeyGeneration_B_batch(const unsigned char* const* PrivateKeyB, unsigned char* const* PublicKeyB, const unsigned int n)
+{ // Bob's ephemeral public key generation for n private keys, same output as n calls of EphemeralKeyGeneration_B
+    return KeyGeneration_batch(0, PrivateKeyB, PublicKeyB, n);
+}
+
+
+int EphemeralSecretAgreement_A_batch(const unsigned char* const* PrivateKeyA, const unsigned char* const* PublicKeyB, unsigned char* const* SharedSecretA, const unsigned int n)
+{ // Alice's ephemeral shared secret computation for n key pairs, same output as n calls of EphemeralSecretAgreement_A
+    return SecretAgreement_batch(1, PrivateKeyA, PublicKeyB, SharedSecretA, n);
+}
+
+
+int EphemeralSecretAgreement_B_batch(const unsigned char* const* PrivateKeyB, const unsigned char* const* PublicKeyA, unsigned char* const* SharedSecretB, const unsigned int n)
+{ // Bob's ephemeral shared secret computation for n key pairs, same output as n calls of EphemeralSecretAgreement_B
+    return SecretAgreement_batch(0, PrivateKeyB, PublicKeyA, SharedSecretB, n);
+}
+
 void test_add(){
 	int i;
 	felm_t a,b,c;
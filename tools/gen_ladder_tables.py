@@ -0,0 +1,217 @@
+#!/usr/bin/env python3
+#********************************************************************************************
+# Supersingular Isogeny Key Encapsulation Library
+#
+# Abstract: generation of the fixed-base ladder tables P[prime]_tables.h and of table files
+#
+# The tables hold the affine x-coordinates of [2^i]QA and [2^i]QB on the starting curve
+# E_6: y^2 = x^3 + 6x^2 + x, in Montgomery representation; Bob's entries are in GF(p).
+# They are derived only from the A_gen/B_gen constants of P[prime].c, so the output is
+# reproducible bit for bit.
+#
+# Usage: python3 tools/gen_ladder_tables.py PRIME [--alice-bits N] [--bob-bits N] [-o FILE]
+#        PRIME is one of 434, 503, 610, 751. By default the tables cover the full scalar
+#        length and are written to sikep[prime]/m4/P[prime]_tables.h. Smaller tables trade
+#        flash for speed: the ladders continue with doublings past the last entry. With a
+#        size of 0, Alice falls back to the variable-base LADDER3PT.
+#
+#        With --file the tables are written instead to a table file (default P[prime].tbl), which a host library
+#        built with -D _TABLE_FILE_ maps with table_file_load (see P[prime]_internal.h) in place of its own tables.
+#********************************************************************************************
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+
+
+def read_params(prime):
+    # Reads the prime exponents and the generators from the sources of the parameter set
+    d = os.path.join(ROOT, 'sikep%d' % prime, 'm4')
+    hdr = open(os.path.join(d, 'P%d_internal.h' % prime)).read()
+    src = open(os.path.join(d, 'P%d.c' % prime)).read()
+
+    def define(name):
+        return int(re.search(r'#define\s+%s\s+(\d+)' % name, hdr).group(1))
+
+    def array(name):
+        body = re.search(r'%s\[[^\]]*\]\s*=\s*\{([^}]*)\}' % name, src).group(1)
+        body = re.sub(r'//[^\n]*', '', body)
+        return [int(w, 16) for w in re.findall(r'0x[0-9A-Fa-f]+', body)]
+
+    ealice, ebob = define('OALICE_BITS'), define('OBOB_EXPON')
+    p = 2**ealice * 3**ebob - 1
+    nw = (define('NBITS_FIELD') + 63) // 64
+    return {'p': p, 'nw': nw, 'nbits_alice': ealice, 'nbits_bob': define('OBOB_BITS') - 1,
+            'A_gen': array('A_gen'), 'B_gen': array('B_gen')}
+
+
+class Fp2:
+    # Arithmetic in GF(p^2) = GF(p)[i]/(i^2 + 1)
+    def __init__(self, p):
+        self.p = p
+
+    def add(self, a, b):
+        return ((a[0] + b[0]) % self.p, (a[1] + b[1]) % self.p)
+
+    def sub(self, a, b):
+        return ((a[0] - b[0]) % self.p, (a[1] - b[1]) % self.p)
+
+    def mul(self, a, b):
+        return ((a[0]*b[0] - a[1]*b[1]) % self.p, (a[0]*b[1] + a[1]*b[0]) % self.p)
+
+    def inv(self, a):
+        n = pow((a[0]*a[0] + a[1]*a[1]) % self.p, self.p - 2, self.p)
+        return (a[0]*n % self.p, -a[1]*n % self.p)
+
+
+def xdbl(F, X, Z, A24plus, C24):
+    # Same formulas as xDBL in ec_isogeny.c
+    t0 = F.sub(X, Z)
+    t1 = F.add(X, Z)
+    t0 = F.mul(t0, t0)
+    t1 = F.mul(t1, t1)
+    Z2 = F.mul(C24, t0)
+    X2 = F.mul(t1, Z2)
+    t1 = F.sub(t1, t0)
+    t0 = F.mul(A24plus, t1)
+    Z2 = F.mul(F.add(Z2, t0), t1)
+    return X2, Z2
+
+
+def table(prm, gen, nbits, ntable, R):
+    # Affine x([2^i]Q), i = 0..ntable-1, in Montgomery representation.
+    # Also returns the Z-coordinate of [2^nbits]Q, which is zero for Alice's generator
+    p, nw = prm['p'], prm['nw']
+    F = Fp2(p)
+    Rinv = pow(R, -1, p)
+    words = gen[2*nw:4*nw]
+    x = [sum(w << (64*k) for k, w in enumerate(words[j*nw:(j+1)*nw])) * Rinv % p for j in range(2)]
+    X, Z = (x[0], x[1]), (1, 0)
+    A24plus, C24 = (8, 0), (4, 0)               # A24plus = A+2C, C24 = 4C, where A=6, C=1
+
+    out = []
+    for i in range(nbits):
+        if Z == (0, 0):
+            sys.exit('error: [2^%d]Q is the point at infinity' % i)
+        if i < ntable:
+            out.append(F.mul(X, F.inv(Z)))
+        X, Z = xdbl(F, X, Z, A24plus, C24)
+    return [((a*R) % p, (b*R) % p) for a, b in out], Z
+
+
+def emit(prime, nw, name, party, tbl):
+    # Each GF(p^2) entry takes four lines, real part first, laid out as the generators in P[prime].c.
+    # Bob's generators are GF(p)-rational, so only the real parts of his table are stored
+    half = (nw + 1) // 2
+    fp_only = party == 'Bob'
+    if fp_only:
+        if any(b for _, b in tbl):
+            sys.exit('error: x(QB) is not in GF(p)')
+        tbl = [(a,) for a, _ in tbl]
+        o = ['// Affine x-coordinates of [2^i]QB, i = 0..FIXED_BASE_BITS_BOB-1, in GF(p%d), expressed in Montgomery representation' % prime,
+             'const uint64_t %s[FIXED_BASE_BITS_BOB*NWORDS64_FIELD] = {' % name]
+    else:
+        o = ['// Affine x-coordinates of [2^i]QA, i = 0..FIXED_BASE_BITS_ALICE-1, in GF(p%d^2), expressed in Montgomery representation' % prime,
+             'const uint64_t %s[2*FIXED_BASE_BITS_ALICE*NWORDS64_FIELD] = {' % name]
+    for i, elm in enumerate(tbl):
+        for j, v in enumerate(elm):
+            words = ['0x%016X' % ((v >> (64*k)) & (2**64 - 1)) for k in range(nw)]
+            sep = '' if (i == len(tbl) - 1 and j == len(elm) - 1) else ','
+            tag = '' if fp_only else ', x%d' % j
+            o.append('    ' + ', '.join(words[:half]) + ',')
+            o.append('    ' + ', '.join(words[half:]) + sep + ' '*(1 - len(sep)) + '    // [2^%d]Q%s%s' % (i, party[0], tag))
+    o.append('};')
+    return o
+
+
+def fnv1a(data, h=0xCBF29CE484222325):
+    # Same hash as table_file_hash in tablefile.c
+    for b in data:
+        h = ((h ^ b) * 0x100000001B3) & (2**64 - 1)
+    return h
+
+
+def words_le(values, nw):
+    # Little-endian 64-bit words of the field elements
+    return b''.join(v.to_bytes(8*nw, 'little') for v in values)
+
+
+def write_file(path, prime, prm, tables):
+    # Header of table_file_header_t, then Alice's table, real and imaginary parts of each entry, then Bob's real parts
+    nw = prm['nw']
+    ta, tb = tables.get('Alice', []), tables.get('Bob', [])
+    if any(b for _, b in tb):
+        sys.exit('error: x(QB) is not in GF(p)')
+    data = words_le([v for elm in ta for v in elm], nw) + words_le([a for a, _ in tb], nw)
+    params = fnv1a(words_le(prm['A_gen'], 1) + words_le(prm['B_gen'], 1))
+    hdr = struct.pack('<8sIIIIIIQQ', b'SIKETBL', 1, prime, nw, len(ta), len(tb), 0, params, fnv1a(data))
+    # Processes may have the previous file mapped: written next to it, then renamed over it, so that they keep the
+    # old inode instead of seeing it truncated or rewritten
+    tmp = '%s.%d.tmp' % (path, os.getpid())
+    try:
+        with open(tmp, 'wb') as f:
+            f.write(hdr + data)
+            f.flush()
+            os.fsync(f.fileno())
+        os.replace(tmp, path)
+    except BaseException:
+        if os.path.exists(tmp):
+            os.remove(tmp)
+        raise
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Generate the fixed-base ladder tables of a SIKE parameter set')
+    ap.add_argument('prime', type=int, choices=[434, 503, 610, 751])
+    ap.add_argument('--alice-bits', type=int, default=None, help='number of table entries for Alice (default: all)')
+    ap.add_argument('--bob-bits', type=int, default=None, help='number of table entries for Bob (default: all)')
+    ap.add_argument('--file', action='store_true', help='write a table file instead of P[prime]_tables.h')
+    ap.add_argument('-o', '--output', default=None)
+    args = ap.parse_args()
+
+    prime = args.prime
+    prm = read_params(prime)
+    R = 2**(64*prm['nw'])
+    na = prm['nbits_alice'] if args.alice_bits is None else args.alice_bits
+    nb = prm['nbits_bob'] if args.bob_bits is None else args.bob_bits
+    if not 0 <= na <= prm['nbits_alice'] or not 0 <= nb <= prm['nbits_bob']:
+        sys.exit('error: table sizes must be in [0, %d] for Alice and [0, %d] for Bob' % (prm['nbits_alice'], prm['nbits_bob']))
+
+    out = ['/********************************************************************************************',
+           '* Supersingular Isogeny Key Encapsulation Library',
+           '*',
+           '* Abstract: fixed-base ladder tables for P%d, generated by tools/gen_ladder_tables.py' % prime,
+           '*********************************************************************************************/',
+           '',
+           '// Number of precomputed multiples [2^i]Q for the key generation ladders (0 = no table)',
+           '#define FIXED_BASE_BITS_ALICE   %d' % na,
+           '#define FIXED_BASE_BITS_BOB     %d' % nb,
+           '']
+    tables = {}
+    for party, name, gen, nbits, n in (('Alice', 'A_gen_table', prm['A_gen'], prm['nbits_alice'], na),
+                                        ('Bob', 'B_gen_table', prm['B_gen'], prm['nbits_bob'], nb)):
+        if n == 0:
+            continue
+        tbl, Z = table(prm, gen, nbits, n, R)
+        if party == 'Alice' and Z != (0, 0):
+            sys.exit('error: QA does not have order 2^%d' % nbits)
+        tables[party] = tbl
+        out += emit(prime, prm['nw'], name, party, tbl)
+        out.append('')
+
+    if args.file:
+        path = args.output or 'P%d.tbl' % prime
+        write_file(path, prime, prm, tables)
+    else:
+        path = args.output or os.path.join(ROOT, 'sikep%d' % prime, 'm4', 'P%d_tables.h' % prime)
+        with open(path, 'w') as f:
+            f.write('\n'.join(out))
+    print('%s: %d + %d entries' % (os.path.normpath(path), na, nb))
+
+
+if __name__ == '__main__':
+    main()
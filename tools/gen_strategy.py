@@ -0,0 +1,343 @@
+#!/usr/bin/env python3
+#********************************************************************************************
+# Supersingular Isogeny Key Encapsulation Library
+#
+# Abstract: optimal isogeny strategies strat_Alice/strat_Bob from measured kernel costs
+#
+# The tree traversal of sidh.c walks m = strat[i] steps of xDBLe(., 2)/xTPLe(., 1) at a time
+# and pushes every point of the walk through each isogeny with eval_4_isog/eval_3_isog.
+# The optimal strategy for n isogenies and costs p (one step) and q (one evaluation) follows
+# from the dynamic program
+#     C(1) = 0,  C(i) = min_{0<b<i} C(i-b) + C(b) + b*p + (i-b)*q,
+# the table being the preorder list of the chosen b (De Feo, Jao, Plut, J. Math. Cryptol. 2014).
+# Key generation also pushes phiP/phiQ/phiR through all n isogenies. These 3n evaluations,
+# like the n get_4_isog/get_3_isog calls, are reported in the totals below but do not depend on
+# the strategy, so the same table is optimal for key generation and shared secret computation.
+#
+# Usage: python3 tools/gen_strategy.py PRIME [--report FILE | --log FILE | --host | --cost K=V ...]
+#                                            [--write] [-o FILE]
+#        --report  JSON report of bench/run_qemu.py (instruction counts under QEMU)
+#        --log     raw output of the benchmark firmware ("op <name> <iterations> <ticks>" lines),
+#                  e.g. captured from the UART of a board
+#        --host    builds and runs tools/strategy_costs.c against the x64 host backend
+#        --cost    explicit costs, e.g. --cost xDBLe=5800 --cost eval_4_isog=4100 (sync: barrier of --cores)
+#        --cores   strategies for the overlapped traversal of the host thread pool with these thread counts,
+#                  e.g. --cores 2,4,8, one table per operation since key generation also keeps the workers
+#                  busy with the basis images. --write generates P[prime]_strategies.h
+#        Costs missing from the source keep the values of the reference implementation.
+#        The tables are printed (or written to FILE), --write replaces them in P[prime].c.
+#********************************************************************************************
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+KERNELS = ('xDBLe', 'eval_4_isog', 'get_4_isog', 'xTPLe', 'eval_3_isog', 'get_3_isog')
+# GF(p^2) operation counts of the formulas (xDBLe for e = 2, xTPLe for e = 1) with S = 0.8M,
+# used for the kernels that are not measured
+DEFAULT_COSTS = {'xDBLe': 11.2, 'eval_4_isog': 7.6, 'get_4_isog': 4.0, 'xTPLe': 11.0, 'eval_3_isog': 5.6, 'get_3_isog': 4.6}
+# Barrier between two rows of the overlapped traversal, in the same unit
+DEFAULT_SYNC = 0.5
+# Bound on the stored points of the parallel strategies (MAX_INT_POINTS_PARALLEL)
+PARALLEL_MAX_POINTS = 24
+
+
+def sidh_dir(prime):
+    return os.path.join(ROOT, 'sikep%d' % prime, 'm4')
+
+
+def read_params(prime):
+    # Number of isogenies of each party and the current tables
+    d = sidh_dir(prime)
+    hdr = open(os.path.join(d, 'P%d_internal.h' % prime)).read()
+    src = open(os.path.join(d, 'P%d.c' % prime), newline='').read()
+
+    def define(name):
+        return int(re.search(r'#define\s+%s\s+(\d+)' % name, hdr).group(1))
+
+    def table(name):
+        body = re.search(r'%s\[[^\]]*\]\s*=\s*\{([^}]*)\}' % name, src).group(1)
+        return [int(w) for w in re.findall(r'\d+', body)]
+
+    return {'n_alice': define('MAX_Alice'), 'n_bob': define('MAX_Bob'),
+            'pts_alice': define('MAX_INT_POINTS_ALICE'), 'pts_bob': define('MAX_INT_POINTS_BOB'),
+            'strat_Alice': table('strat_Alice'), 'strat_Bob': table('strat_Bob')}
+
+
+def costs_from_log(text):
+    # Ticks per call of the "op" lines of the benchmark firmware or of strategy_costs.c
+    costs = {}
+    for line in text.splitlines():
+        f = line.split()
+        if len(f) == 4 and f[0] == 'op' and f[1] in KERNELS:
+            costs[f[1]] = int(f[3]) / int(f[2])
+    return costs
+
+
+def costs_from_report(path, prime):
+    results = json.load(open(path))['results']
+    for name, ops in results.items():
+        if name.endswith(str(prime)):
+            return {k: float(v) for k, v in ops.items() if k in KERNELS}
+    raise SystemExit('%s has no results for SIKEp%d' % (path, prime))
+
+
+def costs_from_host(prime):
+    # Builds tools/strategy_costs.c with the x64 backend and runs it
+    d = sidh_dir(prime)
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, 'strategy_costs')
+        cmd = ['gcc', '-O3', '-D', '_AMD64_', '-DSTRAT_PRIME=%d' % prime, '-I', d, '-I', os.path.join(ROOT, 'bench'),
+               '-o', exe, os.path.join(ROOT, 'tools', 'strategy_costs.c'),
+               os.path.join(d, 'AMD64', 'fp_x64.c'), os.path.join(d, 'AMD64', 'fp_x64_asm.S'),
+               os.path.join(ROOT, 'bench', 'fips202.c'), os.path.join(ROOT, 'bench', 'randombytes.c')]
+        subprocess.run(cmd, check=True)
+        return costs_from_log(subprocess.run([exe], check=True, stdout=subprocess.PIPE).stdout.decode())
+
+
+def optimal_strategies(n, p, q, k):
+    # Dynamic program of the header restricted to strategies storing at most d <= k points at a time
+    # (MAX_INT_POINTS_*): the point where a walk of b steps starts stays stored while the
+    # remaining i-b isogenies are computed. Ties are broken towards the smallest first walk.
+    # Returns the optimal strategy for each bound d (None if there is none)
+    inf = float('inf')
+    S = [[[] for d in range(k + 1)] for i in range(n + 1)]
+    C = [[0] * (k + 1)] + [[0] * (k + 1)] + [[inf] * (k + 1) for i in range(2, n + 1)]
+    for i in range(2, n + 1):
+        for d in range(1, k + 1):
+            cost, b = min((C[i - b][d - 1] + C[b][d] + b * p + (i - b) * q, b) for b in range(1, i))
+            if cost < inf:
+                S[i][d], C[i][d] = [b] + S[i - b][d - 1] + S[b][d], cost
+    return [S[n][d] if C[n][d] < inf else None for d in range(k + 1)]
+
+
+def optimal_strategy(n, p, q, k):
+    strat = optimal_strategies(n, p, q, k)[k]
+    if strat is None:
+        raise SystemExit('no strategy for %d isogenies with %d stored points' % (n, k))
+    return strat
+
+
+def traversal(strat, n):
+    # Number of steps, of point evaluations and of stored points of the tree traversal loop of sidh.c
+    index, pts, ii, steps, evals, depth = 0, [], 0, 0, 0, 0
+    for row in range(1, n):
+        while index < n - row:
+            pts.append(index)
+            depth = max(depth, len(pts))
+            m = strat[ii]
+            ii += 1
+            steps += m
+            index += m
+        evals += len(pts)
+        index = pts.pop()
+    if ii != len(strat):
+        raise ValueError('malformed strategy')
+    return steps, evals, depth
+
+
+def parallel_cost(strat, n, p, q, g, threads, nphi, sync):
+    # Latency of the overlapped traversal of sidh.c (traverse_parallel): while the workers push the
+    # stored points of row r and the nphi basis images through its isogeny, this thread evaluates the
+    # top point, walks down to the kernel point of row r+1 and computes its isogeny. Rows are
+    # separated by a barrier of cost sync
+    workers = threads - 1
+    index, pts, ii, t, busy, top = 0, [], 0, 0.0, 0.0, 0.0
+    for row in range(1, n):
+        walk = 0
+        while index < n - row:
+            pts.append(index)
+            walk += strat[ii]
+            index += strat[ii]
+            ii += 1
+        t += max(top + walk * p + g, busy) + sync
+        busy = -(-(len(pts) - 1 + nphi) // workers) * q
+        top = q
+        index = pts.pop()
+    t += max(top + g, busy) + sync
+    if nphi:
+        t += -(-nphi // workers) * q + sync
+    return t
+
+
+def parallel_strategies(n, p, q, g, threads, sync, k):
+    # The candidates are the sequential optima for a range of step/evaluation cost ratios and point bounds:
+    # spreading the evaluations over the workers makes them relatively cheaper than the steps. Returns the
+    # best candidate under parallel_cost for key generation (3 basis images) and agreement
+    best = {3: (float('inf'), None), 0: (float('inf'), None)}
+    for i in range(-8, 25):
+        for strat in optimal_strategies(n, p * 2 ** (i / 8), q, k)[2:]:
+            if strat is None:
+                continue
+            for nphi in best:
+                cost = parallel_cost(strat, n, p, q, g, threads, nphi, sync)
+                if cost < best[nphi][0]:
+                    best[nphi] = (cost, strat)
+    return best[3][1], best[0][1]
+
+
+def write_parallel_header(prime, tables, cores, maxpts):
+    # P[prime]_strategies.h: tables and descriptors of the overlapped traversal, one set per thread count
+    out = ['/' + '*' * 92,
+           '* Supersingular Isogeny Key Encapsulation Library',
+           '*',
+           '* Abstract: isogeny strategies of the overlapped host traversal for P%d, generated by tools/gen_strategy.py' % prime,
+           '*' * 93 + '/',
+           '',
+           '// Largest number of points stored by the tables below',
+           '#define MAX_INT_POINTS_PARALLEL %d' % maxpts,
+           '',
+           '// Thread counts with precomputed strategies, in increasing order',
+           '#define STRATEGY_PARALLEL_COUNT %d' % len(cores),
+           '']
+    for name, size, strat in tables:
+        out += [format_table(name, size, strat), '']
+    out += ['static const unsigned int strategy_parallel_threads[STRATEGY_PARALLEL_COUNT] = { %s };' % ', '.join(map(str, cores)),
+            '',
+            'static const strategy_t strategy_parallel[STRATEGY_PARALLEL_COUNT][STRATEGY_OPS] = {']
+    rows = []
+    for k in cores:
+        rows.append('    { { strat_Alice_keygen_par%d, MAX_Alice }, { strat_Bob_keygen_par%d, MAX_Bob },\n'
+                    '      { strat_Alice_agreement_par%d, MAX_Alice }, { strat_Bob_agreement_par%d, MAX_Bob } }' % (k, k, k, k))
+    out += [',\n'.join(rows) + ' };', '']
+    path = os.path.join(sidh_dir(prime), 'P%d_strategies.h' % prime)
+    open(path, 'w').write('\n'.join(out))
+    print('parallel strategies written to %s' % path, file=sys.stderr)
+
+
+def format_table(name, size, strat):
+    # Layout of the tables in P[prime].c
+    lines, cur = [], ''
+    for v in strat:
+        item = '%d, ' % v
+        if len(cur) + len(item) > 80:
+            lines.append(cur)
+            cur = ''
+        cur += item
+    lines.append(cur[:-2] + ' };')
+    return 'const unsigned int %s[%s] = { \n' % (name, size) + '\n'.join(lines)
+
+
+def main_parallel(args, prm, costs):
+    cores = sorted(set(int(c) for c in args.cores.split(',')))
+    if cores[0] < 2:
+        raise SystemExit('--cores takes thread counts of at least 2')
+    maxpts = args.max_points or PARALLEL_MAX_POINTS
+    tables, depth = [], 0
+    for k in cores:
+        for party, step, ev, get, n, table in (('Alice', 'xDBLe', 'eval_4_isog', 'get_4_isog', prm['n_alice'], 'strat_Alice'),
+                                               ('Bob', 'xTPLe', 'eval_3_isog', 'get_3_isog', prm['n_bob'], 'strat_Bob')):
+            p, q, g = costs[step], costs[ev], costs[get]
+            keygen, agree = parallel_strategies(n, p, q, g, k, costs['sync'], maxpts)
+            print('%s: %d isogenies, %d threads, %s = %.1f, %s = %.1f, sync = %.1f, at most %d stored points'
+                  % (party, n, k, step, p, ev, q, costs['sync'], maxpts), file=sys.stderr)
+            for op, strat, nphi in (('keygen', keygen, 3), ('agreement', agree, 0)):
+                cur = parallel_cost(prm[table], n, p, q, g, k, nphi, costs['sync'])
+                new = parallel_cost(strat, n, p, q, g, k, nphi, costs['sync'])
+                steps, evals, pts = traversal(strat, n)
+                depth = max(depth, pts)
+                print('  %-9s %5d steps %5d evaluations %3d points  %s %12.0f  (%s %.0f, %.1f%% less)'
+                      % (op, steps, evals, pts, 'latency', new, table, cur, 100 * (cur - new) / cur), file=sys.stderr)
+                tables.append(('%s_%s_par%d' % (table, op, k), 'MAX_%s-1' % party, strat))
+
+    if args.write:
+        write_parallel_header(args.prime, tables, cores, depth)
+        return
+    text = '\n\n'.join(format_table(*t) for t in tables) + '\n'
+    if args.output:
+        open(args.output, 'w').write(text)
+    else:
+        sys.stdout.write(text)
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Optimal isogeny strategies from measured kernel costs')
+    ap.add_argument('prime', type=int, choices=(434, 503, 610, 751))
+    src = ap.add_mutually_exclusive_group()
+    src.add_argument('--report', help='JSON report of bench/run_qemu.py')
+    src.add_argument('--log', help='output of the benchmark firmware')
+    src.add_argument('--host', action='store_true', help='measure the x64 host backend')
+    ap.add_argument('--cost', action='append', default=[], metavar='KERNEL=VALUE')
+    ap.add_argument('--cores', help='comma-separated thread counts of the overlapped host traversal')
+    ap.add_argument('--max-points', type=int, help='bound on the stored points, MAX_INT_POINTS_* by default')
+    ap.add_argument('--write', action='store_true', help='replace the tables in P[prime].c (and MAX_INT_POINTS_* if needed)')
+    ap.add_argument('-o', '--output', help='write the tables to this file')
+    args = ap.parse_args()
+
+    prm = read_params(args.prime)
+    costs, measured = dict(DEFAULT_COSTS), {}
+    if args.report:
+        measured = costs_from_report(args.report, args.prime)
+    elif args.log:
+        measured = costs_from_log(open(args.log).read())
+    elif args.host:
+        measured = costs_from_host(args.prime)
+    for kv in args.cost:
+        k, v = kv.split('=')
+        if k not in KERNELS + ('sync',):
+            raise SystemExit('unknown kernel %s, expected one of %s' % (k, ', '.join(KERNELS)))
+        measured[k] = float(v)
+    if measured and not all(k in measured for k in ('xDBLe', 'eval_4_isog', 'xTPLe', 'eval_3_isog')):
+        print('warning: incomplete measurements, reference costs are used for the others', file=sys.stderr)
+    costs['sync'] = DEFAULT_SYNC
+    ref = [k for k in measured if k in DEFAULT_COSTS]
+    if ref:
+        # Reference costs of missing kernels are scaled to the unit of the measured ones
+        scale = sum(measured[k] for k in ref) / sum(DEFAULT_COSTS[k] for k in ref)
+        costs = {k: measured.get(k, DEFAULT_COSTS[k] * scale) for k in KERNELS}
+        costs['sync'] = measured.get('sync', DEFAULT_SYNC * scale)
+    if args.cores:
+        return main_parallel(args, prm, costs)
+
+    out, points = [], {}
+    for party, step, ev, get, n, table in (('Alice', 'xDBLe', 'eval_4_isog', 'get_4_isog', prm['n_alice'], 'strat_Alice'),
+                                           ('Bob', 'xTPLe', 'eval_3_isog', 'get_3_isog', prm['n_bob'], 'strat_Bob')):
+        p, q, g = costs[step], costs[ev], costs[get]
+        k = args.max_points or prm['pts_' + party.lower()]
+        new = optimal_strategy(n, p, q, k)
+        print('%s: %d isogenies, %s = %.1f, %s = %.1f (ratio %.3f), at most %d stored points'
+              % (party, n, step, p, ev, q, p / q, k), file=sys.stderr)
+        for label, strat in (('current', prm[table]), ('optimal', new)):
+            steps, evals, depth = traversal(strat, n)
+            agree = steps * p + evals * q + n * g
+            keygen = agree + 3 * n * q
+            print('  %-8s %5d steps %5d evaluations %3d points  agreement %12.0f  key generation %12.0f'
+                  % (label, steps, evals, depth, agree, keygen), file=sys.stderr)
+        points['MAX_INT_POINTS_' + party.upper()] = depth
+        out.append(format_table(table, 'MAX_%s-1' % party, new))
+
+    text = '\n\n'.join(out) + '\n'
+    if args.write:
+        path = os.path.join(sidh_dir(args.prime), 'P%d.c' % args.prime)
+        src_text = open(path, newline='').read()
+        eol = '\r\n' if '\r\n' in src_text else '\n'
+        for block in out:
+            name = re.match(r'const unsigned int (\w+)', block).group(1)
+            src_text, k = re.subn(r'const unsigned int %s\[[^\]]*\]\s*=\s*\{[^}]*\};' % name,
+                                  lambda m: block.replace('\n', eol), src_text)
+            if k != 1:
+                raise SystemExit('%s not found in %s' % (name, path))
+        open(path, 'w', newline='').write(src_text)
+        print('tables written to %s' % path, file=sys.stderr)
+        # Stack arrays of sidh.c have to hold the stored points of the new tables
+        path = os.path.join(sidh_dir(args.prime), 'P%d_internal.h' % args.prime)
+        hdr = open(path, newline='').read()
+        for name, depth in points.items():
+            cur = int(re.search(r'#define %s\s+(\d+)' % name, hdr).group(1))
+            if depth > cur:
+                hdr = re.sub(r'(#define %s\s+)\d+' % name, lambda m: m.group(1) + str(depth), hdr)
+                print('%s raised to %d in %s' % (name, depth, path), file=sys.stderr)
+        open(path, 'w', newline='').write(hdr)
+    elif args.output:
+        open(args.output, 'w').write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == '__main__':
+    main()
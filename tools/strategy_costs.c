@@ -0,0 +1,88 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: host measurement of the kernels that determine the isogeny strategies, built and run
+*           by gen_strategy.py --host with -DSTRAT_PRIME=434|503|610|751. Prints
+*             op <name> <iterations> <nanoseconds>
+*           lines as the benchmark firmware does, the best of STRAT_RUNS runs. The kernels are interleaved
+*           within each run so that load changes of the host affect them alike.
+*********************************************************************************************/
+
+#include <stdio.h>
+#include <time.h>
+
+#if (STRAT_PRIME == 434)
+    #include "P434.c"
+#elif (STRAT_PRIME == 503)
+    #include "P503.c"
+#elif (STRAT_PRIME == 610)
+    #include "P610.c"
+#elif (STRAT_PRIME == 751)
+    #include "P751.c"
+#else
+    #error -- "Unsupported STRAT_PRIME"
+#endif
+
+#define STRAT_ITERS     2000
+#define STRAT_RUNS      25
+#define STRAT_KERNELS   6
+
+static const char* names[STRAT_KERNELS] = { "xDBLe", "get_4_isog", "eval_4_isog", "xTPLe", "get_3_isog", "eval_3_isog" };
+static uint64_t best[STRAT_KERNELS];
+
+// Time of stmt iterated STRAT_ITERS times, kept in best[k] if it is the best so far
+#define MEASURE(k, stmt)                                                                          \
+    { uint64_t t; unsigned int it;                                                                \
+    t = now_ns();                                                                                 \
+    for (it = 0; it < STRAT_ITERS; it++) { stmt; }                                                \
+    t = now_ns() - t;                                                                             \
+    if (run == 0 || t < best[k]) best[k] = t; }
+
+
+static uint64_t now_ns(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec*1000000000 + (uint64_t)t.tv_nsec;
+}
+
+
+static void random_fp2(f2elm_t a)
+{ // Random GF(p^2) element with both halves below 2^(NBITS_FIELD-1) < p
+    unsigned int i;
+
+    randombytes((unsigned char*)a, 2*NWORDS_FIELD*sizeof(digit_t));
+    for (i = 0; i < 2; i++) {
+        a[i][NWORDS_FIELD-1] &= ((digit_t)-1) >> (NWORDS_FIELD*RADIX - NBITS_FIELD + 1);
+    }
+}
+
+
+int main(void)
+{
+    point_proj_t R, P;
+    f2elm_t coeff[3], A24plus = {0}, C24 = {0}, A24, C;
+    unsigned int run, k;
+
+    // Curve E_6: A24plus = A+2C = 8, C24 = 4C = 4, which is also A24minus = A-2C
+    fpcopy((digit_t*)&Montgomery_one, A24plus[0]);
+    fp2add(A24plus, A24plus, A24plus);
+    fp2add(A24plus, A24plus, C24);
+    fp2add(C24, C24, A24plus);
+    random_fp2(R->X); random_fp2(R->Z);
+    random_fp2(P->X); random_fp2(P->Z);
+
+    for (run = 0; run < STRAT_RUNS; run++) {
+        MEASURE(0, xDBLe(R, R, A24plus, C24, 2));
+        MEASURE(1, get_4_isog(R, A24, C, coeff));
+        MEASURE(2, eval_4_isog(P, coeff));
+        MEASURE(3, xTPLe(R, R, C24, A24plus, 1));
+        MEASURE(4, get_3_isog(R, A24, C, coeff));
+        MEASURE(5, eval_3_isog(P, coeff));
+    }
+    for (k = 0; k < STRAT_KERNELS; k++) {
+        printf("op %s %u %llu\n", names[k], STRAT_ITERS, (unsigned long long)best[k]);
+    }
+    return 0;
+}